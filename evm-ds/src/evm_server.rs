@@ -56,48 +56,65 @@ impl EvmServer {
             });
 
         match args_parsed {
-            Ok(mut args) => {
-                let origin = H160::from(args.get_origin());
-                let address = H160::from(args.get_address());
-                let code = Vec::from(args.get_code());
-                let data = Vec::from(args.get_data());
-                let apparent_value = U256::from(args.get_apparent_value());
-                let gas_limit = args.get_gas_limit();
-                let estimate = args.get_estimate();
-                let caller = H160::from(args.get_caller());
-                let backend =
-                    ScillaBackend::new(self.backend_config.clone(), origin, args.take_extras());
-                let gas_scaling_factor = self.gas_scaling_factor;
-                let is_static = args.get_is_static_call();
+            Ok(args) => self
+                .run_args(args)
+                .map(|result| result.map(|result| base64::encode(result.write_to_bytes().unwrap())))
+                .boxed(),
+            Err(e) => futures::future::err(e).boxed(),
+        }
+    }
 
-                let node_continuation = if args.get_continuation().get_id() == 0 {
-                    None
-                } else {
-                    Some(args.take_continuation())
-                };
+    /// Runs a serialized EvmArgs as sent over the framed socket, returning the serialized
+    /// EvmResult without the base64 and JSON wrapping of `run`.
+    #[allow(dead_code)]
+    pub fn run_framed(&self, buffer: &[u8]) -> BoxFuture<Result<Vec<u8>>> {
+        match EvmProto::EvmArgs::parse_from_bytes(buffer) {
+            Ok(args) => self
+                .run_args(args)
+                .map(|result| result.map(|result| result.write_to_bytes().unwrap()))
+                .boxed(),
+            Err(e) => futures::future::err(Error::invalid_params(format!("{e}"))).boxed(),
+        }
+    }
 
-                run_evm_impl(
-                    address,
-                    code,
-                    data,
-                    apparent_value,
-                    gas_limit,
-                    caller,
-                    backend,
-                    gas_scaling_factor,
-                    estimate,
-                    is_static,
-                    args.get_context().to_string(),
-                    node_continuation,
-                    self.continuations.clone(),
-                    args.get_enable_cps(),
-                    args.get_tx_trace_enabled(),
-                    args.get_tx_trace().to_string(),
-                )
-                .boxed()
-            }
+    #[allow(dead_code)]
+    fn run_args(&self, mut args: EvmProto::EvmArgs) -> BoxFuture<Result<EvmProto::EvmResult>> {
+        let origin = H160::from(args.get_origin());
+        let address = H160::from(args.get_address());
+        let code = Vec::from(args.get_code());
+        let data = Vec::from(args.get_data());
+        let apparent_value = U256::from(args.get_apparent_value());
+        let gas_limit = args.get_gas_limit();
+        let estimate = args.get_estimate();
+        let caller = H160::from(args.get_caller());
+        let backend = ScillaBackend::new(self.backend_config.clone(), origin, args.take_extras());
+        let gas_scaling_factor = self.gas_scaling_factor;
+        let is_static = args.get_is_static_call();
 
-            Err(e) => futures::future::err(e).boxed(),
-        }
+        let node_continuation = if args.get_continuation().get_id() == 0 {
+            None
+        } else {
+            Some(args.take_continuation())
+        };
+
+        run_evm_impl(
+            address,
+            code,
+            data,
+            apparent_value,
+            gas_limit,
+            caller,
+            backend,
+            gas_scaling_factor,
+            estimate,
+            is_static,
+            args.get_context().to_string(),
+            node_continuation,
+            self.continuations.clone(),
+            args.get_enable_cps(),
+            args.get_tx_trace_enabled(),
+            args.get_tx_trace().to_string(),
+        )
+        .boxed()
     }
 }
@@ -25,7 +25,6 @@ use crate::protos::Evm as EvmProto;
 use crate::protos::Evm::EvmResult;
 use crate::scillabackend;
 use crate::tracing_logging::{CallContext, LoggingEventListener};
-use protobuf::Message;
 
 #[allow(clippy::too_many_arguments)]
 pub async fn run_evm_impl(
@@ -45,7 +44,7 @@ pub async fn run_evm_impl(
     enable_cps: bool,
     tx_trace_enabled: bool,
     tx_trace: String,
-) -> Result<String> {
+) -> Result<EvmResult> {
     // We must spawn a separate blocking task (on a blocking thread), because by default a JSONRPC
     // method runs as a non-blocking thread under a tokio runtime, and creating a new runtime
     // cannot be done. And we'll need a new runtime that we can safely drop on a handled
@@ -71,7 +70,7 @@ pub async fn run_evm_impl(
             tx_trace,
         );
 
-        Ok(base64::encode(result.write_to_bytes().unwrap()))
+        Ok(result)
     })
     .await
     .unwrap()
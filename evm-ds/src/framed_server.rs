@@ -0,0 +1,126 @@
+//! Framed protobuf transport for the node's EVM calls.
+//!
+//! Requests are a 4-byte big-endian length followed by a serialized EvmArgs, and each one is
+//! answered the same way with a serialized EvmResult. Unlike the JSON-RPC socket, there is no
+//! base64 or JSON wrapping, and a connection is kept open for any number of requests.
+
+use std::io::{Error, ErrorKind};
+use std::sync::Arc;
+
+use log::{debug, info};
+use tokio::io::{AsyncReadExt, AsyncWriteExt};
+use tokio::net::{UnixListener, UnixStream};
+
+use crate::evm_server::EvmServer;
+
+/// Frames announcing more than this are taken as a broken stream rather than allocated, the
+/// same bound as the node applies.
+const MAX_FRAME_SIZE: u32 = 256 * 1024 * 1024;
+
+/// Accepts connections on the socket at `path` and serves each on its own task.
+#[allow(dead_code)]
+pub(crate) async fn serve(path: String, server: Arc<EvmServer>) -> std::io::Result<()> {
+    // A socket file left by a previous run would fail the bind.
+    let _ = std::fs::remove_file(&path);
+    let listener = UnixListener::bind(&path)?;
+    info!("Serving framed EVM calls on {path}");
+    loop {
+        let (stream, _) = listener.accept().await?;
+        let server = server.clone();
+        tokio::spawn(async move {
+            if let Err(e) = serve_connection(stream, server).await {
+                debug!("Closing framed connection: {e}");
+            }
+        });
+    }
+}
+
+/// Answers requests until the node closes the connection. A request that can't be run closes
+/// it too, which the node sees as a failed call.
+async fn serve_connection(mut stream: UnixStream, server: Arc<EvmServer>) -> std::io::Result<()> {
+    loop {
+        let size = match stream.read_u32().await {
+            Ok(size) => size,
+            Err(e) if e.kind() == ErrorKind::UnexpectedEof => return Ok(()),
+            Err(e) => return Err(e),
+        };
+        if size > MAX_FRAME_SIZE {
+            return Err(Error::new(
+                ErrorKind::InvalidData,
+                format!("frame of {size} bytes"),
+            ));
+        }
+        let mut request = vec![0; size as usize];
+        stream.read_exact(&mut request).await?;
+
+        let response = server
+            .run_framed(&request)
+            .await
+            .map_err(|e| Error::new(ErrorKind::InvalidData, e.message))?;
+        stream.write_u32(response.len() as u32).await?;
+        stream.write_all(&response).await?;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::path::PathBuf;
+
+    use protobuf::Message;
+
+    use crate::protos::Evm as EvmProto;
+    use crate::scillabackend::ScillaBackendConfig;
+
+    async fn call(stream: &mut UnixStream, request: &[u8]) -> std::io::Result<Vec<u8>> {
+        stream.write_u32(request.len() as u32).await?;
+        stream.write_all(request).await?;
+        let mut response = vec![0; stream.read_u32().await? as usize];
+        stream.read_exact(&mut response).await?;
+        Ok(response)
+    }
+
+    #[tokio::test]
+    async fn test_framed_round_trip() {
+        let path = std::env::temp_dir()
+            .join(format!("evm-ds-framed-{}.sock", std::process::id()))
+            .to_string_lossy()
+            .to_string();
+        let server = Arc::new(EvmServer::new(
+            ScillaBackendConfig {
+                path: PathBuf::from("/nonexistent/zilliqa.sock"),
+                zil_scaling_factor: 1,
+            },
+            1,
+        ));
+        let _ = std::fs::remove_file(&path);
+        tokio::spawn(serve(path.clone(), server));
+        let mut stream = loop {
+            match UnixStream::connect(&path).await {
+                Ok(stream) => break stream,
+                Err(_) => tokio::time::sleep(tokio::time::Duration::from_millis(10)).await,
+            }
+        };
+
+        // An unknown continuation is answered without querying the node.
+        let mut args = EvmProto::EvmArgs::new();
+        args.set_gas_limit(21000);
+        args.mut_continuation().set_id(1);
+        let request = args.write_to_bytes().unwrap();
+        for _ in 0..2 {
+            let response = call(&mut stream, &request).await.unwrap();
+            let result = EvmProto::EvmResult::parse_from_bytes(&response).unwrap();
+            assert_eq!(
+                result.get_exit_reason().get_fatal().get_error_string(),
+                "Continuation not found!"
+            );
+            assert_eq!(result.get_remaining_gas(), 21000);
+        }
+
+        // Args that don't parse close the connection.
+        assert!(call(&mut stream, &[0xff; 8]).await.is_err());
+
+        let _ = std::fs::remove_file(&path);
+    }
+}
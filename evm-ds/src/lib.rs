@@ -3,6 +3,7 @@ mod convert;
 pub mod cps_executor;
 mod evm_server;
 pub mod evm_server_run;
+mod framed_server;
 mod ipc_connect;
 mod precompiles;
 mod pretty_printer;
@@ -8,6 +8,7 @@ mod convert;
 mod cps_executor;
 mod evm_server;
 mod evm_server_run;
+mod framed_server;
 mod ipc_connect;
 mod precompiles;
 mod pretty_printer;
@@ -26,7 +27,7 @@ use clap::Parser;
 
 use evm_server::EvmServer;
 
-use log::info;
+use log::{error, info};
 use std::fmt::Debug;
 
 use jsonrpc_core::IoHandler;
@@ -41,6 +42,10 @@ struct Args {
     #[clap(short, long, default_value = "/tmp/evm-server.sock")]
     socket: String,
 
+    /// Path of a Unix domain socket taking length-prefixed protobuf calls, served besides `socket`.
+    #[clap(long)]
+    framed_socket: Option<String>,
+
     /// Path of the Node Unix domain socket.
     #[clap(short, long, default_value = "/tmp/zilliqa.sock")]
     node_socket: String,
@@ -365,7 +370,18 @@ fn main() -> std::result::Result<(), Box<dyn std::error::Error>> {
         zil_scaling_factor: args.zil_scaling_factor,
     };
 
-    let evm_server = EvmServer::new(backend_config, args.gas_scaling_factor);
+    let evm_server = Arc::new(EvmServer::new(backend_config, args.gas_scaling_factor));
+
+    // The framed socket gets its own runtime, like the servers below.
+    if let Some(framed_socket) = args.framed_socket {
+        let runtime = tokio::runtime::Runtime::new()?;
+        let server = evm_server.clone();
+        std::thread::spawn(move || {
+            if let Err(e) = runtime.block_on(framed_server::serve(framed_socket, server)) {
+                error!("Framed socket server failed: {e}");
+            }
+        });
+    }
 
     // Setup a channel to signal a shutdown.
     let (shutdown_sender, shutdown_receiver) = std::sync::mpsc::channel();
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+
+#include <common/Constants.h>
+#include <depends/libDatabase/LevelDB.h>
+#include <libMessage/Messenger.h>
+#include <libPersistence/SegmentStore.h>
+
+namespace {
+
+// Copies every body whose key is listed in keyDB into the segment store.
+// getLocation turns a keyDB entry into the epoch of the body and its key in
+// the epoch sharded body DBs named bodyDBName, bodyDBName_1, ...
+template <typename GetLocation>
+uint64_t migrate(const std::string& persistencePath,
+                 const std::string& keyDBName, const std::string& bodyDBName,
+                 const std::string& segmentsName, GetLocation getLocation) {
+  const std::string EMPTY_SUBDIR{};
+
+  if (!std::filesystem::exists(persistencePath + "/" + keyDBName)) {
+    std::cerr << "No " << keyDBName << " found, skipping " << bodyDBName
+              << std::endl;
+    return 0;
+  }
+
+  LevelDB keyDB{keyDBName, persistencePath, EMPTY_SUBDIR};
+  SegmentStore segments{segmentsName, persistencePath};
+  std::map<uint64_t, std::unique_ptr<LevelDB>> bodyDBs;
+
+  uint64_t migrated = 0;
+  uint64_t missing = 0;
+
+  const auto it = std::unique_ptr<leveldb::Iterator>(
+      keyDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+  for (it->SeekToFirst(); it->Valid(); it->Next()) {
+    uint64_t epochNum = 0;
+    zbytes bodyKey;
+    if (!getLocation(it->key().ToString(), it->value().ToString(), epochNum,
+                     bodyKey)) {
+      std::cerr << "Skipping malformed " << keyDBName << " entry" << std::endl;
+      continue;
+    }
+
+    const uint64_t segment = epochNum / NUM_EPOCHS_PER_PERSISTENT_DB;
+    auto& bodyDB = bodyDBs[segment];
+    if (!bodyDB) {
+      const std::string name = segment == 0
+                                   ? bodyDBName
+                                   : bodyDBName + "_" + std::to_string(segment);
+      bodyDB = std::make_unique<LevelDB>(name, persistencePath, EMPTY_SUBDIR);
+    }
+
+    const auto body = bodyDB->Lookup(bodyKey);
+    if (body.empty()) {
+      missing++;
+      continue;
+    }
+    if (!segments.Put(segment, bodyKey,
+                      dev::zbytesConstRef(
+                          reinterpret_cast<const zbyte*>(body.data()),
+                          body.size()))) {
+      std::cerr << "Failed to append to " << segmentsName << std::endl;
+      exit(1);
+    }
+
+    if (++migrated % 100000 == 0) {
+      std::cerr << "Migrated " << migrated << " " << bodyDBName << std::endl;
+    }
+  }
+
+  if (!segments.Flush()) {
+    std::cerr << "Failed to sync " << segmentsName << std::endl;
+    exit(1);
+  }
+
+  std::cerr << "Migrated " << migrated << " " << bodyDBName << ", " << missing
+            << " listed without a body" << std::endl;
+  return migrated;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " PERSISTENCE_PATH" << std::endl;
+    exit(1);
+  }
+  const std::string persistencePath = argv[1];
+
+  // The LevelDBs are left in place, BlockStorage reads anything the segment
+  // store lacks from them, so they can be deleted once the node checks out
+
+  // txEpochs maps each txn hash to its epoch, tx bodies are keyed by the hash
+  migrate(persistencePath, "txEpochs", "txBodies", "txBodySegments",
+          [](const std::string& key, const std::string& value,
+             uint64_t& epochNum, zbytes& bodyKey) {
+            bodyKey.assign(key.begin(), key.end());
+            return Messenger::GetTxEpoch(zbytes(value.begin(), value.end()), 0,
+                                         epochNum);
+          });
+
+  // microBlockKeys maps each microblock hash to the key of its body
+  migrate(persistencePath, "microBlockKeys", "microBlocks",
+          "microBlockSegments",
+          [](const std::string&, const std::string& value, uint64_t& epochNum,
+             zbytes& bodyKey) {
+            uint32_t shardID = 0;
+            bodyKey.assign(value.begin(), value.end());
+            return Messenger::GetMicroBlockKey(bodyKey, 0, epochNum, shardID);
+          });
+
+  return 0;
+}
@@ -111,6 +111,25 @@ ReadVerifierMicroblockExclusionListFromConstantsFile() {
   return result;
 }
 
+const vector<LevelDBProfile> ReadLevelDBProfilesFromConstantsFile() {
+  auto pt = PTree::GetInstance();
+  vector<LevelDBProfile> result;
+  auto profiles = pt.get_child_optional("node.leveldb.profiles");
+  if (!profiles) {
+    return result;
+  }
+  for (auto& entry : *profiles) {
+    result.push_back(
+        {entry.second.get<string>("DB"),
+         entry.second.get<unsigned int>("BLOCK_CACHE_MB", 0),
+         entry.second.get<unsigned int>("BLOOM_FILTER_BITS", 0),
+         entry.second.get<unsigned int>("WRITE_BUFFER_KB", 4096),
+         entry.second.get<unsigned int>("BLOCK_SIZE_KB", 4),
+         entry.second.get<string>("COMPRESSION", "true") == "true"});
+  }
+  return result;
+}
+
 bool ISOLATED_SERVER = false;
 
 bool SCILLA_PPLIT_FLAG = true;
@@ -134,6 +153,24 @@ const bool ENABLE_MEMORY_STATS{ReadConstantString("ENABLE_MEMORY_STATS") ==
                                "true"};
 const unsigned int NUM_DS_EPOCHS_STATE_HISTORY{
     ReadConstantNumeric("NUM_DS_EPOCHS_STATE_HISTORY")};
+const unsigned int STATE_PURGE_BATCH_SIZE{
+    ReadConstantNumeric("STATE_PURGE_BATCH_SIZE")};
+const unsigned int STATE_PURGE_MAX_OPS_PER_SEC{
+    ReadConstantNumeric("STATE_PURGE_MAX_OPS_PER_SEC")};
+const unsigned int STATE_PURGE_MAX_BYTES_PER_SEC{
+    ReadConstantNumeric("STATE_PURGE_MAX_BYTES_PER_SEC")};
+const bool BLOCKSTORAGE_WRITE_BEHIND{
+    ReadConstantString("BLOCKSTORAGE_WRITE_BEHIND") == "true"};
+const unsigned int BLOCKSTORAGE_WRITE_BEHIND_MAX_PENDING{
+    ReadConstantNumeric("BLOCKSTORAGE_WRITE_BEHIND_MAX_PENDING")};
+const bool BLOCKSTORAGE_SEGMENT_STORE{
+    ReadConstantString("BLOCKSTORAGE_SEGMENT_STORE") == "true"};
+const unsigned int BLOCKSTORAGE_SEGMENT_CHUNK_MB{
+    ReadConstantNumeric("BLOCKSTORAGE_SEGMENT_CHUNK_MB", "node.general.", 256)};
+const unsigned int BLOCKSTORAGE_TXBODY_CACHE_SIZE{
+    ReadConstantNumeric("BLOCKSTORAGE_TXBODY_CACHE_SIZE")};
+const unsigned int BLOCKSTORAGE_MICROBLOCK_CACHE_SIZE{
+    ReadConstantNumeric("BLOCKSTORAGE_MICROBLOCK_CACHE_SIZE")};
 
 const uint64_t INIT_TRIE_DB_SNAPSHOT_EPOCH{
     ReadConstantUInt64("INIT_TRIE_DB_SNAPSHOT_EPOCH")};
@@ -477,6 +514,18 @@ const unsigned int MAXRETRYCONN{
     ReadConstantNumeric("MAXRETRYCONN", "node.p2pcomm.")};
 const unsigned int MSGQUEUE_SIZE{
     ReadConstantNumeric("MSGQUEUE_SIZE", "node.p2pcomm.")};
+const unsigned int CONSENSUS_MSG_THREADS{
+    ReadConstantNumeric("CONSENSUS_MSG_THREADS", "node.p2pcomm.")};
+const unsigned int BLOCK_MSG_THREADS{
+    ReadConstantNumeric("BLOCK_MSG_THREADS", "node.p2pcomm.")};
+const unsigned int TXN_MSGQUEUE_SIZE{
+    ReadConstantNumeric("TXN_MSGQUEUE_SIZE", "node.p2pcomm.")};
+const unsigned int TXN_MSG_THREADS{
+    ReadConstantNumeric("TXN_MSG_THREADS", "node.p2pcomm.")};
+const unsigned int SYNC_MSGQUEUE_SIZE{
+    ReadConstantNumeric("SYNC_MSGQUEUE_SIZE", "node.p2pcomm.")};
+const unsigned int SYNC_MSG_THREADS{
+    ReadConstantNumeric("SYNC_MSG_THREADS", "node.p2pcomm.")};
 const unsigned int PUMPMESSAGE_MILLISECONDS{
     ReadConstantNumeric("PUMPMESSAGE_MILLISECONDS", "node.p2pcomm.")};
 const unsigned int SENDQUEUE_SIZE{
@@ -497,6 +546,10 @@ const unsigned int MAX_WHITELISTREQ_LIMIT{
     ReadConstantNumeric("MAX_WHITELISTREQ_LIMIT", "node.p2pcomm.")};
 const unsigned int SENDJOBPEERS_TIMEOUT{
     ReadConstantNumeric("SENDJOBPEERS_TIMEOUT", "node.p2pcomm.")};
+const bool P2P_COMPRESSION{
+    ReadConstantString("P2P_COMPRESSION", "node.p2pcomm.", "false") == "true"};
+const unsigned int P2P_COMPRESSION_MIN_BYTES{
+    ReadConstantNumeric("P2P_COMPRESSION_MIN_BYTES", "node.p2pcomm.", 32768)};
 const unsigned int CONNECTION_TIMEOUT_IN_MS{
     ReadConstantNumeric("CONNECTION_TIMEOUT_IN_MS", "node.p2pcomm.", 2000)};
 const unsigned int RECONNECT_INTERVAL_IN_MS{
@@ -633,6 +686,11 @@ const string LIBRARY_CODE_EXTENSION{
     ReadConstantString("LIBRARY_CODE_EXTENSION", "node.smart_contract.")};
 const string EXTLIB_FOLDER{
     ReadConstantString("EXTLIB_FOLDER", "node.smart_contract.")};
+const string SCILLA_STAGING_DIR{ReadConstantString(
+    "SCILLA_STAGING_DIR", "node.smart_contract.", "scilla_staging")};
+const unsigned int SCILLA_STAGING_MAX_FILES{
+    ReadConstantNumeric("SCILLA_STAGING_MAX_FILES", "node.smart_contract.",
+                        4096)};
 const bool ENABLE_SCILLA_MULTI_VERSION{
     ReadConstantString("ENABLE_SCILLA_MULTI_VERSION", "node.smart_contract.") ==
     "true"};
@@ -646,6 +704,10 @@ const unsigned int SCILLA_SERVER_PENDING_IN_MS{
     ReadConstantNumeric("SCILLA_SERVER_PENDING_IN_MS", "node.smart_contract.")};
 unsigned int SCILLA_SERVER_LOOP_WAIT_MICROSECONDS{ReadConstantNumeric(
     "SCILLA_SERVER_LOOP_WAIT_MICROSECONDS", "node.smart_contract.")};
+const unsigned int SCILLA_SERVER_POOL_SIZE{
+    ReadConstantNumeric("SCILLA_SERVER_POOL_SIZE", "node.smart_contract.")};
+const unsigned int SCILLA_STATE_PREFETCH_MAX_ENTRIES{ReadConstantNumeric(
+    "SCILLA_STATE_PREFETCH_MAX_ENTRIES", "node.smart_contract.")};
 
 // Test constants
 const bool ENABLE_CHECK_PERFORMANCE_LOG{
@@ -697,6 +759,13 @@ const unsigned int PACKET_BYTESIZE_LIMIT{
     ReadConstantNumeric("PACKET_BYTESIZE_LIMIT", "node.transactions.")};
 const unsigned int SMALL_TXN_SIZE{
     ReadConstantNumeric("SMALL_TXN_SIZE", "node.transactions.")};
+const unsigned int TXN_SIG_VERIFY_THREADS{
+    ReadConstantNumeric("TXN_SIG_VERIFY_THREADS", "node.transactions.", 0)};
+const bool SPECULATIVE_TXN_EXECUTION{
+    ReadConstantString("SPECULATIVE_TXN_EXECUTION", "node.transactions.",
+                       "false") == "true"};
+const unsigned int SPECULATIVE_TXN_BATCH_SIZE{ReadConstantNumeric(
+    "SPECULATIVE_TXN_BATCH_SIZE", "node.transactions.", 256)};
 const unsigned int ACCOUNT_IO_BATCH_SIZE{
     ReadConstantNumeric("ACCOUNT_IO_BATCH_SIZE", "node.transactions.")};
 const bool ENABLE_REPOPULATE{
@@ -764,6 +833,12 @@ const bool IGNORE_BLOCKCOSIG_CHECK{
     ReadConstantString("IGNORE_BLOCKCOSIG_CHECK", "node.verifier.") == "true"};
 const vector<pair<uint64_t, uint32_t>> VERIFIER_MICROBLOCK_EXCLUSION_LIST{
     ReadVerifierMicroblockExclusionListFromConstantsFile()};
+
+// LevelDB
+const unsigned int LEVELDB_SHARED_BLOCK_CACHE_MB{
+    ReadConstantNumeric("SHARED_BLOCK_CACHE_MB", "node.leveldb.")};
+const vector<LevelDBProfile> LEVELDB_PROFILES{
+    ReadLevelDBProfilesFromConstantsFile()};
 bool ENABLE_EVM{ReadConstantString("ENABLE_EVM", "node.jsonrpc.", "true") ==
                 "true"};
 const std::string EVM_SERVER_SOCKET_PATH{ReadConstantString(
@@ -772,6 +847,12 @@ const std::string EVM_SERVER_BINARY{ReadConstantString(
     "EVM_SERVER_BINARY", "node.jsonrpc.", "/usr/local/bin/evm-ds")};
 const std::string EVM_LOG_CONFIG{ReadConstantString(
     "EVM_LOG_CONFIG", "node.jsonrpc.", "/usr/local/etc/log4rs.yml")};
+const bool EVM_FRAMED_TRANSPORT{
+    ReadConstantString("EVM_FRAMED_TRANSPORT", "node.jsonrpc.", "false") ==
+    "true"};
+const std::string EVM_SERVER_FRAMED_SOCKET_PATH{
+    ReadConstantString("EVM_SERVER_FRAMED_SOCKET_PATH", "node.jsonrpc.",
+                       "/tmp/evm-server-framed.sock")};
 const uint64_t ETH_CHAINID{ReadConstantNumeric("CHAIN_ID") + 0x8000};
 const uint64_t EVM_ZIL_SCALING_FACTOR{
     ReadConstantUInt64("EVM_ZIL_SCALING_FACTOR", "node.jsonrpc.", 1)};
@@ -779,6 +860,11 @@ const uint64_t EVM_BLOCK_LOOKUP_LIMIT{
     ReadConstantUInt64("EVM_BLOCK_LOOKUP_LIMIT", "node.jsonrpc.", 50)};
 const uint64_t EVM_RPC_TIMEOUT_SECONDS{
     ReadConstantUInt64("EVM_RPC_TIMEOUT_SECONDS", "node.jsonrpc.", 60)};
+const bool ENABLE_EVENT_LOG_INDEX{
+    ReadConstantString("ENABLE_EVENT_LOG_INDEX", "node.jsonrpc.", "false") ==
+    "true"};
+const unsigned int EVENT_LOG_INDEX_MAX_RESULTS{
+    ReadConstantNumeric("EVENT_LOG_INDEX_MAX_RESULTS", "node.jsonrpc.", 10000)};
 const bool LAUNCH_EVM_DAEMON{
     ReadConstantString("LAUNCH_EVM_DAEMON", "node.jsonrpc.", "true") == "true"};
 const bool ENABLE_CPS{
@@ -140,6 +140,15 @@ extern const unsigned int NUM_EPOCHS_PER_PERSISTENT_DB;
 extern const bool KEEP_HISTORICAL_STATE;
 extern const bool ENABLE_MEMORY_STATS;
 extern const unsigned int NUM_DS_EPOCHS_STATE_HISTORY;
+extern const unsigned int STATE_PURGE_BATCH_SIZE;
+extern const unsigned int STATE_PURGE_MAX_OPS_PER_SEC;
+extern const unsigned int STATE_PURGE_MAX_BYTES_PER_SEC;
+extern const bool BLOCKSTORAGE_WRITE_BEHIND;
+extern const unsigned int BLOCKSTORAGE_WRITE_BEHIND_MAX_PENDING;
+extern const bool BLOCKSTORAGE_SEGMENT_STORE;
+extern const unsigned int BLOCKSTORAGE_SEGMENT_CHUNK_MB;
+extern const unsigned int BLOCKSTORAGE_TXBODY_CACHE_SIZE;
+extern const unsigned int BLOCKSTORAGE_MICROBLOCK_CACHE_SIZE;
 extern const uint64_t INIT_TRIE_DB_SNAPSHOT_EPOCH;
 extern const unsigned int MAX_ARCHIVED_LOG_COUNT;
 extern const unsigned int MAX_LOG_FILE_SIZE_KB;
@@ -297,6 +306,8 @@ extern bool ENABLE_EVM;
 extern const std::string EVM_SERVER_SOCKET_PATH;
 extern const std::string EVM_SERVER_BINARY;
 extern const std::string EVM_LOG_CONFIG;
+extern const bool EVM_FRAMED_TRANSPORT;
+extern const std::string EVM_SERVER_FRAMED_SOCKET_PATH;
 extern const uint64_t ETH_CHAINID;
 extern const uint64_t EVM_ZIL_SCALING_FACTOR;
 extern const bool LAUNCH_EVM_DAEMON;
@@ -340,6 +351,12 @@ extern const uint32_t MAXSENDMESSAGE;
 extern const uint32_t MAXRECVMESSAGE;
 extern const unsigned int MAXRETRYCONN;
 extern const unsigned int MSGQUEUE_SIZE;
+extern const unsigned int CONSENSUS_MSG_THREADS;
+extern const unsigned int BLOCK_MSG_THREADS;
+extern const unsigned int TXN_MSGQUEUE_SIZE;
+extern const unsigned int TXN_MSG_THREADS;
+extern const unsigned int SYNC_MSGQUEUE_SIZE;
+extern const unsigned int SYNC_MSG_THREADS;
 extern const unsigned int PUMPMESSAGE_MILLISECONDS;
 extern const unsigned int SENDQUEUE_SIZE;
 extern const unsigned int MAX_GOSSIP_MSG_SIZE_IN_BYTES;
@@ -350,6 +367,8 @@ extern const unsigned int MAX_PEER_CONNECTION;
 extern const unsigned int MAX_PEER_CONNECTION_P2PSEED;
 extern const unsigned int MAX_WHITELISTREQ_LIMIT;
 extern const unsigned int SENDJOBPEERS_TIMEOUT;
+extern const bool P2P_COMPRESSION;
+extern const unsigned int P2P_COMPRESSION_MIN_BYTES;
 extern const unsigned int CONNECTION_TIMEOUT_IN_MS;
 extern const unsigned int RECONNECT_INTERVAL_IN_MS;
 
@@ -416,6 +435,8 @@ extern const std::string INPUT_CODE;
 extern const std::string CONTRACT_FILE_EXTENSION;
 extern const std::string LIBRARY_CODE_EXTENSION;
 extern const std::string EXTLIB_FOLDER;
+extern const std::string SCILLA_STAGING_DIR;
+extern const unsigned int SCILLA_STAGING_MAX_FILES;
 extern const bool ENABLE_SCILLA_MULTI_VERSION;
 extern bool ENABLE_SCILLA;
 
@@ -423,6 +444,8 @@ extern const bool LOG_SC;
 extern const bool DISABLE_SCILLA_LIB;
 extern const unsigned int SCILLA_SERVER_PENDING_IN_MS;
 extern unsigned int SCILLA_SERVER_LOOP_WAIT_MICROSECONDS;
+extern const unsigned int SCILLA_SERVER_POOL_SIZE;
+extern const unsigned int SCILLA_STATE_PREFETCH_MAX_ENTRIES;
 const std::string FIELDS_MAP_DEPTH_INDICATOR = "_fields_map_depth";
 const std::string MAP_DEPTH_INDICATOR = "_depth";
 const std::string SCILLA_VERSION_INDICATOR = "_version";
@@ -463,6 +486,9 @@ extern const unsigned int TXNS_MISSING_TOLERANCE_IN_PERCENT;
 extern const unsigned int PACKET_EPOCH_LATE_ALLOW;
 extern const unsigned int PACKET_BYTESIZE_LIMIT;
 extern const unsigned int SMALL_TXN_SIZE;
+extern const unsigned int TXN_SIG_VERIFY_THREADS;
+extern const bool SPECULATIVE_TXN_EXECUTION;
+extern const unsigned int SPECULATIVE_TXN_BATCH_SIZE;
 extern const unsigned int ACCOUNT_IO_BATCH_SIZE;
 extern const bool ENABLE_REPOPULATE;
 extern const unsigned int REPOPULATE_STATE_PER_N_DS;
@@ -475,6 +501,8 @@ extern const bool SHARDLDR_SAVE_TXN_LOCALLY;
 extern const double BLOOM_FILTER_FALSE_RATE;
 extern const unsigned int TXN_DISPATCH_ATTEMPT_LIMIT;
 extern const uint64_t EVM_RPC_TIMEOUT_SECONDS;
+extern const bool ENABLE_EVENT_LOG_INDEX;
+extern const unsigned int EVENT_LOG_INDEX_MAX_RESULTS;
 extern const bool ENABLE_REWARD_DEBUG_FILE;
 extern const unsigned int REWARD_EACH_MUL_IN_MILLIS;
 extern const unsigned int BASE_REWARD_MUL_IN_MILLIS;
@@ -505,6 +533,18 @@ extern const bool IGNORE_BLOCKCOSIG_CHECK;
 extern const std::vector<std::pair<uint64_t, uint32_t>>
     VERIFIER_MICROBLOCK_EXCLUSION_LIST;
 
+// LevelDB constants
+struct LevelDBProfile {
+  std::string dbName;
+  unsigned int blockCacheMB;
+  unsigned int bloomFilterBits;
+  unsigned int writeBufferKB;
+  unsigned int blockSizeKB;
+  bool compression;
+};
+extern const unsigned int LEVELDB_SHARED_BLOCK_CACHE_MB;
+extern const std::vector<LevelDBProfile> LEVELDB_PROFILES;
+
 // Metrics constants
 extern const std::string METRIC_ZILLIQA_HOSTNAME;
 extern const std::string METRIC_ZILLIQA_PROVIDER;
@@ -15,8 +15,13 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <map>
+#include <mutex>
 #include <string>
 
+#include <leveldb/cache.h>
+#include <leveldb/filter_policy.h>
+
 #include "LevelDB.h"
 #include "common/Constants.h"
 #include "depends/common/Common.h"
@@ -34,6 +39,88 @@ void LevelDB::log_error(leveldb::Status status) const {
   }
 }
 
+namespace {
+
+/// Matches a db by name or as a numbered shard of it, e.g. txBodies_3.
+const LevelDBProfile* FindProfile(const string& dbName) {
+  const LevelDBProfile* fallback = nullptr;
+  for (const auto& profile : LEVELDB_PROFILES) {
+    const auto& name = profile.dbName;
+    if (name == "default") {
+      fallback = &profile;
+    } else if (dbName == name ||
+               (dbName.size() > name.size() &&
+                dbName.compare(0, name.size(), name) == 0 &&
+                dbName[name.size()] == '_')) {
+      return &profile;
+    }
+  }
+  return fallback;
+}
+
+// Caches and filter policies are never freed, since any db holding them
+// may be reopened until the process exits
+
+leveldb::Cache* GetBlockCache(const LevelDBProfile& profile) {
+  static leveldb::Cache* sharedCache =
+      LEVELDB_SHARED_BLOCK_CACHE_MB > 0
+          ? leveldb::NewLRUCache(size_t{LEVELDB_SHARED_BLOCK_CACHE_MB} << 20)
+          : nullptr;
+  if (profile.blockCacheMB == 0) {
+    return sharedCache;
+  }
+
+  // Shards of the same db share their profile's cache
+  static mutex mutexCaches;
+  static map<string, leveldb::Cache*> caches;
+  lock_guard<mutex> g(mutexCaches);
+  auto& cache = caches[profile.dbName];
+  if (cache == nullptr) {
+    cache = leveldb::NewLRUCache(size_t{profile.blockCacheMB} << 20);
+  }
+  return cache;
+}
+
+const leveldb::FilterPolicy* GetFilterPolicy(unsigned int bitsPerKey) {
+  if (bitsPerKey == 0) {
+    return nullptr;
+  }
+
+  static mutex mutexPolicies;
+  static map<unsigned int, const leveldb::FilterPolicy*> policies;
+  lock_guard<mutex> g(mutexPolicies);
+  auto& policy = policies[bitsPerKey];
+  if (policy == nullptr) {
+    policy = leveldb::NewBloomFilterPolicy(bitsPerKey);
+  }
+  return policy;
+}
+
+}  // namespace
+
+leveldb::Options LevelDB::MakeOptions(const string& dbName) {
+  leveldb::Options options;
+  options.max_open_files = 256;
+  options.create_if_missing = true;
+
+  const auto* profile = FindProfile(dbName);
+  if (profile == nullptr) {
+    return options;
+  }
+
+  if (profile->writeBufferKB > 0) {
+    options.write_buffer_size = size_t{profile->writeBufferKB} << 10;
+  }
+  if (profile->blockSizeKB > 0) {
+    options.block_size = size_t{profile->blockSizeKB} << 10;
+  }
+  options.compression = profile->compression ? leveldb::kSnappyCompression
+                                             : leveldb::kNoCompression;
+  options.block_cache = GetBlockCache(*profile);
+  options.filter_policy = GetFilterPolicy(profile->bloomFilterBits);
+  return options;
+}
+
 LevelDB::LevelDB(const string& dbName, const string& path,
                  const string& subdirectory) {
   this->m_subdirectory = subdirectory;
@@ -45,8 +132,7 @@ LevelDB::LevelDB(const string& dbName, const string& path,
     return;
   }
 
-  m_options.max_open_files = 256;
-  m_options.create_if_missing = true;
+  m_options = MakeOptions(dbName);
 
   leveldb::DB* db;
   leveldb::Status status;
@@ -77,8 +163,7 @@ LevelDB::LevelDB(const std::string& dbName, const std::string& subdirectory,
   this->m_subdirectory = subdirectory;
   this->m_dbName = dbName;
 
-  m_options.max_open_files = 256;
-  m_options.create_if_missing = true;
+  m_options = MakeOptions(dbName);
 
   leveldb::DB* db;
   leveldb::Status status;
@@ -356,7 +441,7 @@ bool LevelDB::BatchInsert(
 }
 
 bool LevelDB::BatchInsert(
-    const std::unordered_map<std::string, std::string>& kv_map) {
+    const std::unordered_map<std::string, std::string>& kv_map, bool sync) {
   ldb::WriteBatch batch;
 
   for (const auto& i : kv_map) {
@@ -365,7 +450,9 @@ bool LevelDB::BatchInsert(
     }
   }
 
-  ldb::Status s = m_db->Write(leveldb::WriteOptions(), &batch);
+  ldb::WriteOptions options;
+  options.sync = sync;
+  ldb::Status s = m_db->Write(options, &batch);
 
   if (!s.ok()) {
     LOG_GENERAL(WARNING, "[BatchInsert] Status: " << s.ToString());
@@ -476,14 +563,10 @@ bool LevelDB::ResetDB() {
 bool LevelDB::RefreshDB() {
   m_db.reset();
 
-  leveldb::Options options;
-  options.max_open_files = 256;
-  options.create_if_missing = true;
-
   leveldb::DB* db;
 
   leveldb::Status status = leveldb::DB::Open(
-      options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+      m_options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
   if (!status.ok()) {
     // throw exception();
     LOG_GENERAL(WARNING, "LevelDB " << m_dbName << " status is not OK - "
@@ -520,14 +603,10 @@ bool LevelDB::ResetDBForNormalNode() {
     std::filesystem::remove_all(STORAGE_PATH + PERSISTENCE_PATH + "/" +
                                 this->m_dbName);
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
-
     leveldb::DB* db;
 
     leveldb::Status status = leveldb::DB::Open(
-        options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+        m_options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
     if (!status.ok()) {
       // throw exception();
       LOG_GENERAL(WARNING, "LevelDB " << m_dbName << " status is not OK - "
@@ -559,14 +638,10 @@ bool LevelDB::ResetDBForLookupNode() {
     std::filesystem::remove_all(STORAGE_PATH + PERSISTENCE_PATH + "/" +
                                 this->m_dbName);
 
-    leveldb::Options options;
-    options.max_open_files = 256;
-    options.create_if_missing = true;
-
     leveldb::DB* db;
 
     leveldb::Status status = leveldb::DB::Open(
-        options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
+        m_options, STORAGE_PATH + PERSISTENCE_PATH + "/" + this->m_dbName, &db);
     if (!status.ok()) {
       // throw exception();
       LOG_GENERAL(WARNING, "LevelDB " << m_dbName << " status is not OK - "
@@ -47,6 +47,9 @@ class LevelDB
 
     void log_error(leveldb::Status status) const;
 
+    /// Builds the open options for a db from its profile in constants.xml.
+    static leveldb::Options MakeOptions(const std::string& dbName);
+
 public:
 
     /// Constructor.
@@ -120,7 +123,9 @@ public:
     /// Sets the value at the specified key for multiple such pairs.
     bool BatchInsert(const std::unordered_map<dev::h256, std::pair<std::string, unsigned>> & m_main,
                      const std::unordered_map<dev::h256, std::pair<dev::zbytes, bool>> & m_aux, std::unordered_set<dev::h256>& inserted);
-    bool BatchInsert(const std::unordered_map<std::string, std::string>& kv_map);
+    /// With sync set, returns only once the batch is flushed to disk.
+    bool BatchInsert(const std::unordered_map<std::string, std::string>& kv_map,
+                     bool sync = false);
 
     /// Remove the kv pair for multiple specified key.
     bool BatchDelete(const std::vector<dev::h256>& toDelete);
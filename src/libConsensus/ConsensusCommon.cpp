@@ -15,6 +15,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/obj_mac.h>
+
 #include "ConsensusCommon.h"
 #include "common/Constants.h"
 #include "common/Messages.h"
@@ -31,6 +37,40 @@
 
 using namespace std;
 
+namespace {
+
+// Returns minuend - subtrahend on the curve the Schnorr keys live on, or
+// nullptr if either key is missing or the arithmetic fails
+shared_ptr<PubKey> SubtractKeys(const shared_ptr<PubKey>& minuend,
+                                const shared_ptr<PubKey>& subtrahend) {
+  static const shared_ptr<EC_GROUP> curve(
+      EC_GROUP_new_by_curve_name(NID_secp256k1), EC_GROUP_free);
+
+  if (!curve || !minuend || !subtrahend || !minuend->m_P ||
+      !subtrahend->m_P) {
+    return nullptr;
+  }
+
+  shared_ptr<EC_POINT> negated(EC_POINT_dup(subtrahend->m_P.get(), curve.get()),
+                               EC_POINT_clear_free);
+  shared_ptr<EC_POINT> difference(EC_POINT_new(curve.get()),
+                                  EC_POINT_clear_free);
+  unique_ptr<BN_CTX, decltype(&BN_CTX_free)> ctx(BN_CTX_new(), BN_CTX_free);
+  if (!negated || !difference || !ctx ||
+      EC_POINT_invert(curve.get(), negated.get(), ctx.get()) != 1 ||
+      EC_POINT_add(curve.get(), difference.get(), minuend->m_P.get(),
+                   negated.get(), ctx.get()) != 1) {
+    LOG_GENERAL(WARNING, "Failed to subtract aggregated keys");
+    return nullptr;
+  }
+
+  auto result = make_shared<PubKey>(*minuend);
+  result->m_P = difference;
+  return result;
+}
+
+}  // namespace
+
 map<ConsensusCommon::ConsensusErrorCode, std::string>
     ConsensusCommon::CONSENSUSERRORMSG = {
         MAKE_LITERAL_PAIR(NO_ERROR),
@@ -119,18 +159,52 @@ bool ConsensusCommon::VerifyMessage(const zbytes& msg, unsigned int offset,
 PubKey ConsensusCommon::AggregateKeys(const vector<bool>& peer_map) {
   LOG_MARKER();
 
+  lock_guard<mutex> g(m_mutexAggregatedKeys);
+
+  // Subsets with the same participants, and the response round after the
+  // commit round, end up asking for the same bitmap
+  const auto cached = m_aggregatedKeys.find(peer_map);
+  if (cached != m_aggregatedKeys.end()) {
+    return cached->second;
+  }
+
+  // Only the smaller of the two sides is copied out of the committee: the
+  // participants, or the absentees to take off the whole committee's key
+  const auto numAbsent =
+      static_cast<size_t>(count(peer_map.begin(), peer_map.end(), false));
+  const bool subtract = peer_map.size() == m_committee.size() &&
+                        numAbsent < peer_map.size() - numAbsent;
+
   vector<PubKey> keys;
   DequeOfNode::const_iterator j = m_committee.begin();
   for (unsigned int i = 0; i < peer_map.size(); ++i, ++j) {
-    if (peer_map.at(i)) {
+    if (peer_map.at(i) != subtract) {
       keys.emplace_back(j->first);
     }
   }
-  shared_ptr<PubKey> result = MultiSig::AggregatePubKeys(keys);
+
+  shared_ptr<PubKey> result;
+  if (subtract) {
+    if (!m_committeeAggregatedKey) {
+      vector<PubKey> committeeKeys;
+      committeeKeys.reserve(m_committee.size());
+      for (const auto& member : m_committee) {
+        committeeKeys.emplace_back(member.first);
+      }
+      m_committeeAggregatedKey = MultiSig::AggregatePubKeys(committeeKeys);
+    }
+    result = keys.empty() ? m_committeeAggregatedKey
+                          : SubtractKeys(m_committeeAggregatedKey,
+                                         MultiSig::AggregatePubKeys(keys));
+  } else {
+    result = MultiSig::AggregatePubKeys(keys);
+  }
+
   if (result == nullptr) {
     return PubKey();
   }
 
+  m_aggregatedKeys.emplace(peer_map, *result);
   return *result;
 }
 
@@ -20,6 +20,7 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -171,6 +172,13 @@ class ConsensusCommon {
   bool m_DS;
   unsigned int m_numOfSubsets;
 
+  /// Aggregate of every committee key, the base absentees are subtracted from
+  std::shared_ptr<PubKey> m_committeeAggregatedKey;
+
+  /// Aggregated keys by participation bitmap, shared by the subsets and rounds
+  std::map<std::vector<bool>, PubKey> m_aggregatedKeys;
+  std::mutex m_mutexAggregatedKeys;
+
   /// Constructor.
   ConsensusCommon(uint32_t consensus_id, uint64_t block_number,
                   const zbytes& block_hash, uint16_t my_id,
@@ -217,6 +225,15 @@ class ConsensusCommon {
                    // ConsensusBackup
   }
 
+  /// Does the stateless part of processing a message ahead of
+  /// ProcessMessage, so callers can run it before serializing on their
+  /// consensus locks
+  virtual bool PreVerifyMessage([[gnu::unused]] const zbytes& message,
+                                [[gnu::unused]] unsigned int offset,
+                                [[gnu::unused]] const Peer& from) {
+    return true;
+  }
+
   /// Returns the state of the active consensus session
   State GetState() const;
 
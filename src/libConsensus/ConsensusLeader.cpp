@@ -17,6 +17,7 @@
 
 #include "ConsensusLeader.h"
 
+#include <algorithm>
 #include <utility>
 #include "common/Constants.h"
 #include "common/Messages.h"
@@ -392,27 +393,9 @@ void ConsensusLeader::SubsetEnded(uint16_t subsetID) {
   }
 }
 
-bool ConsensusLeader::ProcessMessageCommitCore(
-    const zbytes& commit, unsigned int offset, Action action,
-    [[gnu::unused]] ConsensusMessageType returnmsgtype,
-    [[gnu::unused]] State nextstate, const Peer& from,
-    std::string_view spanName) {
-  LOG_MARKER();
-
-  lock_guard<mutex> g(m_mutex);
-
-  // Initial checks
-  // ==============
-
-  if (!CheckState(action)) {
-    return false;
-  }
-
-  // Extract and check commit message body
-  // =====================================
-
-  uint16_t backupID = 0;
-
+bool ConsensusLeader::DecodeCommit(const zbytes& commit, unsigned int offset,
+                                   const Peer& from, uint16_t& backupID,
+                                   vector<CommitPoint>& commitPoints) {
   vector<CommitInfo> commitInfo;
 
   if (!Messenger::GetConsensusCommit(commit, offset, m_consensusID,
@@ -437,12 +420,6 @@ bool ConsensusLeader::ProcessMessageCommitCore(
     return false;
   }
 
-  if (m_commitMap.at(backupID)) {
-    LOG_GENERAL(WARNING, "Backup already sent commit");
-    return false;
-  }
-
-  vector<CommitPoint> commitPoints;
   for (auto& ci : commitInfo) {
     // Check the commit
     if (!ci.commit.Initialized()) {
@@ -466,6 +443,46 @@ bool ConsensusLeader::ProcessMessageCommitCore(
     commitPoints.emplace_back(ci.commit);
   }
 
+  return true;
+}
+
+bool ConsensusLeader::ProcessMessageCommitCore(
+    const zbytes& commit, unsigned int offset, Action action,
+    [[gnu::unused]] ConsensusMessageType returnmsgtype,
+    [[gnu::unused]] State nextstate, const Peer& from,
+    std::string_view spanName) {
+  LOG_MARKER();
+
+  // Initial checks
+  // ==============
+
+  if (!CheckState(action)) {
+    return false;
+  }
+
+  // Extract and check commit message body
+  // =====================================
+  // This only reads the committee and block being agreed on, so it is done
+  // before taking m_mutex, unless PreVerifyMessage already did it
+
+  uint16_t backupID = 0;
+  vector<CommitPoint> commitPoints;
+
+  VerifiedMessage verified;
+  if (TakeVerifiedMessage(commit, offset, verified)) {
+    backupID = verified.backupID;
+    commitPoints = std::move(verified.commitPoints);
+  } else if (!DecodeCommit(commit, offset, from, backupID, commitPoints)) {
+    return false;
+  }
+
+  lock_guard<mutex> g(m_mutex);
+
+  if (m_commitMap.at(backupID)) {
+    LOG_GENERAL(WARNING, "Backup already sent commit");
+    return false;
+  }
+
   // Update internal state
   // =====================
 
@@ -643,6 +660,33 @@ bool ConsensusLeader::GenerateChallengeMessage(zbytes& challenge,
   return true;
 }
 
+bool ConsensusLeader::DecodeResponse(const zbytes& response,
+                                     unsigned int offset, const Peer& from,
+                                     uint16_t& backupID,
+                                     vector<ResponseSubsetInfo>& subsetInfo) {
+  if (!Messenger::GetConsensusResponse(response, offset, m_consensusID,
+                                       m_blockNumber, m_blockHash, backupID,
+                                       subsetInfo, m_committee)) {
+    LOG_GENERAL(WARNING, "Messenger::GetConsensusResponse failed");
+    return false;
+  }
+
+  // Check the IP belongs to the backup with that backupID (check for valid
+  // backupID range is already done in Messenger)
+  if (m_committee.at(backupID).second.m_ipAddress != from.m_ipAddress) {
+    LOG_CHECK_FAIL("Backup IP", from.GetPrintableIPAddress(),
+                   m_committee.at(backupID).second.GetPrintableIPAddress());
+    return false;
+  }
+
+  if (subsetInfo.empty()) {
+    LOG_GENERAL(WARNING, "Empty response from " << backupID);
+    return false;
+  }
+
+  return true;
+}
+
 bool ConsensusLeader::ProcessMessageResponseCore(
     const zbytes& response, unsigned int offset, Action action,
     ConsensusMessageType returnmsgtype, State nextstate, const Peer& from,
@@ -661,10 +705,11 @@ bool ConsensusLeader::ProcessMessageResponseCore(
   uint16_t backupID = 0;
   vector<ResponseSubsetInfo> subsetInfo;
 
-  if (!Messenger::GetConsensusResponse(response, offset, m_consensusID,
-                                       m_blockNumber, m_blockHash, backupID,
-                                       subsetInfo, m_committee)) {
-    LOG_GENERAL(WARNING, "Messenger::GetConsensusResponse failed");
+  VerifiedMessage verified;
+  if (TakeVerifiedMessage(response, offset, verified)) {
+    backupID = verified.backupID;
+    subsetInfo = std::move(verified.subsetInfo);
+  } else if (!DecodeResponse(response, offset, from, backupID, subsetInfo)) {
     return false;
   }
 
@@ -676,14 +721,6 @@ bool ConsensusLeader::ProcessMessageResponseCore(
   span.SetAttribute(attrBase + ".from_ip",
                     IPConverter::ToStrFromNumericalIP(from.m_ipAddress));
 
-  // Check the IP belongs to the backup with that backupID (check for valid
-  // backupID range is already done in Messenger)
-  if (m_committee.at(backupID).second.m_ipAddress != from.m_ipAddress) {
-    LOG_CHECK_FAIL("Backup IP", from.GetPrintableIPAddress(),
-                   m_committee.at(backupID).second.GetPrintableIPAddress());
-    return false;
-  }
-
   // Check the subset size
   if (subsetInfo.size() > m_consensusSubsets.size()) {
     LOG_GENERAL(WARNING, "Response count " << subsetInfo.size() << " > "
@@ -691,11 +728,6 @@ bool ConsensusLeader::ProcessMessageResponseCore(
     return false;
   }
 
-  if (subsetInfo.empty()) {
-    LOG_GENERAL(WARNING, "Empty response from " << backupID);
-    return false;
-  }
-
   bool guardInOtherSubsets = false;
   LOG_GENERAL(INFO, "Response sender1 = "<<from);
 
@@ -727,7 +759,12 @@ bool ConsensusLeader::ProcessMessageResponseCore(
       continue;
     }
 
-    if (!MultiSig::VerifyResponse(subsetInfo.at(subsetID).response,
+    const bool preVerified =
+        static_cast<size_t>(subsetID) < verified.validForChallenge.size() &&
+        verified.validForChallenge.at(subsetID).Initialized() &&
+        verified.validForChallenge.at(subsetID) == subset.challenge;
+    if (!preVerified &&
+        !MultiSig::VerifyResponse(subsetInfo.at(subsetID).response,
                                   subset.challenge,
                                   GetCommitteeMember(backupID).first,
                                   subset.commitPointMap.at(backupID))) {
@@ -758,6 +795,13 @@ bool ConsensusLeader::ProcessMessageResponseCore(
       return false;
     }
 
+    // Checked again now that concurrent responses are serialized
+    if (subset.responseMap.at(backupID)) {
+      LOG_GENERAL(WARNING, "[Subset " << subsetID << "] [Backup " << backupID
+                                      << "] Already responded");
+      continue;
+    }
+
     // 32-byte response
     subset.responseData.emplace_back(subsetInfo.at(subsetID).response);
     subset.responseDataMap.at(backupID) = subsetInfo.at(subsetID).response;
@@ -1188,6 +1232,91 @@ bool ConsensusLeader::ProcessMessage(const zbytes& message, unsigned int offset,
   return result;
 }
 
+bool ConsensusLeader::PreVerifyMessage(const zbytes& message,
+                                       unsigned int offset, const Peer& from) {
+  if (message.size() <= offset) {
+    return false;
+  }
+
+  VerifiedMessage verified;
+
+  switch (message.at(offset)) {
+    case ConsensusMessageType::COMMIT:
+    case ConsensusMessageType::FINALCOMMIT:
+      if (!DecodeCommit(message, offset + 1, from, verified.backupID,
+                        verified.commitPoints)) {
+        return false;
+      }
+      break;
+    case ConsensusMessageType::RESPONSE:
+    case ConsensusMessageType::FINALRESPONSE: {
+      if (!DecodeResponse(message, offset + 1, from, verified.backupID,
+                          verified.subsetInfo)) {
+        return false;
+      }
+
+      // Only the challenges and the backup's commits are needed from the
+      // subsets, the responses are checked against them outside m_mutex
+      vector<pair<Challenge, CommitPoint>> subsets;
+      {
+        lock_guard<mutex> g(m_mutex);
+        for (size_t subsetID = 0; subsetID < verified.subsetInfo.size() &&
+                                  subsetID < m_consensusSubsets.size();
+             subsetID++) {
+          const ConsensusSubset& subset = m_consensusSubsets.at(subsetID);
+          if (verified.backupID < subset.commitMap.size() &&
+              subset.commitMap.at(verified.backupID)) {
+            subsets.emplace_back(subset.challenge,
+                                 subset.commitPointMap.at(verified.backupID));
+          } else {
+            subsets.emplace_back();
+          }
+        }
+      }
+
+      const PubKey& backupKey = m_committee.at(verified.backupID).first;
+      verified.validForChallenge.resize(subsets.size());
+      for (size_t subsetID = 0; subsetID < subsets.size(); subsetID++) {
+        const auto& [challenge, commitPoint] = subsets.at(subsetID);
+        if (challenge.Initialized() && commitPoint.Initialized() &&
+            MultiSig::VerifyResponse(verified.subsetInfo.at(subsetID).response,
+                                     challenge, backupKey, commitPoint)) {
+          verified.validForChallenge.at(subsetID) = challenge;
+        }
+      }
+      break;
+    }
+    default:
+      return true;
+  }
+
+  verified.body.assign(message.begin() + offset + 1, message.end());
+
+  lock_guard<mutex> g(m_mutexVerifiedMessages);
+  m_verifiedMessages[this_thread::get_id()] = std::move(verified);
+  return true;
+}
+
+bool ConsensusLeader::TakeVerifiedMessage(const zbytes& message,
+                                          unsigned int offset,
+                                          VerifiedMessage& verified) {
+  lock_guard<mutex> g(m_mutexVerifiedMessages);
+
+  auto it = m_verifiedMessages.find(this_thread::get_id());
+  if (it == m_verifiedMessages.end()) {
+    return false;
+  }
+
+  const bool sameMessage =
+      equal(message.begin() + offset, message.end(), it->second.body.begin(),
+            it->second.body.end());
+  if (sameMessage) {
+    verified = std::move(it->second);
+  }
+  m_verifiedMessages.erase(it);
+  return sameMessage;
+}
+
 void ConsensusLeader::Audit(bool checkForResponses) {
   LOG_MARKER();
 
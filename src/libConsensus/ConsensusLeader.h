@@ -19,6 +19,8 @@
 #define ZILLIQA_SRC_LIBCONSENSUS_CONSENSUSLEADER_H_
 
 #include <condition_variable>
+#include <thread>
+#include <unordered_map>
 
 #include "ConsensusCommon.h"
 #include "libMetrics/Api.h"
@@ -89,6 +91,19 @@ class ConsensusLeader : public ConsensusCommon {
   std::vector<ConsensusSubset> m_consensusSubsets;
   unsigned int m_numSubsetsRunning;
 
+  // A backup's commit or response decoded and checked by PreVerifyMessage
+  struct VerifiedMessage {
+    zbytes body;  // Message bytes following the consensus message type
+    uint16_t backupID{};
+    std::vector<CommitPoint> commitPoints;
+    std::vector<ResponseSubsetInfo> subsetInfo;
+    // Per subset, the challenge the response was found valid against
+    std::vector<Challenge> validForChallenge;
+  };
+  // Kept per dispatching thread until its ProcessMessage call picks it up
+  std::mutex m_mutexVerifiedMessages;
+  std::unordered_map<std::thread::id, VerifiedMessage> m_verifiedMessages;
+
   NodeCommitFailureHandlerFunc m_nodeCommitFailureHandlerFunc;
   ShardCommitFailureHandlerFunc m_shardCommitFailureHandlerFunc;
 
@@ -101,6 +116,14 @@ class ConsensusLeader : public ConsensusCommon {
   void GenerateConsensusSubsets();
   bool StartConsensusSubsets();
   void SubsetEnded(uint16_t subsetID);
+  bool DecodeCommit(const zbytes& commit, unsigned int offset,
+                    const Peer& from, uint16_t& backupID,
+                    std::vector<CommitPoint>& commitPoints);
+  bool DecodeResponse(const zbytes& response, unsigned int offset,
+                      const Peer& from, uint16_t& backupID,
+                      std::vector<ResponseSubsetInfo>& subsetInfo);
+  bool TakeVerifiedMessage(const zbytes& message, unsigned int offset,
+                           VerifiedMessage& verified);
   bool ProcessMessageCommitCore(const zbytes& commit, unsigned int offset,
                                 Action action,
                                 ConsensusMessageType returnmsgtype,
@@ -157,6 +180,12 @@ class ConsensusLeader : public ConsensusCommon {
   bool ProcessMessage(const zbytes& message, unsigned int offset,
                       const Peer& from);
 
+  /// Decodes a backup's commit or response and checks its signatures without
+  /// holding the consensus lock, for ProcessMessage to pick up on the same
+  /// thread.
+  bool PreVerifyMessage(const zbytes& message, unsigned int offset,
+                        const Peer& from);
+
   unsigned int GetNumForConsensusFailure() { return m_numForConsensusFailure; }
 
   /// Function to check for missing responses
@@ -170,8 +170,7 @@ std::optional<evm::EvmResult> CpsRunEvm::InvokeEvm() {
     try {
       auto span = Tracing::CreateChildSpanOfRemoteTrace(
           FilterClass::FILTER_CLASS_ALL, "InvokeEvm", trace_info);
-      EvmClient::GetInstance().CallRunner(EvmUtils::GetEvmCallJson(args),
-                                          result);
+      EvmClient::GetInstance().CallRunner(args, result);
     } catch (std::exception& e) {
       INC_STATUS(GetCPSMetric(), "error", "Rpc exception");
       LOG_GENERAL(WARNING, "Exception from underlying RPC call " << e.what());
@@ -154,8 +154,8 @@ CpsExecuteResult CpsRunScilla::runCreate(TransactionReceipt& receipt) {
   if (!ScillaHelpers::ExportCreateContractFiles(
           mAccountStore.GetContractCode(mArgs.dest),
           mAccountStore.GetContractInitData(mArgs.dest), isLibrary,
-          mAccountStore.GetScillaRootVersion(), scillaVersion,
-          extlibsExports)) {
+          mAccountStore.GetScillaRootVersion(), scillaVersion, extlibsExports,
+          mScillaFiles)) {
     span.SetError("Unable to export create contract files");
     return {TxnStatus::FAIL_SCILLA_LIB, false, failedRetScillaVal};
   }
@@ -309,16 +309,16 @@ CpsExecuteResult CpsRunScilla::runCall(TransactionReceipt& receipt) {
     const auto& calldata = std::get<ScillaArgs::CodeData>(mArgs.calldata);
     if (!ScillaHelpers::ExportCallContractFiles(
             mAccountStore, mArgs.from, mArgs.dest, calldata.data, mArgs.value,
-            scillaVersion, extlibsExports)) {
+            scillaVersion, extlibsExports, mScillaFiles)) {
       span.SetError("Unable to export call contract files");
       return {TxnStatus::FAIL_SCILLA_LIB, false, retScillaVal};
     }
 
   } else {
     const auto& jsonData = std::get<Json::Value>(mArgs.calldata);
-    if (!ScillaHelpers::ExportCallContractFiles(mAccountStore, mArgs.dest,
-                                                jsonData, scillaVersion,
-                                                extlibsExports)) {
+    if (!ScillaHelpers::ExportCallContractFiles(
+            mAccountStore, mArgs.dest, jsonData, scillaVersion, extlibsExports,
+            mScillaFiles)) {
       span.SetError("Unable to export call contract files");
       return {TxnStatus::FAIL_SCILLA_LIB, false, retScillaVal};
     }
@@ -440,7 +440,7 @@ ScillaInvokeResult CpsRunScilla::InvokeScillaInterpreter(INVOKE_TYPE type) {
   }
 
   using namespace zil::trace;
-  auto func2 = [this, &interprinterPrint, type, &scillaVersion, &isLibrary,
+  auto func2 = [this, &interprinterPrint, type, &scillaVersion,
                 &callAlreadyFinished,
                 trace_info =
                     Tracing::GetActiveSpan().GetIds()]() mutable -> void {
@@ -455,7 +455,7 @@ ScillaInvokeResult CpsRunScilla::InvokeScillaInterpreter(INVOKE_TYPE type) {
         if (!ScillaClient::GetInstance().CallChecker(
                 scillaVersion,
                 ScillaUtils::GetContractCheckerJson(
-                    mAccountStore.GetScillaRootVersion(), isLibrary,
+                    mScillaFiles, mAccountStore.GetScillaRootVersion(),
                     mCpsContext.gasTracker.GetCoreGas()),
                 interprinterPrint)) {
         }
@@ -466,7 +466,7 @@ ScillaInvokeResult CpsRunScilla::InvokeScillaInterpreter(INVOKE_TYPE type) {
         if (!ScillaClient::GetInstance().CallRunner(
                 scillaVersion,
                 ScillaUtils::GetCreateContractJson(
-                    mAccountStore.GetScillaRootVersion(), isLibrary,
+                    mScillaFiles, mAccountStore.GetScillaRootVersion(),
                     mCpsContext.gasTracker.GetCoreGas(), mArgs.value.toQa()),
                 interprinterPrint)) {
         }
@@ -477,10 +477,9 @@ ScillaInvokeResult CpsRunScilla::InvokeScillaInterpreter(INVOKE_TYPE type) {
         if (!ScillaClient::GetInstance().CallRunner(
                 scillaVersion,
                 ScillaUtils::GetCallContractJson(
-                    mAccountStore.GetScillaRootVersion(),
+                    mScillaFiles, mAccountStore.GetScillaRootVersion(),
                     mCpsContext.gasTracker.GetCoreGas(),
-                    mAccountStore.GetBalanceForAccountAtomic(mArgs.dest).toQa(),
-                    isLibrary),
+                    mAccountStore.GetBalanceForAccountAtomic(mArgs.dest).toQa()),
                 interprinterPrint)) {
         }
         break;
@@ -488,7 +487,7 @@ ScillaInvokeResult CpsRunScilla::InvokeScillaInterpreter(INVOKE_TYPE type) {
       case INVOKE_TYPE::DISAMBIGUATE: {
         INC_STATUS(GetCPSMetric(), "ScillaInterpreterInvoke", "disambiguate");
         if (!ScillaClient::GetInstance().CallDisambiguate(
-                scillaVersion, ScillaUtils::GetDisambiguateJson(),
+                scillaVersion, ScillaUtils::GetDisambiguateJson(mScillaFiles),
                 interprinterPrint)) {
         }
         break;
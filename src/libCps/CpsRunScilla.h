@@ -21,6 +21,7 @@
 #include "libCps/Amount.h"
 #include "libCps/CpsExecuteResult.h"
 #include "libCps/CpsRun.h"
+#include "libScilla/ScillaUtils.h"
 
 #include <json/json.h>
 #include <variant>
@@ -89,6 +90,7 @@ class CpsRunScilla final : public CpsRun {
   ScillaArgs mArgs;
   CpsExecutor& mExecutor;
   CpsContext& mCpsContext;
+  ScillaFilePaths mScillaFiles;
 };
 
 }  // namespace libCps
@@ -37,42 +37,41 @@ namespace libCps {
 
 constexpr auto MAX_SCILLA_OUTPUT_SIZE_IN_BYTES = 5120;
 
-void ScillaHelpers::ExportCommonFiles(
-    const std::vector<uint8_t> &contract_init_data, std::ofstream &os,
-    const std::map<Address, std::pair<std::string, std::string>>
-        &extlibs_exports) {
-  return ScillaUtils::ExportCommonFiles(contract_init_data, os,
-                                        extlibs_exports);
-}
-
 bool ScillaHelpers::ExportCreateContractFiles(
     const std::vector<uint8_t> &contract_code,
     const std::vector<uint8_t> &contract_init_data, bool is_library,
     std::string &scilla_root_version, uint32_t scilla_version,
     const std::map<Address, std::pair<std::string, std::string>>
-        &extlibs_exports) {
+        &extlibs_exports,
+    ScillaFilePaths &files) {
   LOG_MARKER();
 
-  return ScillaUtils::ExportCreateContractFiles(
-      contract_code, contract_init_data, is_library, scilla_root_version,
-      scilla_version, extlibs_exports);
+  if (!ScillaUtils::PrepareRootPathWVersion(scilla_version,
+                                            scilla_root_version)) {
+    LOG_GENERAL(WARNING, "PrepareRootPathWVersion failed");
+    return false;
+  }
+
+  try {
+    return ScillaUtils::StageContractFiles(
+        DataConversion::CharArrayToString(contract_code),
+        DataConversion::CharArrayToString(contract_init_data), is_library,
+        extlibs_exports, files);
+  } catch (const std::exception &e) {
+    LOG_GENERAL(WARNING, "Exception caught: " << e.what());
+    return false;
+  }
 }
 
 bool ScillaHelpers::ExportContractFiles(
     CpsAccountStoreInterface &acc_store, const Address &contract,
     uint32_t scilla_version,
     const std::map<Address, std::pair<std::string, std::string>>
-        &extlibs_exports) {
+        &extlibs_exports,
+    ScillaFilePaths &files) {
   LOG_MARKER();
   std::chrono::system_clock::time_point tpStart;
 
-  std::filesystem::remove_all("./" + SCILLA_FILES);
-  std::filesystem::create_directories("./" + SCILLA_FILES);
-
-  if (!(std::filesystem::exists("./" + SCILLA_LOG))) {
-    std::filesystem::create_directories("./" + SCILLA_LOG);
-  }
-
   if (ENABLE_CHECK_PERFORMANCE_LOG) {
     tpStart = r_timer_start();
   }
@@ -84,12 +83,14 @@ bool ScillaHelpers::ExportContractFiles(
   }
 
   try {
-    std::string scillaCodeExtension = CONTRACT_FILE_EXTENSION;
-    if (acc_store.IsAccountALibrary(contract)) {
-      scillaCodeExtension = LIBRARY_CODE_EXTENSION;
+    if (!ScillaUtils::StageContractFiles(
+            DataConversion::CharArrayToString(
+                acc_store.GetContractCode(contract)),
+            DataConversion::CharArrayToString(
+                acc_store.GetContractInitData(contract)),
+            acc_store.IsAccountALibrary(contract), extlibs_exports, files)) {
+      return false;
     }
-    CreateScillaCodeFiles(acc_store, contract, extlibs_exports,
-                          scillaCodeExtension);
   } catch (const std::exception &e) {
     LOG_GENERAL(WARNING, "Exception caught: " << e.what());
     return false;
@@ -106,13 +107,14 @@ bool ScillaHelpers::ExportCallContractFiles(
     const Address &contract, const zbytes &data, const Amount &amount,
     uint32_t scilla_version,
     const std::map<Address, std::pair<std::string, std::string>>
-        &extlibs_exports) {
+        &extlibs_exports,
+    ScillaFilePaths &files) {
   LOG_MARKER();
   LOG_GENERAL(WARNING, "ExportCallContractFiles:, contract: "
                            << contract.hex() << ", sender: " << sender.hex()
                            << ", origin: " << sender.hex());
   if (!ExportContractFiles(acc_store, contract, scilla_version,
-                           extlibs_exports)) {
+                           extlibs_exports, files)) {
     LOG_GENERAL(WARNING, "ExportContractFiles failed");
     return false;
   }
@@ -130,51 +132,28 @@ bool ScillaHelpers::ExportCallContractFiles(
     msgObj["_origin"] = prepend + sender.hex();
     msgObj["_amount"] = amount.toQa().convert_to<std::string>();
 
-    JSONUtils::GetInstance().writeJsontoFile(INPUT_MESSAGE_JSON, msgObj);
+    return ScillaUtils::StageMessageFile(msgObj, files);
   } catch (const std::exception &e) {
     LOG_GENERAL(WARNING, "Exception caught: " << e.what());
     return false;
   }
-
-  return true;
 }
 
 bool ScillaHelpers::ExportCallContractFiles(
     CpsAccountStoreInterface &acc_store, const Address &contract,
     const Json::Value &contractData, uint32_t scilla_version,
     const std::map<Address, std::pair<std::string, std::string>>
-        &extlibs_exports) {
+        &extlibs_exports,
+    ScillaFilePaths &files) {
   LOG_MARKER();
   LOG_GENERAL(WARNING, "ExportCallContractFiles: contract: " << contract.hex());
   if (!ExportContractFiles(acc_store, contract, scilla_version,
-                           extlibs_exports)) {
+                           extlibs_exports, files)) {
     LOG_GENERAL(WARNING, "ExportContractFiles failed");
     return false;
   }
 
-  try {
-    JSONUtils::GetInstance().writeJsontoFile(INPUT_MESSAGE_JSON, contractData);
-  } catch (const std::exception &e) {
-    LOG_GENERAL(WARNING, "Exception caught: " << e.what());
-    return false;
-  }
-
-  return true;
-}
-
-void ScillaHelpers::CreateScillaCodeFiles(
-    CpsAccountStoreInterface &acc_store, const Address &contract,
-    const std::map<Address, std::pair<std::string, std::string>>
-        &extlibs_exports,
-    const std::string &scillaCodeExtension) {
-  LOG_MARKER();
-  // Scilla code
-  std::ofstream os(INPUT_CODE + scillaCodeExtension);
-  os << DataConversion::CharArrayToString(acc_store.GetContractCode(contract));
-  os.close();
-
-  ExportCommonFiles(acc_store.GetContractInitData(contract), os,
-                    extlibs_exports);
+  return ScillaUtils::StageMessageFile(contractData, files);
 }
 
 bool ScillaHelpers::ParseContractCheckerOutput(
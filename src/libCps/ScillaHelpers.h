@@ -25,6 +25,7 @@
 
 class Transaction;
 class TransactionReceipt;
+struct ScillaFilePaths;
 
 namespace libCps {
 
@@ -35,27 +36,23 @@ struct ScillaArgs;
 class ScillaHelpers final {
  public:
   using Address = dev::h160;
-  /// export files that ExportCreateContractFiles and ExportContractFiles
-  /// both needs
-  static void ExportCommonFiles(
-      const std::vector<uint8_t> &contract_init_data, std::ofstream &os,
-      const std::map<Address, std::pair<std::string, std::string>>
-          &extlibs_exports);
-
+  /// stage the code, init data and extlibs of a contract being deployed
   static bool ExportCreateContractFiles(
       const std::vector<uint8_t> &contract_code,
       const std::vector<uint8_t> &contract_init_data, bool is_library,
       std::string &scilla_root_version, uint32_t scilla_version,
       const std::map<Address, std::pair<std::string, std::string>>
-          &extlibs_exports);
+          &extlibs_exports,
+      ScillaFilePaths &files);
 
-  /// generate the files for initdata, contract state, blocknum for interpreter
-  /// to call contract
+  /// stage the code, init data and extlibs of a deployed contract for the
+  /// interpreter to call it
   static bool ExportContractFiles(
       CpsAccountStoreInterface &acc_store, const Address &contract,
       uint32_t scilla_version,
       const std::map<Address, std::pair<std::string, std::string>>
-          &extlibs_exports);
+          &extlibs_exports,
+      ScillaFilePaths &files);
 
   /// generate the files for message from txn for interpreter to call contract
   static bool ExportCallContractFiles(
@@ -63,21 +60,17 @@ class ScillaHelpers final {
       const Address &contract, const zbytes &data, const Amount &amount,
       uint32_t scilla_version,
       const std::map<Address, std::pair<std::string, std::string>>
-          &extlibs_exports);
+          &extlibs_exports,
+      ScillaFilePaths &files);
 
   /// generate the files for message from previous contract output for
   /// interpreter to call another contract
   static bool ExportCallContractFiles(
       CpsAccountStoreInterface &acc_store, const Address &contract,
       const Json::Value &contractData, uint32_t scilla_version,
-      const std::map<Address, std::pair<std::string, std::string>>
-          &extlibs_exports);
-
-  static void CreateScillaCodeFiles(
-      CpsAccountStoreInterface &acc_store, const Address &contract,
       const std::map<Address, std::pair<std::string, std::string>>
           &extlibs_exports,
-      const std::string &scillaCodeExtension);
+      ScillaFilePaths &files);
 
   static bool ParseContractCheckerOutput(
       CpsAccountStoreInterface &acc_store, const Address &addr,
@@ -160,6 +160,12 @@ class Account : public AccountBase {
 
   const zbytes GetInitData() const;
 
+  /// Returns true if the code or init data is held in memory rather than read
+  /// back from ContractStorage, i.e. it may not have been persisted yet
+  bool HasImmutableCache() const {
+    return !m_codeCache.empty() || !m_initDataCache.empty();
+  }
+
   bool GetContractAuxiliaries(bool& is_library, uint32_t& scilla_version,
                               std::vector<Address>& extlibs);
 
@@ -50,6 +50,8 @@ Transaction::Transaction(const uint32_t &version, const uint64_t &nonce,
                          const zbytes &data)
     : m_coreInfo(version, nonce, toAddr, senderKeyPair.second, amount, gasPrice,
                  gasLimit, code, data, {}, 0, 0) {
+  SetSenderAddr();
+
   zbytes txnData;
   SerializeCoreFields(txnData, 0);
 
@@ -88,7 +90,9 @@ Transaction::Transaction(const TxnHash &tranID, const uint32_t &version,
       m_coreInfo(version, nonce, toAddr, senderPubKey, amount, gasPrice,
                  gasLimit, code, data, {}, 0, 0),
       m_signature(signature),
-      m_signature_validation(0) {}
+      m_signature_validation(0) {
+  SetSenderAddr();
+}
 
 Transaction::Transaction(const uint32_t &version, const uint64_t &nonce,
                          const Address &toAddr, const PubKey &senderPubKey,
@@ -121,6 +125,8 @@ Transaction::Transaction(const uint32_t &version, const uint64_t &nonce,
                  maxFeePerGas),
       m_signature(signature),
       m_signature_validation(signature_validation) {
+  SetSenderAddr();
+
   zbytes txnData;
   SerializeCoreFields(txnData, 0);
 
@@ -129,8 +135,10 @@ Transaction::Transaction(const uint32_t &version, const uint64_t &nonce,
     return;
   }
 
-  // Verify the signature
-  if (!IsSigned(txnData)) {
+  // Verify the signature and remember the outcome, so that later stages
+  // (packet decoding, validator) do not have to check it again
+  m_signatureVerified = IsSigned(txnData);
+  if (!m_signatureVerified) {
     TRACE_ERROR("We failed to verify the input signature! Just a warning...");
   }
 }
@@ -138,7 +146,9 @@ Transaction::Transaction(const uint32_t &version, const uint64_t &nonce,
 Transaction::Transaction(const TxnHash &tranID,
                          const TransactionCoreInfo &coreInfo,
                          const Signature &signature)
-    : m_tranID(tranID), m_coreInfo(coreInfo), m_signature(signature) {}
+    : m_tranID(tranID), m_coreInfo(coreInfo), m_signature(signature) {
+  SetSenderAddr();
+}
 
 bool Transaction::Serialize(zbytes &dst, unsigned int offset) const {
   if (!Messenger::SetTransaction(dst, offset, *this)) {
@@ -197,20 +207,20 @@ const PubKey &Transaction::GetSenderPubKey() const {
   return m_coreInfo.senderPubKey;
 }
 
-Address Transaction::GetSenderAddr() const {
+const Address &Transaction::GetSenderAddr() const { return m_senderAddr; }
+
+void Transaction::SetSenderAddr() {
+  m_isEth = IsEthTransactionVersion(GetVersionIdentifier());
+
   // If a V2 Tx
-  if (IsEth()) {
-    return Account::GetAddressFromPublicKeyEth(GetSenderPubKey());
+  if (m_isEth) {
+    m_senderAddr = Account::GetAddressFromPublicKeyEth(GetSenderPubKey());
+  } else {
+    m_senderAddr = Account::GetAddressFromPublicKey(GetSenderPubKey());
   }
-
-  return Account::GetAddressFromPublicKey(GetSenderPubKey());
 }
 
-bool Transaction::IsEth() const {
-  auto const version = GetVersionIdentifier();
-
-  return IsEthTransactionVersion(version);
-}
+bool Transaction::IsEth() const { return m_isEth; }
 
 const uint128_t &Transaction::GetAmountRaw() const { return m_coreInfo.amount; }
 
@@ -338,11 +348,18 @@ bool Transaction::IsSigned(zbytes const &txnData) const {
   return Schnorr::Verify(txnData, GetSignature(), GetCoreInfo().senderPubKey);
 }
 
+bool Transaction::IsSignatureVerified() const { return m_signatureVerified; }
+
 void Transaction::SetSignature(const Signature &signature) {
   m_signature = signature;
+  m_signatureVerified = false;
 }
 
 bool Transaction::Verify(const Transaction &tran) {
+  if (tran.IsSignatureVerified()) {
+    return true;
+  }
+
   zbytes txnData;
   tran.SerializeCoreFields(txnData, 0);
 
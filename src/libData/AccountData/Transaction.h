@@ -69,9 +69,16 @@ class Transaction : public SerializableDataBlock {
   TransactionCoreInfo m_coreInfo;
   Signature m_signature;
   uint32_t m_signature_validation;
+  bool m_signatureVerified{false};
+
+  // Derived from the core fields once at construction, since the sender
+  // address is needed many times per txn and costs a hash to compute
+  Address m_senderAddr;
+  bool m_isEth{false};
 
   bool IsSignedECDSA() const;
   bool SetHash(const zbytes& txnData);
+  void SetSenderAddr();
 
  public:
   static constexpr auto AVERAGE_TXN_SIZE_BYTES = 192;
@@ -153,6 +160,10 @@ class Transaction : public SerializableDataBlock {
 
   bool IsSigned(zbytes const& txnData) const;
 
+  /// Returns whether the signature has already been checked against the core
+  /// fields, in which case Verify does not check it again.
+  bool IsSignatureVerified() const;
+
   /// Returns the transaction nonce.
   /// There is an edge case for Eth nonces,
   /// See PR #2995
@@ -165,7 +176,7 @@ class Transaction : public SerializableDataBlock {
   const PubKey& GetSenderPubKey() const;
 
   /// Returns the sender's Address
-  Address GetSenderAddr() const;
+  const Address& GetSenderAddr() const;
 
   /// Returns the transaction amount in Qa.
   const uint128_t GetAmountQa() const;
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNMEMPOOL_H_
+#define ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNMEMPOOL_H_
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "Address.h"
+#include "Transaction.h"
+#include "TxnPool.h"
+
+// Txns a lookup has accepted and not yet dispatched to the shards. Arrivals
+// keeps them in the order they came in, which is the order they are sent
+// in; HashIndex and NonceIndex point into it so that duplicates are found
+// without a scan of the pool.
+struct TxnMemPool {
+  struct AddressNonceHash {
+    std::size_t operator()(const std::pair<Address, uint64_t>& p) const {
+      std::size_t seed = std::hash<Address>{}(p.first);
+      boost::hash_combine(seed, p.second);
+      return seed;
+    }
+  };
+
+  using Position = std::list<Transaction>::iterator;
+
+  std::list<Transaction> Arrivals;
+  std::unordered_map<TxnHash, Position> HashIndex;
+  std::unordered_map<std::pair<Address, uint64_t>, Position, AddressNonceHash>
+      NonceIndex;
+
+  void clear() {
+    Arrivals.clear();
+    HashIndex.clear();
+    NonceIndex.clear();
+  }
+
+  bool empty() const { return Arrivals.empty(); }
+
+  std::size_t size() const { return HashIndex.size(); }
+
+  bool exist(const TxnHash& th) const {
+    return HashIndex.find(th) != HashIndex.end();
+  }
+
+  // Adds a txn at the back of the pool. A txn with the same sender and nonce
+  // as a pooled one only gets in with a higher gas price, and then takes its
+  // place in the arrival order; status carries the hash of the txn dropped.
+  bool insert(Transaction t, MempoolInsertionStatus& status) {
+    const TxnHash tranID = t.GetTranID();
+    if (exist(tranID)) {
+      status = {TxnStatus::MEMPOOL_ALREADY_PRESENT, tranID};
+      return false;
+    }
+
+    auto searchNonce = NonceIndex.find({t.GetSenderAddr(), t.GetNonce()});
+    if (searchNonce != NonceIndex.end()) {
+      auto& pooled = *searchNonce->second;
+      if (t.GetGasPriceQa() <= pooled.GetGasPriceQa()) {
+        status = {TxnStatus::MEMPOOL_SAME_NONCE_LOWER_GAS, tranID};
+        return false;
+      }
+
+      status = {TxnStatus::MEMPOOL_SAME_NONCE_LOWER_GAS, pooled.GetTranID()};
+      HashIndex.erase(pooled.GetTranID());
+      pooled = std::move(t);
+      HashIndex.emplace(tranID, searchNonce->second);
+      return true;
+    }
+
+    Arrivals.push_back(std::move(t));
+    auto position = std::prev(Arrivals.end());
+    HashIndex.emplace(tranID, position);
+    NonceIndex.emplace(
+        std::make_pair(position->GetSenderAddr(), position->GetNonce()),
+        position);
+    status = {TxnStatus::NOT_PRESENT, tranID};
+    return true;
+  }
+
+  // Moves every pooled txn out in arrival order and empties the pool.
+  std::vector<Transaction> drain() {
+    std::vector<Transaction> txns;
+    txns.reserve(Arrivals.size());
+    std::move(Arrivals.begin(), Arrivals.end(), std::back_inserter(txns));
+    clear();
+    return txns;
+  }
+};
+
+#endif  // ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNMEMPOOL_H_
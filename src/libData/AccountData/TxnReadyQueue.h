@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNREADYQUEUE_H_
+#define ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNREADYQUEUE_H_
+
+#include <map>
+#include <set>
+#include <utility>
+
+#include "Address.h"
+#include "Transaction.h"
+
+// Holds transactions whose nonce was too high at the time they were picked
+// from the txn pool. Each sender's pending txns are kept ordered by nonce in
+// PendingIndex; a sender is only present in ReadyIndex once its lowest
+// pending nonce is the next one expected by the account store, so picking
+// the next runnable txn never requires a scan across all senders.
+struct TxnReadyQueue {
+  // Higher gas price first, ties broken by sender address so that leader and
+  // backups derive the same order from the same input.
+  struct ReadyOrder {
+    bool operator()(const std::pair<uint128_t, Address>& lhs,
+                    const std::pair<uint128_t, Address>& rhs) const {
+      if (lhs.first != rhs.first) {
+        return lhs.first > rhs.first;
+      }
+      return lhs.second < rhs.second;
+    }
+  };
+
+  std::map<Address, std::map<uint64_t, Transaction>> PendingIndex;
+  std::set<std::pair<uint128_t, Address>, ReadyOrder> ReadyIndex;
+
+  void clear() {
+    PendingIndex.clear();
+    ReadyIndex.clear();
+  }
+
+  bool empty() const { return PendingIndex.empty(); }
+
+  unsigned int size() const {
+    unsigned int count = 0;
+    for (const auto& kv : PendingIndex) {
+      count += kv.second.size();
+    }
+    return count;
+  }
+
+  // Adds a txn for its sender. If a txn with the same sender and nonce is
+  // already queued, the one with the higher gas price is kept.
+  // Returns false if the queued txn was kept instead of t.
+  bool insert(const Transaction& t, const uint128_t& expectedNonce) {
+    const Address& senderAddr = t.GetSenderAddr();
+    auto& nonceTxnMap = PendingIndex[senderAddr];
+
+    auto it = nonceTxnMap.find(t.GetNonce());
+    if (it != nonceTxnMap.end()) {
+      if (t.GetGasPriceQa() <= it->second.GetGasPriceQa()) {
+        return false;
+      }
+      if (it == nonceTxnMap.begin()) {
+        ReadyIndex.erase({it->second.GetGasPriceQa(), senderAddr});
+      }
+      it->second = t;
+    } else {
+      if (!nonceTxnMap.empty() && t.GetNonce() < nonceTxnMap.begin()->first) {
+        ReadyIndex.erase(
+            {nonceTxnMap.begin()->second.GetGasPriceQa(), senderAddr});
+      }
+      nonceTxnMap.emplace(t.GetNonce(), t);
+    }
+
+    promote(senderAddr, expectedNonce);
+    return true;
+  }
+
+  // Marks the sender's lowest pending txn as runnable if its nonce is the
+  // expected one. Must be called whenever the sender's nonce changes.
+  void promote(const Address& senderAddr, const uint128_t& expectedNonce) {
+    auto it = PendingIndex.find(senderAddr);
+    if (it == PendingIndex.end()) {
+      return;
+    }
+    const auto& front = *it->second.begin();
+    if (front.first == expectedNonce) {
+      ReadyIndex.emplace(front.second.GetGasPriceQa(), senderAddr);
+    }
+  }
+
+  // Pops the highest gas price runnable txn. getExpectedNonce is used to
+  // discard entries that became stale since they were promoted.
+  template <typename NonceFunc>
+  bool findOne(Transaction& t, NonceFunc&& getExpectedNonce) {
+    while (!ReadyIndex.empty()) {
+      const Address senderAddr = ReadyIndex.begin()->second;
+      ReadyIndex.erase(ReadyIndex.begin());
+
+      auto it = PendingIndex.find(senderAddr);
+      if (it == PendingIndex.end()) {
+        continue;
+      }
+      auto& nonceTxnMap = it->second;
+      if (nonceTxnMap.begin()->first != getExpectedNonce(senderAddr)) {
+        continue;
+      }
+
+      t = std::move(nonceTxnMap.begin()->second);
+      nonceTxnMap.erase(nonceTxnMap.begin());
+      if (nonceTxnMap.empty()) {
+        PendingIndex.erase(it);
+      }
+      return true;
+    }
+    return false;
+  }
+};
+
+#endif  // ZILLIQA_SRC_LIBDATA_ACCOUNTDATA_TXNREADYQUEUE_H_
@@ -16,7 +16,9 @@
  */
 
 #include <leveldb/db.h>
+#include <future>
 #include <regex>
+#include <thread>
 
 #include "libData/AccountStore/AccountStore.h"
 #include "libData/AccountStore/services/evm/EvmClient.h"
@@ -40,7 +42,9 @@
 #include "libScilla/ScillaIPCServer.h"
 #include "libScilla/ScillaUtils.h"
 #include "libScilla/UnixDomainSocketServer.h"
+#include "libUtils/DataConversion.h"
 #include "libUtils/EvmUtils.h"
+#include "libUtils/SafeMath.h"
 #include "libUtils/SysCommand.h"
 
 using namespace std;
@@ -161,6 +165,7 @@ void AccountStore::InitSoft() {
   unique_lock<shared_timed_mutex> g(m_mutexPrimary);
 
   AccountStoreBase::Init();
+  m_dirtyContracts.clear();
   InitTrie();
 
   InitRevertibles();
@@ -173,13 +178,23 @@ Account *AccountStore::GetAccount(const Address &address) {
 }
 
 Account *AccountStore::GetAccount(const Address &address, bool resetRoot) {
-  using namespace boost::multiprecision;
-
   Account *account = AccountStoreBase::GetAccount(address);
   if (account != nullptr) {
     return account;
   }
 
+  Account loaded;
+  if (!LoadAccountFromTrie(address, resetRoot, loaded)) {
+    return nullptr;
+  }
+
+  auto it2 = this->m_addressToAccount->emplace(address, std::move(loaded));
+
+  return &it2.first->second;
+}
+
+bool AccountStore::LoadAccountFromTrie(const Address &address, bool resetRoot,
+                                       Account &account) {
   std::string rawAccountBase;
 
   {
@@ -197,7 +212,7 @@ Account *AccountStore::GetAccount(const Address &address, bool resetRoot) {
         } catch (std::exception &e) {
           LOG_GENERAL(WARNING, "setRoot for " << m_prevRoot.hex() << " failed, "
                                               << e.what());
-          return nullptr;
+          return false;
         }
       }
     } else {
@@ -206,26 +221,42 @@ Account *AccountStore::GetAccount(const Address &address, bool resetRoot) {
     }
   }
   if (rawAccountBase.empty()) {
-    return nullptr;
+    return false;
   }
 
-  account = new Account();
-  if (!account->DeserializeBase(
+  Account loaded;
+  if (!loaded.DeserializeBase(
           zbytes(rawAccountBase.begin(), rawAccountBase.end()), 0)) {
     LOG_GENERAL(WARNING, "Account::DeserializeBase failed");
-    delete account;
-    return nullptr;
+    return false;
   }
 
-  if (account->isContract()) {
-    account->SetAddress(address);
+  if (loaded.isContract()) {
+    loaded.SetAddress(address);
   }
 
-  auto it2 = this->m_addressToAccount->emplace(address, *account);
+  account = std::move(loaded);
+  return true;
+}
+
+bool AccountStore::PeekAccount(const Address &address, bool temp,
+                               Account &account) {
+  if (temp) {
+    const auto &tempAccounts = m_accountStoreTemp.GetAddressToAccount();
+    auto it = tempAccounts->find(address);
+    if (it != tempAccounts->end()) {
+      account = it->second;
+      return true;
+    }
+  }
 
-  delete account;
+  auto it = m_addressToAccount->find(address);
+  if (it != m_addressToAccount->end()) {
+    account = it->second;
+    return true;
+  }
 
-  return &it2.first->second;
+  return LoadAccountFromTrie(address, false, account);
 }
 
 bool AccountStore::RefreshDB() {
@@ -399,36 +430,67 @@ bool AccountStore::MoveRootToDisk(const dev::h256 &root) {
 bool AccountStore::MoveUpdatesToDisk(uint64_t dsBlockNum) {
   LOG_MARKER();
 
-  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
-  unique_lock<mutex> g2(m_mutexDB, defer_lock);
-  lock(g, g2);
+  lock_guard<mutex> flushGuard(m_mutexFlush);
 
   unordered_map<string, string> code_batch;
   unordered_map<string, string> initdata_batch;
+  unordered_set<Address> flushed;
 
-  for (const auto &i : *m_addressToAccount) {
-    if (i.second.isContract() || i.second.IsLibrary()) {
-      if (ContractStorage::GetContractStorage()
-              .GetContractCode(i.first)
-              .empty()) {
-        code_batch.insert({i.first.hex(), DataConversion::CharArrayToString(
-                                              i.second.GetCode())});
-      }
+  // Snapshot the code and init data of new contracts; only this part needs
+  // the primary states held exclusively
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexPrimary);
 
-      if (ContractStorage::GetContractStorage().GetInitData(i.first).empty()) {
-        initdata_batch.insert({i.first.hex(), DataConversion::CharArrayToString(
-                                                  i.second.GetInitData())});
+    flushed.swap(m_dirtyContracts);
+    for (auto it = flushed.begin(); it != flushed.end();) {
+      auto acc = m_addressToAccount->find(*it);
+      if (acc == m_addressToAccount->end() ||
+          !(acc->second.isContract() || acc->second.IsLibrary())) {
+        it = flushed.erase(it);
+        continue;
       }
+      code_batch.emplace(it->hex(), DataConversion::CharArrayToString(
+                                        acc->second.GetCode()));
+      initdata_batch.emplace(it->hex(), DataConversion::CharArrayToString(
+                                            acc->second.GetInitData()));
+      ++it;
+    }
+  }
+
+  // Code and init data are immutable, never overwrite what is on disk
+  for (auto it = code_batch.begin(); it != code_batch.end();) {
+    if (!ContractStorage::GetContractStorage()
+             .GetContractCode(h160(it->first))
+             .empty()) {
+      it = code_batch.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = initdata_batch.begin(); it != initdata_batch.end();) {
+    if (!ContractStorage::GetContractStorage()
+             .GetInitData(h160(it->first))
+             .empty()) {
+      it = initdata_batch.erase(it);
+    } else {
+      ++it;
     }
   }
 
+  auto restoreDirty = [this, &flushed]() {
+    unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+    m_dirtyContracts.insert(flushed.begin(), flushed.end());
+  };
+
   if (!ContractStorage::GetContractStorage().PutContractCodeBatch(code_batch)) {
     LOG_GENERAL(WARNING, "PutContractCodeBatch failed");
+    restoreDirty();
     return false;
   }
 
   if (!ContractStorage::GetContractStorage().PutInitDataBatch(initdata_batch)) {
     LOG_GENERAL(WARNING, "PutInitDataBatch failed");
+    restoreDirty();
     return false;
   }
 
@@ -450,10 +512,13 @@ bool AccountStore::MoveUpdatesToDisk(uint64_t dsBlockNum) {
         LOG_GENERAL(WARNING, "Failed to delete contract code for " << it.first);
       }
     }
+    restoreDirty();
   }
 
   try {
-    lock_guard<mutex> g(m_mutexTrie);
+    std::lock(m_mutexTrie, m_mutexDB);
+    std::lock_guard<std::mutex> lock1(m_mutexTrie, std::adopt_lock);
+    std::lock_guard<std::mutex> lock2(m_mutexDB, std::adopt_lock);
     if (!m_state.db()->commit(dsBlockNum)) {
       LOG_GENERAL(WARNING, "LevelDB commit failed");
     }
@@ -468,7 +533,23 @@ bool AccountStore::MoveUpdatesToDisk(uint64_t dsBlockNum) {
     return false;
   }
 
-  m_addressToAccount->clear();
+  // Everything is now readable back from disk, except contracts that were
+  // created while the lock was released
+  {
+    unique_lock<shared_timed_mutex> g(m_mutexPrimary);
+    if (m_dirtyContracts.empty()) {
+      m_addressToAccount->clear();
+    } else {
+      for (auto it = m_addressToAccount->begin();
+           it != m_addressToAccount->end();) {
+        if (m_dirtyContracts.find(it->first) == m_dirtyContracts.end()) {
+          it = m_addressToAccount->erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
 
   return true;
 }
@@ -648,6 +729,133 @@ bool AccountStore::UpdateAccountsTemp(
   return status;
 }
 
+void AccountStore::SpeculateTransfersTemp(
+    const uint64_t &blockNum, std::vector<SpeculativeTransfer> &transfers) {
+  static const unsigned int MIN_TRANSFERS_PER_THREAD = 32;
+
+  // The workers read the primary and temp maps without further locking, so
+  // nothing else may modify them until all transfers are done
+  unique_lock<shared_timed_mutex> g(m_mutexPrimary, defer_lock);
+  unique_lock<mutex> g2(m_mutexDelta, defer_lock);
+  lock(g, g2);
+
+  const size_t count = transfers.size();
+  const size_t numThreads =
+      min<size_t>(max(1U, thread::hardware_concurrency()),
+                  (count + MIN_TRANSFERS_PER_THREAD - 1) /
+                      MIN_TRANSFERS_PER_THREAD);
+
+  if (numThreads <= 1) {
+    for (auto &transfer : transfers) {
+      SpeculateTransfer(blockNum, transfer);
+    }
+    return;
+  }
+
+  vector<future<void>> workers;
+  workers.reserve(numThreads);
+
+  const size_t chunkSize = (count + numThreads - 1) / numThreads;
+  for (size_t begin = 0; begin < count; begin += chunkSize) {
+    const size_t end = min(begin + chunkSize, count);
+    workers.emplace_back(
+        async(launch::async, [this, &blockNum, &transfers, begin, end]() {
+          for (size_t i = begin; i < end; ++i) {
+            SpeculateTransfer(blockNum, transfers[i]);
+          }
+        }));
+  }
+
+  for (auto &worker : workers) {
+    worker.get();
+  }
+}
+
+void AccountStore::SpeculateTransfer(const uint64_t &blockNum,
+                                     SpeculativeTransfer &transfer) {
+  const Transaction &tx = transfer.transaction;
+  const Address &fromAddr = tx.GetSenderAddr();
+  const Address &toAddr = tx.GetToAddr();
+  const uint128_t &amount = tx.GetAmountQa();
+
+  transfer.clean = false;
+  transfer.hasRecipient = false;
+  transfer.contractRecipient = false;
+
+  // Checks of Validator::CheckCreatedTransaction, against the primary state
+  if (DataConversion::UnpackA(tx.GetVersion()) != CHAIN_ID ||
+      !tx.VersionCorrect() || IsNullAddress(fromAddr)) {
+    return;
+  }
+  Account primarySender;
+  if (!PeekAccount(fromAddr, false, primarySender) ||
+      primarySender.GetBalance() < amount) {
+    return;
+  }
+
+  // Checks of the transfer itself, against the temp state
+  if (!PeekAccount(fromAddr, true, transfer.sender)) {
+    return;
+  }
+  transfer.hasRecipient = PeekAccount(toAddr, true, transfer.recipient);
+  if (transfer.hasRecipient && transfer.recipient.isContract()) {
+    transfer.contractRecipient = true;
+    return;
+  }
+
+  uint128_t gasDeposit;
+  uint128_t totalCost;
+  uint128_t gasRefund;
+  if (!SafeMath<uint128_t>::mul(tx.GetGasLimitZil(), tx.GetGasPriceQa(),
+                                gasDeposit) ||
+      !SafeMath<uint128_t>::add(gasDeposit, amount, totalCost) ||
+      transfer.sender.GetBalance() < totalCost ||
+      !CalculateGasRefund(gasDeposit, NORMAL_TRAN_GAS, tx.GetGasPriceQa(),
+                          gasRefund)) {
+    return;
+  }
+
+  // Same account updates as AccountStoreBase::UpdateAccounts, which the CPS
+  // transfer path ends up with as well
+  if (!transfer.sender.DecreaseBalance(gasDeposit) ||
+      !transfer.sender.DecreaseBalance(amount)) {
+    return;
+  }
+  if (amount > 0) {
+    if (transfer.hasRecipient) {
+      if (!transfer.recipient.IncreaseBalance(amount)) {
+        return;
+      }
+    } else {
+      transfer.recipient = Account(amount, 0);
+      transfer.hasRecipient = true;
+    }
+  }
+  if (!transfer.sender.IncreaseBalance(gasRefund) ||
+      !transfer.sender.IncreaseNonce()) {
+    return;
+  }
+
+  transfer.receipt.SetEpochNum(blockNum);
+  transfer.receipt.SetResult(true);
+  transfer.receipt.SetCumGas(NORMAL_TRAN_GAS);
+  transfer.receipt.update();
+
+  transfer.clean = true;
+}
+
+void AccountStore::CommitSpeculativeTransferTemp(
+    const SpeculativeTransfer &transfer) {
+  lock_guard<mutex> g(m_mutexDelta);
+
+  m_accountStoreTemp.AddAccount(transfer.transaction.GetSenderAddr(),
+                                transfer.sender, true);
+  if (transfer.hasRecipient) {
+    m_accountStoreTemp.AddAccount(transfer.transaction.GetToAddr(),
+                                  transfer.recipient, true);
+  }
+}
+
 bool AccountStore::UpdateCoinbaseTemp(const Address &rewardee,
                                       const Address &genesisAddress,
                                       const uint128_t &amount) {
@@ -23,6 +23,8 @@
 #include <set>
 #include <shared_mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <Schnorr.h>
 #include "AccountStoreBase.h"
@@ -35,6 +37,7 @@
 #include "libData/AccountData/TransactionReceipt.h"
 #include "libData/AccountStore/AccountStoreSC.h"
 #include "libData/AccountStore/AccountStoreTemp.h"
+#include "libData/AccountStore/SpeculativeTransfer.h"
 #include "libData/DataStructures/TraceableDB.h"
 #include "libScilla/UnixDomainSocketServer.h"
 #include "libUtils/TxnExtras.h"
@@ -70,6 +73,12 @@ class AccountStore : public AccountStoreBase {
   /// buffer for the raw bytes of state delta serialized
   zbytes m_stateDeltaSerialized;
 
+  /// contracts and libraries in m_addressToAccount whose code and init data
+  /// may not be on disk yet (protected by m_mutexPrimary)
+  std::unordered_set<Address> m_dirtyContracts;
+  /// serializes MoveUpdatesToDisk, which releases m_mutexPrimary while writing
+  std::mutex m_mutexFlush;
+
   /// Scilla IPC server related
   std::shared_ptr<ScillaIPCServer> m_scillaIPCServer;
 
@@ -85,6 +94,27 @@ class AccountStore : public AccountStoreBase {
   bool UpdateStateTrie(const Address& address, const Account& account);
   bool RemoveFromTrie(const Address& address);
 
+  /// Read an account from the state trie without caching it
+  bool LoadAccountFromTrie(const Address& address, bool resetRoot,
+                           Account& account);
+
+  /// Copy an account from the temp (if requested) or primary state without
+  /// caching it, so that several threads may call this at once while the
+  /// primary and delta mutexes are held
+  bool PeekAccount(const Address& address, bool temp, Account& account);
+
+  void SpeculateTransfer(const uint64_t& blockNum,
+                         SpeculativeTransfer& transfer);
+
+  /// Remember a contract whose code and init data have to be written out on
+  /// the next MoveUpdatesToDisk
+  void MarkContractDirty(const Address& address, const Account& account) {
+    if ((account.isContract() || account.IsLibrary()) &&
+        account.HasImmutableCache()) {
+      m_dirtyContracts.emplace(address);
+    }
+  }
+
  public:
   /// Returns the singleton AccountStore instance.
   static AccountStore& GetInstance();
@@ -123,6 +153,19 @@ class AccountStore : public AccountStoreBase {
   /// commit the in-memory states into persistent storage
   bool MoveUpdatesToDisk(uint64_t dsBlockNum = 0);
 
+  /// Adds an Account to the primary states, tracking new contract code
+  bool AddAccount(const Address& address, const Account& account,
+                  bool toReplace = false) {
+    if (!AccountStoreBase::AddAccount(address, account, toReplace)) {
+      return false;
+    }
+    MarkContractDirty(address, account);
+    return true;
+  }
+  bool AddAccount(const PubKey& pubKey, const Account& account) {
+    return AddAccount(Account::GetAddressFromPublicKey(pubKey), account);
+  }
+
   /// repopulate the in-memory data structures from persistent storage
   bool RetrieveFromDisk();
 
@@ -143,6 +186,14 @@ class AccountStore : public AccountStoreBase {
                           const TxnExtras& txnExtras,
                           TransactionReceipt& receipt, TxnStatus& error_code);
 
+  /// run plain transfers touching pairwise disjoint accounts on worker
+  /// threads, without writing to AccountStoreTemp
+  void SpeculateTransfersTemp(const uint64_t& blockNum,
+                              std::vector<SpeculativeTransfer>& transfers);
+
+  /// apply the result of a clean speculative transfer to AccountStoreTemp
+  void CommitSpeculativeTransferTemp(const SpeculativeTransfer& transfer);
+
   /// add account in AccountStoreTemp
   void AddAccountTemp(const Address& address, const Account& account) {
     std::lock_guard<std::mutex> g(m_mutexDelta);
@@ -187,6 +238,7 @@ class AccountStore : public AccountStoreBase {
                                        const bool fullCopy = false,
                                        const bool revertible = false) {
     m_addressToAccount->insert_or_assign(address, account);
+    MarkContractDirty(address, account);
 
     if (revertible) {
       if (fullCopy) {
@@ -71,8 +71,7 @@ void AccountStoreSC::EvmCallRunner(const INVOKE_TYPE /*invoke_type*/,  //
     try {
       auto span = Tracing::CreateChildSpanOfRemoteTrace(
           FilterClass::FILTER_CLASS_ALL, "EvmCallRunner", trace_info);
-      ret = EvmClient::GetInstance().CallRunner(EvmUtils::GetEvmCallJson(args),
-                                                result);
+      ret = EvmClient::GetInstance().CallRunner(args, result);
     } catch (std::exception &e) {
       std::stringstream ss;
       ss << "Exception from underlying RPC call " << e.what();
@@ -346,8 +345,8 @@ bool AccountStoreSC::UpdateAccountsEvm(const uint64_t &blockNum,
   // eth_call in non-cps mode only
   if (!ENABLE_CPS && evmContext.GetDirect()) {
     evm::EvmResult res;
-    bool status = EvmClient::GetInstance().CallRunner(
-        EvmUtils::GetEvmCallJson(evmContext.GetEvmArgs()), res);
+    bool status =
+        EvmClient::GetInstance().CallRunner(evmContext.GetEvmArgs(), res);
     evmContext.SetEvmResult(res);
     return status;
   }
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBDATA_ACCOUNTSTORE_SPECULATIVETRANSFER_H_
+#define ZILLIQA_SRC_LIBDATA_ACCOUNTSTORE_SPECULATIVETRANSFER_H_
+
+#include "common/Constants.h"
+#include "libData/AccountData/Account.h"
+#include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TransactionReceipt.h"
+
+// A plain ZIL transfer executed off the temp state against copies of the
+// accounts it reads (its read/write set). Only transfers that would succeed
+// are marked clean and applied; anything else is left for the serial path to
+// execute so that failures are reported exactly as before.
+struct SpeculativeTransfer {
+  Transaction transaction;
+  TransactionReceipt receipt;
+  Account sender;
+  Account recipient;
+  bool hasRecipient{false};
+  // Set if the recipient turned out to be a contract, in which case the
+  // serial path may run code touching any account
+  bool contractRecipient{false};
+  bool clean{false};
+
+  SpeculativeTransfer() = default;
+  explicit SpeculativeTransfer(const Transaction& tx) : transaction(tx) {}
+
+  // Whether the txn can be run speculatively at all, judged on the txn alone.
+  // EVM txns, contract txns and self transfers always take the serial path.
+  static bool IsCandidate(const Transaction& tx) {
+    if (LOOKUP_NODE_MODE || ARCHIVAL_LOOKUP_WITH_TX_TRACES) {
+      return false;
+    }
+    return Transaction::GetTransactionType(tx) == Transaction::NON_CONTRACT &&
+           !tx.IsEth() && tx.GetGasLimitZil() >= NORMAL_TRAN_GAS &&
+           tx.GetSenderAddr() != tx.GetToAddr();
+  }
+};
+
+#endif  // ZILLIQA_SRC_LIBDATA_ACCOUNTSTORE_SPECULATIVETRANSFER_H_
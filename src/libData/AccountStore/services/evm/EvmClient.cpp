@@ -35,15 +35,32 @@ Z_I64METRIC& GetCallsCounter() {
 }
 
 const std::vector<std::string>& GetEvmDaemonArgs() {
-  static const std::vector<std::string> args = {"--socket",
-    EVM_SERVER_SOCKET_PATH,
-    "--zil-scaling-factor",
-    std::to_string(EVM_ZIL_SCALING_FACTOR),
-    "--log4rs",
-    EVM_LOG_CONFIG};
+  static const std::vector<std::string> args = [] {
+    std::vector<std::string> args = {"--socket",
+      EVM_SERVER_SOCKET_PATH,
+      "--zil-scaling-factor",
+      std::to_string(EVM_ZIL_SCALING_FACTOR),
+      "--log4rs",
+      EVM_LOG_CONFIG};
+    if (EVM_FRAMED_TRANSPORT) {
+      args.emplace_back("--framed-socket");
+      args.emplace_back(EVM_SERVER_FRAMED_SOCKET_PATH);
+    }
+    return args;
+  }();
   return args;
 }
 
+void RemoveStaleSocket(const std::filesystem::path& socket_path) {
+  std::error_code ec;
+  if (std::filesystem::exists(socket_path)) {
+    std::filesystem::remove(socket_path, ec);
+    if (ec) {
+      TRACE_ERROR("Problem removing filesystem entry for socket ");
+    }
+  }
+}
+
 bool LaunchEvmDaemon(boost::process::child& child,
                      const std::string& binaryPath,
                      const std::string& socketPath) {
@@ -55,13 +72,11 @@ bool LaunchEvmDaemon(boost::process::child& child,
   const std::vector<std::string>& args = GetEvmDaemonArgs();
   std::filesystem::path bin_path(binaryPath);
   std::filesystem::path socket_path(socketPath);
-  boost::system::error_code ec;
+  std::filesystem::path framed_socket_path(EVM_SERVER_FRAMED_SOCKET_PATH);
 
-  if (std::filesystem::exists(socket_path)) {
-    std::filesystem::remove(socket_path, ec);
-    if (ec.failed()) {
-      TRACE_ERROR("Problem removing filesystem entry for socket ");
-    }
+  RemoveStaleSocket(socket_path);
+  if (EVM_FRAMED_TRANSPORT) {
+    RemoveStaleSocket(framed_socket_path);
   }
   if (not std::filesystem::exists(bin_path)) {
     TRACE_ERROR("Cannot create a subprocess that does not exist " +
@@ -81,7 +96,9 @@ bool LaunchEvmDaemon(boost::process::child& child,
     return false;
   }
   int counter{0};
-  while (not std::filesystem::exists(socket_path)) {
+  while (not std::filesystem::exists(socket_path) ||
+         (EVM_FRAMED_TRANSPORT &&
+          not std::filesystem::exists(framed_socket_path))) {
     if ((counter++ % 10) == 0)
       LOG_GENERAL(WARNING, "Awaiting Launch of the evm-ds daemon ");
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -171,6 +188,10 @@ bool EvmClient::OpenServer() {
         std::make_unique<rpc::UnixDomainSocketClient>(EVM_SERVER_SOCKET_PATH);
     m_client = std::make_unique<jsonrpc::Client>(*m_connector,
                                                  jsonrpc::JSONRPC_CLIENT_V2);
+    if (EVM_FRAMED_TRANSPORT) {
+      m_framedConnector = std::make_unique<rpc::UnixDomainSocketFramedClient>(
+          EVM_SERVER_FRAMED_SOCKET_PATH);
+    }
   } catch (...) {
     TRACE_ERROR("Unhandled Exception initialising client");
     GetCallsCounter().IncrementAttr(
@@ -215,3 +236,45 @@ bool EvmClient::CallRunner(const Json::Value& _json, evm::EvmResult& result) {
     return false;
   }
 }
+
+bool EvmClient::CallRunner(const evm::EvmArgs& args, evm::EvmResult& result) {
+  if (!EVM_FRAMED_TRANSPORT) {
+    return CallRunner(EvmUtils::GetEvmCallJson(args), result);
+  }
+
+  LOG_MARKER();
+  TRACE(zil::trace::FilterClass::DEMO);
+
+  std::string request;
+  if (!EvmUtils::GetEvmCallFrame(args, request)) {
+    TRACE_ERROR("Failed to serialize evm args");
+    return false;
+  }
+
+  std::lock_guard<std::mutex> g(m_mutexMain);
+
+  if ((LAUNCH_EVM_DAEMON && not m_child.running()) || not m_framedConnector) {
+    if (not EvmClient::OpenServer()) {
+      TRACE_ERROR("Failed to establish connection to evmd-ds");
+      return false;
+    }
+  }
+
+  std::string response;
+  if (!m_framedConnector->Call(request, response)) {
+    TRACE_ERROR("Exception caught executing run ");
+    return false;
+  }
+
+  if (!result.ParseFromString(response)) {
+    TRACE_ERROR("Cannot parse EVM result protobuf");
+    return false;
+  }
+
+  if (LOG_SC) {
+    LOG_GENERAL(INFO, "<============ Call EVM result: ");
+    EvmUtils::PrintDebugEvmResult(result);
+  }
+
+  return true;
+}
@@ -25,6 +25,7 @@
 #include "common/Constants.h"
 #include "common/Singleton.h"
 #include "libScilla/UnixDomainSocketClient.h"
+#include "libScilla/UnixDomainSocketFramedClient.h"
 #include "libUtils/Evm.pb.h"
 #include "libUtils/Logger.h"
 
@@ -61,6 +62,11 @@ class EvmClient : public Singleton<EvmClient> {
 
   virtual bool CallRunner(const Json::Value& _json, evm::EvmResult& result);
 
+  // Runs args on the evm-ds, over the framed protobuf socket when
+  // EVM_FRAMED_TRANSPORT is set, else over jsonrpc as above.
+
+  virtual bool CallRunner(const evm::EvmArgs& args, evm::EvmResult& result);
+
  protected:
   // OpenServer
   //
@@ -70,6 +76,7 @@ class EvmClient : public Singleton<EvmClient> {
  private:
   std::unique_ptr<jsonrpc::Client> m_client;
   std::unique_ptr<rpc::UnixDomainSocketClient> m_connector;
+  std::unique_ptr<rpc::UnixDomainSocketFramedClient> m_framedConnector;
   boost::process::child m_child;
   // In case we need to protect unsafe code in future.
   std::mutex m_mutexMain;
@@ -18,7 +18,10 @@
 #ifndef ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_BLOCKCHAIN_H_
 #define ZILLIQA_SRC_LIBDATA_BLOCKCHAINDATA_BLOCKCHAIN_H_
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <type_traits>
 
 #include <boost/compute/detail/lru_cache.hpp>
@@ -29,11 +32,52 @@
 
 /// Transient storage for DS/Tx/ Blocks. The block should have function
 /// .GetHeader().GetBlockNum()
+///
+/// Blocks are immutable once added and shared with readers, so the pointer
+/// returning getters hand out a block without copying it. Readers of the
+/// array share m_mutexBlocks; the last block is also published through an
+/// atomic pointer so that GetLastBlock does not lock at all.
 template <class T>
 class BlockChain {
-  std::mutex m_mutexBlocks;
-  CircularArray<T> m_blocks;
-  boost::compute::detail::lru_cache<dev::h256, T> m_lru_blocks;
+ public:
+  using BlockPtr = std::shared_ptr<const T>;
+
+ private:
+  std::shared_mutex m_mutexBlocks;
+  CircularArray<BlockPtr> m_blocks;
+  std::atomic<BlockPtr> m_lastBlock;
+
+  // lru_cache::get updates the recency order, so it is not a read
+  std::mutex m_mutexLruBlocks;
+  boost::compute::detail::lru_cache<dev::h256, BlockPtr> m_lru_blocks;
+
+  /// Placeholder in slots no block was added to, and returned for blocks
+  /// that are not known
+  static const BlockPtr& EmptyBlock() {
+    static const BlockPtr emptyBlock = std::make_shared<const T>();
+    return emptyBlock;
+  }
+
+  /// Requires m_mutexBlocks.
+  bool IsPastLastBlock(const uint64_t& blockNum) {
+    if (m_blocks.size() > 0 &&
+        (m_blocks.back()->GetHeader().GetBlockNum() < blockNum)) {
+      LOG_GENERAL(WARNING,
+                  "BlockNum too high " << blockNum << " Dummy block used");
+      return true;
+    }
+    return false;
+  }
+
+  /// Looks up blockNum in the array, or returns nullptr if it is not there
+  /// and should be read from persistent storage. Requires m_mutexBlocks.
+  BlockPtr FindBlock(const uint64_t& blockNum) {
+    if (blockNum + m_blocks.capacity() < m_blocks.size() ||
+        m_blocks[blockNum]->GetHeader().GetBlockNum() != blockNum) {
+      return nullptr;
+    }
+    return m_blocks[blockNum];
+  }
 
  protected:
   /// Constructor.
@@ -50,87 +94,104 @@ class BlockChain {
  public:
   /// Reset
   void Reset() {
-    m_blocks.resize(BLOCKCHAIN_SIZE);
+    {
+      std::unique_lock<std::shared_mutex> g(m_mutexBlocks);
+      m_blocks.resize(BLOCKCHAIN_SIZE);
+      for (uint64_t i = 0; i < m_blocks.capacity(); i++) {
+        m_blocks[i] = EmptyBlock();
+      }
+      m_lastBlock = EmptyBlock();
+    }
+    std::lock_guard<std::mutex> g(m_mutexLruBlocks);
     m_lru_blocks.clear();
   }
 
   /// Returns the number of blocks.
   uint64_t GetBlockCount() {
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
+    std::shared_lock<std::shared_mutex> g(m_mutexBlocks);
     return m_blocks.size();
   }
 
   /// Returns the last stored block.
-  const T& GetLastBlock() {
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
-    try {
-      return m_blocks.back();
-    } catch (...) {
-      static T defaultBlock;
-      return defaultBlock;
+  BlockPtr GetLastBlockPtr() const { return m_lastBlock.load(); }
+
+  /// Returns the last stored block. Only safe within the full-expression of
+  /// the call, as Reset or added blocks may free it right after; bind
+  /// GetLastBlockPtr instead to keep the block.
+  const T& GetLastBlock() const { return *m_lastBlock.load(); }
+
+  /// Returns the block at the specified block number, or an empty block.
+  BlockPtr GetBlockPtr(const uint64_t& blockNum) {
+    {
+      std::shared_lock<std::shared_mutex> g(m_mutexBlocks);
+      if (IsPastLastBlock(blockNum)) {
+        return EmptyBlock();
+      }
+      auto block = FindBlock(blockNum);
+      if (block) {
+        return block;
+      }
     }
+    return std::make_shared<const T>(GetBlockFromPersistentStorage(blockNum));
   }
 
   // Get this block or return empty.
   std::optional<T> MaybeGetBlock(const uint64_t& blockNum) {
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
-
-    if (m_blocks.size() > 0 &&
-        (m_blocks.back().GetHeader().GetBlockNum() < blockNum)) {
-      LOG_GENERAL(WARNING,
-                  "BlockNum too high " << blockNum << " Dummy block used");
-      return {};
-    } else if (blockNum + m_blocks.capacity() < m_blocks.size() ||
-               m_blocks[blockNum].GetHeader().GetBlockNum() != blockNum) {
-      return GetBlockFromPersistentStorage(blockNum);
-    } else {
-      return m_blocks[blockNum];
+    {
+      std::shared_lock<std::shared_mutex> g(m_mutexBlocks);
+      if (IsPastLastBlock(blockNum)) {
+        return {};
+      }
+      auto block = FindBlock(blockNum);
+      if (block) {
+        return *block;
+      }
     }
+    return GetBlockFromPersistentStorage(blockNum);
   }
 
   /// Returns the block at the specified block number.
-  T GetBlock(const uint64_t& blockNum) {
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
+  T GetBlock(const uint64_t& blockNum) { return *GetBlockPtr(blockNum); }
 
-    if (m_blocks.size() > 0 &&
-        (m_blocks.back().GetHeader().GetBlockNum() < blockNum)) {
-      LOG_GENERAL(WARNING,
-                  "BlockNum too high " << blockNum << " Dummy block used");
-      return T();
-    } else if (blockNum + m_blocks.capacity() < m_blocks.size() ||
-               m_blocks[blockNum].GetHeader().GetBlockNum() != blockNum) {
-      return GetBlockFromPersistentStorage(blockNum);
-    } else {
-      return m_blocks[blockNum];
+  // This is only allowed for TxBlocks. Otherwise trigger compilation error
+  template <class U = T, typename std::enable_if<
+                             std::is_same<U, TxBlock>::value>::type* = nullptr>
+  BlockPtr GetBlockPtrByHash(const dev::h256& blockHash) {
+    {
+      std::lock_guard<std::mutex> g(m_mutexLruBlocks);
+      const auto block = m_lru_blocks.get(blockHash);
+      if (block) {
+        return *block;
+      }
     }
+    return std::make_shared<const T>(GetBlockFromPersistentStorage(blockHash));
   }
 
-  // This is only allowed for TxBlocks. Otherwise trigger compilation error
   template <class U = T, typename std::enable_if<
                              std::is_same<U, TxBlock>::value>::type* = nullptr>
   T GetBlockByHash(const dev::h256& blockHash) {
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
-    const auto block = m_lru_blocks.get(blockHash);
-    if (!block) {
-      return GetBlockFromPersistentStorage(blockHash);
-    }
-    return *block;
+    return *GetBlockPtrByHash(blockHash);
   }
 
   /// Adds a block to the chain.
   int AddBlock(const T& block) {
-    uint64_t blockNumOfNewBlock = block.GetHeader().GetBlockNum();
+    return AddBlock(std::make_shared<const T>(block));
+  }
 
-    std::lock_guard<std::mutex> g(m_mutexBlocks);
+  /// Adds a block to the chain without copying it.
+  int AddBlock(BlockPtr block) {
+    uint64_t blockNumOfNewBlock = block->GetHeader().GetBlockNum();
+
+    std::unique_lock<std::shared_mutex> g(m_mutexBlocks);
 
     uint64_t blockNumOfExistingBlock =
-        m_blocks[blockNumOfNewBlock].GetHeader().GetBlockNum();
+        m_blocks[blockNumOfNewBlock]->GetHeader().GetBlockNum();
 
     if (blockNumOfExistingBlock < blockNumOfNewBlock ||
         INIT_BLOCK_NUMBER == blockNumOfExistingBlock) {
       if (m_blocks.size() > 0) {
         uint64_t blockNumOfLastBlock =
-            m_blocks.back().GetHeader().GetBlockNum();
+            m_blocks.back()->GetHeader().GetBlockNum();
         uint64_t blockNumMissed = blockNumOfNewBlock - blockNumOfLastBlock - 1;
         if (blockNumMissed > 0) {
           LOG_GENERAL(INFO,
@@ -143,7 +204,10 @@ class BlockChain {
         m_blocks.increase_size(blockNumOfNewBlock);
       }
       m_blocks.insert_new(blockNumOfNewBlock, block);
-      m_lru_blocks.insert(block.GetBlockHash(), block);
+      m_lastBlock = block;
+
+      std::lock_guard<std::mutex> lruGuard(m_mutexLruBlocks);
+      m_lru_blocks.insert(block->GetBlockHash(), std::move(block));
     } else {
       LOG_GENERAL(WARNING, "Failed to add " << blockNumOfNewBlock << " "
                                             << blockNumOfExistingBlock);
@@ -15,41 +15,174 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+#include <map>
+#include <sstream>
+
 #include "libData/DataStructures/TraceableDB.h"
-#include "libUtils/DetachedFunction.h"
+#include "libMetrics/Api.h"
+#include "libUtils/Logger.h"
+#include "libUtils/SetThreadName.h"
 
 using namespace std;
 
-bool TraceableDB::commit(const uint64_t& dsBlockNum) {
-  std::vector<dev::h256> toPurge;
-  unordered_set<dev::h256> inserted;
-  if (!OverlayDB::commit(KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE, toPurge,
-                         inserted)) {
-    LOG_GENERAL(WARNING, "OverlayDB::commit failed");
-    return false;
+namespace {
+
+Z_I64METRIC& GetPurgedKeysCounter() {
+  static Z_I64METRIC counter{Z_FL::STATE_PURGE, "state.purge.keys",
+                             "Trie nodes deleted by the state purge", "keys"};
+  return counter;
+}
+
+/// Reports the pending purge backlog of every live TraceableDB
+class PurgeBacklogGauge {
+  struct Backlog {
+    std::string name;
+    const std::atomic<int64_t>* entries;
+    const std::atomic<int64_t>* keys;
+  };
+
+  std::mutex m_mutex;
+  std::map<const void*, Backlog> m_dbs;
+  std::unique_ptr<Z_I64GAUGE> m_gauge;
+
+ public:
+  void Register(const void* db, const std::string& name,
+                const std::atomic<int64_t>& entries,
+                const std::atomic<int64_t>& keys) {
+    lock_guard<mutex> g(m_mutex);
+    if (!m_gauge) {
+      m_gauge = make_unique<Z_I64GAUGE>(Z_FL::STATE_PURGE, "state.purge.gauge",
+                                        "Pending state purge backlog", "keys",
+                                        true);
+      m_gauge->SetCallback([this](auto&& result) {
+        lock_guard<mutex> g(m_mutex);
+        for (const auto& entry : m_dbs) {
+          const auto& backlog = entry.second;
+          result.Set(backlog.entries->load(),
+                     {{"db", backlog.name.c_str()}, {"counter", "Chunks"}});
+          result.Set(backlog.keys->load(),
+                     {{"db", backlog.name.c_str()}, {"counter", "Keys"}});
+        }
+      });
+    }
+    m_dbs[db] = {name, &entries, &keys};
   }
 
-  if (!(KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE) || !dsBlockNum) {
-    // memory mgmt
-    dev::h256s().swap(toPurge);
-    return true;
+  void Unregister(const void* db) {
+    lock_guard<mutex> g(m_mutex);
+    m_dbs.erase(db);
   }
+};
+
+PurgeBacklogGauge& GetPurgeBacklogGauge() {
+  static PurgeBacklogGauge gauge;
+  return gauge;
+}
 
-  // adding into purge pool
-  if (!AddPendingPurge(dsBlockNum, toPurge)) {
-    LOG_GENERAL(WARNING, "AddToPurge failed");
+bool ParseEpoch(const leveldb::Slice& key, uint64_t& dsBlockNum) {
+  try {
+    dsBlockNum = stoull(key.ToString());
+  } catch (...) {
+    LOG_GENERAL(INFO, "key is not numeric: " << key.ToString());
     return false;
   }
+  return true;
+}
 
-  // execute purge for expired keys
-  if (!ExecutePurge(dsBlockNum, inserted)) {
-    LOG_GENERAL(WARNING, "ExecutePurging failed");
-    return false;
+std::string PaddedNumber(uint64_t number) {
+  std::stringstream keystream;
+  keystream.fill('0');
+  keystream.width(BLOCK_NUMERIC_DIGITS);
+  keystream << number;
+  return keystream.str();
+}
+
+leveldb::Slice ToSlice(const zbytes& bytes) {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+/// Appends RLP lists of at most chunkSize keys to batch, under
+/// prefix + PaddedNumber(chunk) for successive chunks
+size_t PutChunks(leveldb::WriteBatch& batch, const std::string& prefix,
+                 uint64_t chunk, const std::vector<dev::h256>& keys,
+                 size_t chunkSize) {
+  size_t chunks = 0;
+  for (size_t i = 0; i < keys.size(); i += chunkSize) {
+    const size_t end = min(keys.size(), i + chunkSize);
+    dev::RLPStream s(end - i);
+    for (size_t j = i; j < end; j++) {
+      s.append(keys[j]);
+    }
+    batch.Put(prefix + PaddedNumber(chunk + chunks), ToSlice(s.out()));
+    chunks++;
+  }
+  return chunks;
+}
+
+}  // namespace
+
+TraceableDB::TraceableDB(const std::string& dbName)
+    : TraceableDB(dbName, PurgeLimits{}) {}
+
+TraceableDB::TraceableDB(const std::string& dbName, const PurgeLimits& limits)
+    : dev::OverlayDB(dbName), m_purgeDB(dbName + "_purge"), m_limits(limits) {
+  GetPurgeBacklogGauge().Register(this, dbName, m_backlogEntries,
+                                  m_backlogKeys);
+}
+
+TraceableDB::~TraceableDB() {
+  {
+    lock_guard<mutex> g(m_mutexWorker);
+    m_shutdown = true;
+  }
+  m_workerCondition.notify_all();
+  if (m_worker.joinable()) {
+    m_worker.join();
+  }
+  GetPurgeBacklogGauge().Unregister(this);
+}
+
+bool TraceableDB::commit(const uint64_t& dsBlockNum) {
+  std::vector<dev::h256> toPurge;
+  unordered_set<dev::h256> inserted;
+
+  {
+    lock_guard<mutex> g(m_mutexPurge);
+
+    if (!OverlayDB::commit(KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE, toPurge,
+                           inserted)) {
+      LOG_GENERAL(WARNING, "OverlayDB::commit failed");
+      return false;
+    }
+
+    if (!(KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE) || !dsBlockNum) {
+      // memory mgmt
+      dev::h256s().swap(toPurge);
+      return true;
+    }
+
+    // adding into purge pool
+    if (!AddPendingPurge(dsBlockNum, toPurge)) {
+      LOG_GENERAL(WARNING, "AddToPurge failed");
+      return false;
+    }
+
+    // keys written again must survive their pending purge
+    if (!inserted.empty() && !FilterPendingPurge(inserted)) {
+      LOG_GENERAL(WARNING, "FilterPendingPurge failed");
+      return false;
+    }
   }
 
   // memory mgmt
   dev::h256s().swap(toPurge);
 
+  // expired keys are deleted in the background
+  if (dsBlockNum > NUM_DS_EPOCHS_STATE_HISTORY) {
+    SchedulePurge(dsBlockNum - NUM_DS_EPOCHS_STATE_HISTORY, false);
+  }
+
   return true;
 }
 
@@ -60,46 +193,53 @@ bool TraceableDB::AddPendingPurge(const uint64_t& dsBlockNum,
     return true;
   }
 
-  dev::RLPStream s(toPurge.size());
-  for (const auto& it : toPurge) {
-    s.append(it);
+  // Every commit of a DS epoch appends chunks after the existing ones
+  const std::string prefix = PaddedNumber(dsBlockNum) + '_';
+  uint64_t chunk = 0;
+  std::unique_ptr<leveldb::Iterator> iter(
+      m_purgeDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+  for (iter->Seek(prefix); iter->Valid() && iter->key().starts_with(prefix);
+       iter->Next()) {
+    try {
+      chunk = max<uint64_t>(
+          chunk, stoull(iter->key().ToString().substr(prefix.size())) + 1);
+    } catch (...) {
+      LOG_GENERAL(INFO, "chunk is not numeric: " << iter->key().ToString());
+      return false;
+    }
   }
+  iter.reset();
 
-  std::stringstream keystream;
-  keystream.fill('0');
-  keystream.width(BLOCK_NUMERIC_DIGITS);
-  keystream << std::to_string(dsBlockNum);
-
-  bool res = m_purgeDB.Insert(keystream.str(), s.out());
+  leveldb::WriteBatch batch;
+  const size_t chunks =
+      PutChunks(batch, prefix, chunk, toPurge, max(m_limits.batchSize, 1u));
+  leveldb::Status status =
+      m_purgeDB.GetDB()->Write(leveldb::WriteOptions(), &batch);
+  if (!status.ok()) {
+    LOG_GENERAL(WARNING, "AddPendingPurge failed: " << status.ToString());
+    return false;
+  }
 
-  // memory mgmt
-  s.clear();
+  m_backlogEntries += chunks;
+  m_backlogKeys += toPurge.size();
 
-  return res == 0;
+  return true;
 }
 
-bool TraceableDB::ExecutePurge(const uint64_t& dsBlockNum,
-                               const unordered_set<dev::h256>& inserted,
-                               bool purgeAll) {
+bool TraceableDB::FilterPendingPurge(const unordered_set<dev::h256>& inserted) {
   LOG_MARKER();
 
+  int64_t entries = 0;
+  int64_t keys = 0;
+
   std::unique_ptr<leveldb::Iterator> iter(
       m_purgeDB.GetDB()->NewIterator(leveldb::ReadOptions()));
-  iter->SeekToFirst();
-  for (; iter->Valid(); iter->Next()) {
-    if (purgeAll && m_stopSignal) {
-      LOG_GENERAL(WARNING, "m_stopSignal = true");
-      break;
-    }
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
     uint64_t t_dsBlockNum;
-    try {
-      t_dsBlockNum = stoull(iter->key().ToString());
-    } catch (...) {
-      LOG_GENERAL(INFO, "key is not numeric: " << iter->key().ToString());
+    if (!ParseEpoch(iter->key(), t_dsBlockNum)) {
       return false;
     }
 
-    // If purgeAll = true, dsBlockNum is inconsequential
     dev::RLP rlp(iter->value());
     std::vector<dev::h256> toPurge(rlp);
     bool updated = false;
@@ -112,52 +252,217 @@ bool TraceableDB::ExecutePurge(const uint64_t& dsBlockNum,
         ++it;
       }
     }
-    if ((t_dsBlockNum + NUM_DS_EPOCHS_STATE_HISTORY < dsBlockNum) || purgeAll) {
-      m_levelDB.BatchDelete(toPurge);
+
+    if (updated && toPurge.empty()) {
       m_purgeDB.DeleteKey(iter->key().ToString());
-      // compact/cleanup for this key immediately.
-      leveldb::Slice k(iter->key());
-      m_purgeDB.GetDB()->CompactRange(&k, &k);
-      LOG_GENERAL(INFO, "Purged entries for t_dsBlockNum = " << t_dsBlockNum);
-    } else {
-      if (updated) {
-        dev::RLPStream s(toPurge.size());
-
-        for (const auto& i : toPurge) {
-          s.append(i);
-        }
-        // Replace the blocknum with new purge hashes
-        m_purgeDB.Insert(iter->key().ToString(), s.out());
+      continue;
+    }
+
+    if (updated) {
+      dev::RLPStream s(toPurge.size());
 
-        // memory mgmt
-        s.clear();
+      for (const auto& i : toPurge) {
+        s.append(i);
       }
+      // Only the chunk holding the re-inserted keys is rewritten
+      m_purgeDB.Insert(iter->key().ToString(), s.out());
+
+      // memory mgmt
+      s.clear();
     }
+
+    entries++;
+    keys += toPurge.size();
+
     // memory mgmt
     dev::h256s().swap(toPurge);
   }
 
+  m_backlogEntries = entries;
+  m_backlogKeys = keys;
+
   return true;
 }
 
+void TraceableDB::SchedulePurge(uint64_t purgeBelow, bool purgeAll) {
+  {
+    lock_guard<mutex> g(m_mutexWorker);
+    if (m_shutdown) {
+      return;
+    }
+    m_purgeBelow = max(m_purgeBelow, purgeBelow);
+    m_purgeAll = m_purgeAll || purgeAll;
+    m_workPending = true;
+    if (!m_worker.joinable()) {
+      m_worker = std::thread([this]() { PurgeWorker(); });
+    }
+  }
+  m_workerCondition.notify_all();
+}
+
+void TraceableDB::PurgeWorker() {
+  utility::SetThreadName("TrieDBPurge");
+
+  {
+    // The backlog left over from a previous run is only known from disk
+    lock_guard<mutex> g(m_mutexPurge);
+    if (!FilterPendingPurge({})) {
+      LOG_GENERAL(WARNING, "Failed to read pending purges");
+    }
+  }
+
+  unique_lock<mutex> lock(m_mutexWorker);
+  while (true) {
+    m_workerCondition.wait(lock,
+                           [this] { return m_shutdown || m_workPending; });
+    if (m_shutdown) {
+      break;
+    }
+
+    const uint64_t purgeBelow = m_purgeBelow;
+    const bool purgeAll = m_purgeAll;
+    m_workPending = false;
+    m_purgeRunning = true;
+
+    lock.unlock();
+    ExecutePurge(purgeBelow, purgeAll);
+    lock.lock();
+
+    if (purgeAll) {
+      m_purgeAll = false;
+    }
+    // A stop request only lasts until the pass it aborted has ended
+    if (m_stopSignal.exchange(false)) {
+      LOG_GENERAL(WARNING, "m_stopSignal = true");
+    }
+    m_purgeRunning = false;
+  }
+}
+
+void TraceableDB::ExecutePurge(uint64_t purgeBelow, bool purgeAll) {
+  LOG_MARKER();
+
+  const size_t batchSize = max(m_limits.batchSize, 1u);
+  std::string firstPurged;
+  std::string lastPurged;
+
+  while (!m_stopSignal) {
+    const auto batchStart = chrono::steady_clock::now();
+    size_t ops = 0;
+    size_t bytes = 0;
+
+    {
+      lock_guard<mutex> g(m_mutexPurge);
+
+      // Entries are ordered by DS epoch, the oldest one is always due first
+      std::unique_ptr<leveldb::Iterator> iter(
+          m_purgeDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+      iter->SeekToFirst();
+      if (!iter->Valid()) {
+        break;
+      }
+
+      uint64_t t_dsBlockNum;
+      if (!ParseEpoch(iter->key(), t_dsBlockNum)) {
+        break;
+      }
+      // If purgeAll = true, purgeBelow is inconsequential
+      if (!purgeAll && t_dsBlockNum >= purgeBelow) {
+        break;
+      }
+
+      const std::string key = iter->key().ToString();
+      dev::RLP rlp(iter->value());
+      std::vector<dev::h256> toPurge(rlp);
+      iter.reset();
+
+      if (toPurge.size() > batchSize) {
+        // Entries from before chunking or from a larger batch size are
+        // split once, their chunks sort right after the original key
+        leveldb::WriteBatch split;
+        const size_t chunks =
+            PutChunks(split, key + '.', 0, toPurge, batchSize);
+        split.Delete(key);
+        leveldb::Status status =
+            m_purgeDB.GetDB()->Write(leveldb::WriteOptions(), &split);
+        if (!status.ok()) {
+          LOG_GENERAL(WARNING, "Purge split failed: " << status.ToString());
+          break;
+        }
+        m_backlogEntries += chunks - 1;
+        continue;
+      }
+
+      leveldb::WriteBatch batch;
+      for (const auto& k : toPurge) {
+        batch.Delete(leveldb::Slice(k.hex()));
+      }
+      leveldb::Status status =
+          m_levelDB.GetDB()->Write(leveldb::WriteOptions(), &batch);
+      if (!status.ok()) {
+        LOG_GENERAL(WARNING, "Purge batch failed: " << status.ToString());
+        break;
+      }
+      ops = toPurge.size();
+      bytes = batch.ApproximateSize();
+
+      // The chunk is only dropped once its keys are gone, so that a restart
+      // resumes with it
+      m_purgeDB.DeleteKey(key);
+      --m_backlogEntries;
+      m_backlogKeys -= ops;
+      if (firstPurged.empty()) {
+        firstPurged = key;
+      }
+      lastPurged = key;
+      LOG_GENERAL(INFO, "Purged " << ops << " entries for t_dsBlockNum = "
+                                  << t_dsBlockNum);
+
+      // memory mgmt
+      dev::h256s().swap(toPurge);
+    }
+
+    if (ops > 0 && GetPurgedKeysCounter().Enabled()) {
+      GetPurgedKeysCounter().IncrementWithAttributes(
+          ops, {{"db", m_purgeDB.GetDBName().c_str()}});
+    }
+
+    // Spread the deletes to stay within the configured disk budget
+    double seconds = 0;
+    if (m_limits.maxOpsPerSec > 0) {
+      seconds = max(seconds, double(ops) / m_limits.maxOpsPerSec);
+    }
+    if (m_limits.maxBytesPerSec > 0) {
+      seconds = max(seconds, double(bytes) / m_limits.maxBytesPerSec);
+    }
+    const auto resumeAt =
+        batchStart + chrono::duration_cast<chrono::steady_clock::duration>(
+                         chrono::duration<double>(seconds));
+    unique_lock<mutex> lock(m_mutexWorker);
+    if (m_workerCondition.wait_until(lock, resumeAt,
+                                     [this] { return m_shutdown; })) {
+      return;
+    }
+  }
+
+  // Compact the purged range once per pass instead of once per DS epoch
+  if (!firstPurged.empty()) {
+    leveldb::Slice begin(firstPurged);
+    leveldb::Slice end(lastPurged);
+    m_purgeDB.GetDB()->CompactRange(&begin, &end);
+  }
+}
+
 bool TraceableDB::RefreshDB() {
+  lock_guard<mutex> g(m_mutexPurge);
   return m_levelDB.RefreshDB() && m_purgeDB.RefreshDB();
 }
 
 void TraceableDB::DetachedExecutePurge() {
   LOG_MARKER();
 
-  auto detached_func = [this]() -> void {
-    if (!m_purgeRunning) {
-      unordered_set<dev::h256> inserted;
-      m_stopSignal = false;
-      m_purgeRunning = true;
-      ExecutePurge(0, inserted, true);
-      m_purgeRunning = false;
-      m_stopSignal = false;
-    } else {
-      LOG_GENERAL(INFO, "DetachedExecutePurge already running");
-    }
-  };
-  DetachedFunction(1, detached_func);
-}
\ No newline at end of file
+  if (m_purgeRunning) {
+    LOG_GENERAL(INFO, "DetachedExecutePurge already running");
+  }
+  SchedulePurge(0, true);
+}
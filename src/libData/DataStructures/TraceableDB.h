@@ -18,32 +18,72 @@
 #ifndef ZILLIQA_SRC_LIBDATA_DATASTRUCTURES_TRACEABLEDB_H_
 #define ZILLIQA_SRC_LIBDATA_DATASTRUCTURES_TRACEABLEDB_H_
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #include "depends/libDatabase/OverlayDB.h"
 #pragma GCC diagnostic pop
 
+/// OverlayDB which keeps the trie nodes replaced in the last
+/// NUM_DS_EPOCHS_STATE_HISTORY DS epochs and deletes older ones on a
+/// background, rate-limited purge thread.
 class TraceableDB : public dev::OverlayDB {
  public:
-  explicit TraceableDB(const std::string& dbName)
-      : dev::OverlayDB(dbName), m_purgeDB(dbName + "_purge") {}
-  ~TraceableDB() = default;
+  /// Purge rate limits, the STATE_PURGE_* constants by default
+  struct PurgeLimits {
+    unsigned int batchSize{STATE_PURGE_BATCH_SIZE};
+    unsigned int maxOpsPerSec{STATE_PURGE_MAX_OPS_PER_SEC};
+    unsigned int maxBytesPerSec{STATE_PURGE_MAX_BYTES_PER_SEC};
+  };
+
+  explicit TraceableDB(const std::string& dbName);
+  TraceableDB(const std::string& dbName, const PurgeLimits& limits);
+  ~TraceableDB();
   bool commit(const uint64_t& dsBlockNum);
 
- private:
+ protected:
   LevelDB m_purgeDB;
+  const PurgeLimits m_limits;
   std::atomic<bool> m_stopSignal{false};
   std::atomic<bool> m_purgeRunning{false};
 
+  /// held by commits, DB refreshes and each purge batch, so that keys
+  /// re-inserted by a commit are never deleted by the purge
+  std::mutex m_mutexPurge;
+
+  /// background purge state, protected by m_mutexWorker
+  std::mutex m_mutexWorker;
+  std::condition_variable m_workerCondition;
+  std::thread m_worker;
+  bool m_shutdown{false};
+  bool m_workPending{false};
+  bool m_purgeAll{false};
+  /// pending purges of DS epochs below this are due
+  uint64_t m_purgeBelow{0};
+
+  /// pending purge backlog, for metrics
+  std::atomic<int64_t> m_backlogEntries{0};
+  std::atomic<int64_t> m_backlogKeys{0};
+
+  /// Stores the keys replaced in a DS epoch as chunks of at most one purge
+  /// batch each, keyed by the zero-padded epoch and chunk number
   bool AddPendingPurge(const uint64_t& dsBlockNum,
                        const std::vector<dev::h256>& toPurge);
-  bool ExecutePurge(const uint64_t& dsBlockNum,
-                    const std::unordered_set<dev::h256>& inserted,
-                    bool purgeAll = false);
+  /// Drop keys that were just re-inserted from every pending purge
+  bool FilterPendingPurge(const std::unordered_set<dev::h256>& inserted);
+  void SchedulePurge(uint64_t purgeBelow, bool purgeAll);
+  void PurgeWorker();
+  /// Deletes due pending purges one chunk per batch at the configured rate,
+  /// until none is due or m_stopSignal is set
+  void ExecutePurge(uint64_t purgeBelow, bool purgeAll);
 
  public:
   void DetachedExecutePurge();
 
+  /// Aborts the running purge pass, or the next one if none is running
   void SetStopSignal() { m_stopSignal = true; }
 
   bool IsPurgeRunning() { return m_purgeRunning; }
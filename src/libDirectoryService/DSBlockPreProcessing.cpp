@@ -75,8 +75,8 @@ unsigned int DirectoryService::ComputeDSBlockParameters(
   difficulty = POW_DIFFICULTY;
   auto lastBlockLink = m_mediator.m_blocklinkchain.GetLatestBlockLink();
   if (m_mediator.m_dsBlockChain.GetBlockCount() > 0) {
-    DSBlock lastBlock = m_mediator.m_dsBlockChain.GetLastBlock();
-    blockNum = lastBlock.GetHeader().GetBlockNum() + 1;
+    const auto lastBlock = m_mediator.m_dsBlockChain.GetLastBlockPtr();
+    blockNum = lastBlock->GetHeader().GetBlockNum() + 1;
     prevHash = get<BlockLinkIndex::BLOCKHASH>(lastBlockLink);
 
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
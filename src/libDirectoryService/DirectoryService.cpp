@@ -1363,6 +1363,22 @@ bool DirectoryService::CheckIfDSNode(const PubKey& submitterPubKey) {
   return false;
 }
 
+void DirectoryService::PreVerifyConsensusMessage(const zbytes& message,
+                                                 unsigned int offset,
+                                                 const Peer& from) {
+  std::shared_ptr<ConsensusCommon> consensusObject;
+  {
+    lock_guard<mutex> g(m_mutexConsensus);
+    consensusObject = m_consensusObject;
+  }
+
+  // A message the current object rejects may be meant for the next one, so
+  // failures are left for ProcessMessage to report
+  if (consensusObject != nullptr) {
+    consensusObject->PreVerifyMessage(message, offset, from);
+  }
+}
+
 CoSignatures DirectoryService::ConsensusObjectToCoSig(
     const ConsensusCommon& consensusObject) {
   return CoSignatures{consensusObject.GetCS1(), consensusObject.GetB1(),
@@ -271,6 +271,10 @@ class DirectoryService : public Executable {
       const zbytes& message, unsigned int offset, const Peer& from,
       [[gnu::unused]] const unsigned char& startByte,
       std::shared_ptr<zil::p2p::P2PServerConnection>);
+  // Lets the consensus object check a message's signatures before the
+  // consensus locks serialize its processing
+  void PreVerifyConsensusMessage(const zbytes& message, unsigned int offset,
+                                 const Peer& from);
   bool ProcessPushLatestDSBlock(const zbytes& message, unsigned int offset,
                                 const Peer& from,
                                 [[gnu::unused]] const unsigned char& startByte,
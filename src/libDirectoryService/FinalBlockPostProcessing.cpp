@@ -135,6 +135,8 @@ bool DirectoryService::StoreFinalBlockToDisk() {
     LOG_GENERAL(WARNING, "Failed to put statedelta in persistence");
     return false;
   }
+  // Hand the whole final block to the write-behind committer at once
+  BlockStorage::GetBlockStorage().CommitBlockWrites();
   return true;
 }
 
@@ -533,6 +535,9 @@ bool DirectoryService::ProcessFinalBlockConsensusCore(
     return false;
   }
 
+  // Decode and check signatures while other messages are being processed
+  PreVerifyConsensusMessage(message, offset, from);
+
   // Consensus messages must be processed in correct sequence as they come in
   // It is possible for ANNOUNCE to arrive before correct DS state
   // In that case, state transition will occurs and ANNOUNCE will be processed.
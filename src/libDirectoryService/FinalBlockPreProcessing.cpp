@@ -131,12 +131,12 @@ bool DirectoryService::ComposeFinalBlock() {
 
   uint64_t blockNum = 0;
   if (m_mediator.m_txBlockChain.GetBlockCount() > 0) {
-    TxBlock lastBlock = m_mediator.m_txBlockChain.GetLastBlock();
-    prevHash = lastBlock.GetBlockHash();
+    const auto lastBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
+    prevHash = lastBlock->GetBlockHash();
 
     LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
               "Prev block hash as per leader " << prevHash.hex());
-    blockNum = lastBlock.GetHeader().GetBlockNum() + 1;
+    blockNum = lastBlock->GetHeader().GetBlockNum() + 1;
   }
 
   if (m_mediator.m_dsBlockChain.GetBlockCount() <= 0) {
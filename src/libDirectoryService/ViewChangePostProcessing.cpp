@@ -425,6 +425,9 @@ bool DirectoryService::ProcessViewChangeConsensus(
     }
   }
 
+  // Decode and check signatures while other messages are being processed
+  PreVerifyConsensusMessage(message, offset, from);
+
   // Consensus messages must be processed in correct sequence as they come in
   // It is possible for ANNOUNCE to arrive before correct DS state
   // In that case, state transition will occurs and ANNOUNCE will be processed.
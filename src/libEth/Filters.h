@@ -20,6 +20,8 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <json/json.h>
 
@@ -87,6 +89,33 @@ class FilterAPIBackend {
   virtual PollResult GetLogs(const Json::Value &params) = 0;
 };
 
+/// Persistent index of finalized event logs, lets eth_getLogs serve block
+/// ranges older than the in-memory cache
+class EventLogIndex {
+ public:
+  struct Log {
+    std::string address;
+    std::vector<std::string> topics;
+    uint32_t txnIndex = 0;
+    uint32_t logIndex = 0;
+    Json::Value response;
+  };
+
+  virtual ~EventLogIndex() = default;
+
+  /// Stores the logs of a finalized epoch. Called with the filters cache
+  /// locked, so implementations should queue rather than write.
+  virtual void PutEpochLogs(uint64_t epoch, std::vector<Log> logs) = 0;
+
+  /// Returns the logs of epochs [from, to] matching the addresses and
+  /// per-position topic variants (empty means any), in chain order. Fails
+  /// if there are too many of them.
+  virtual bool GetLogs(uint64_t from, uint64_t to,
+                       const std::vector<std::string> &addresses,
+                       const std::vector<std::vector<std::string>> &topics,
+                       std::vector<Log> &logs, std::string &error) = 0;
+};
+
 class APICacheUpdate {
  public:
   virtual ~APICacheUpdate() = default;
@@ -114,6 +143,7 @@ class APICache {
   virtual APICacheUpdate &GetUpdate() = 0;
   virtual void EnableWebsocketAPI(std::shared_ptr<rpc::WebsocketServer> ws,
                                   BlockByHash blockByHash) = 0;
+  virtual void SetEventLogIndex(std::shared_ptr<EventLogIndex> index) = 0;
 };
 
 }  // namespace filters
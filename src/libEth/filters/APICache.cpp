@@ -52,6 +52,11 @@ class APICacheImpl : public APICache, public APICacheUpdate, public TxCache {
     m_subscriptions.Start(std::move(ws), std::move(blockByHash));
   }
 
+  void SetEventLogIndex(std::shared_ptr<EventLogIndex> index) override {
+    m_eventLogIndex = index;
+    m_filterAPI.SetEventLogIndex(std::move(index));
+  }
+
   void AddPendingTransaction(const TxnHash& hash, uint64_t epoch) override {
     auto hash_normalized = NormalizeHexString(hash);
     if (m_pendingTxnCache.Append(hash_normalized, epoch)) {
@@ -85,6 +90,10 @@ class APICacheImpl : public APICache, public APICacheUpdate, public TxCache {
     return m_blocksCache.GetBlockFilterChanges(after_epoch, result);
   }
 
+  EpochNumber GetEarliestEpoch() override {
+    return m_blocksCache.GetEarliestEpoch();
+  }
+
   EpochNumber GetPendingTxnsFilterChanges(EpochNumber after_counter,
                                           PollResult& result) override {
     return m_pendingTxnCache.GetPendingTxnsFilterChanges(after_counter, result);
@@ -99,6 +108,19 @@ class APICacheImpl : public APICache, public APICacheUpdate, public TxCache {
       m_subscriptions.OnEventLog(event.address, event.topics, event.response);
     }
 
+    if (m_eventLogIndex && !meta.meta.empty()) {
+      std::vector<EventLogIndex::Log> logs(meta.meta.size());
+      for (size_t i = 0; i < meta.meta.size(); ++i) {
+        const auto& event = meta.meta[i];
+        logs[i].address = event.address;
+        logs[i].topics = event.topics;
+        logs[i].txnIndex = event.txnIndex;
+        logs[i].logIndex = static_cast<uint32_t>(i);
+        logs[i].response = event.response;
+      }
+      m_eventLogIndex->PutEpochLogs(epoch, std::move(logs));
+    }
+
     auto earliest = epoch > TXMETADATADEPTH ? epoch - TXMETADATADEPTH : 1;
     m_filterAPI.SetEpochRange(earliest, epoch);
   }
@@ -107,6 +129,7 @@ class APICacheImpl : public APICache, public APICacheUpdate, public TxCache {
   SubscriptionsImpl m_subscriptions;
   PendingTxnCache m_pendingTxnCache;
   BlocksCache m_blocksCache;
+  std::shared_ptr<EventLogIndex> m_eventLogIndex;
 };
 
 std::shared_ptr<APICache> APICache::Create() {
@@ -185,6 +185,7 @@ void BlocksCache::FinalizeOneEpoch(EpochNumber n, EpochInProcess &data) {
         for (auto &e : txn.events) {
           item.meta.emplace_back(std::move(e));
           auto &event = item.meta.back();
+          event.txnIndex = static_cast<uint32_t>(txn_index);
           event.response[LOGINDEX_STR] = NumberAsString(event_idx);
           event.response[BLOCKHASH_STR] = item.blockHash;
           event.response[TRANSACTIONINDEX_STR] = NumberAsString(txn_index);
@@ -197,6 +198,15 @@ void BlocksCache::FinalizeOneEpoch(EpochNumber n, EpochInProcess &data) {
   m_epochFinalizedCallback(item);
 }
 
+EpochNumber BlocksCache::GetEarliestEpoch() {
+  SharedLock lock(m_mutex);
+
+  if (m_finalizedEpochs.empty()) {
+    return SEEN_NOTHING;
+  }
+  return m_finalizedEpochs.front().epoch;
+}
+
 BlocksCache::FinalizedEpochs::iterator BlocksCache::FindNext(
     EpochNumber after_epoch) {
   EpochMetadata item;
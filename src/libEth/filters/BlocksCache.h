@@ -32,6 +32,7 @@ class BlocksCache {
   struct EventLog {
     Address address;
     std::vector<Quantity> topics;
+    uint32_t txnIndex = 0;
     Json::Value response;
   };
 
@@ -64,6 +65,8 @@ class BlocksCache {
   EpochNumber GetBlockFilterChanges(EpochNumber after_epoch,
                                     PollResult &result);
 
+  EpochNumber GetEarliestEpoch();
+
  private:
   struct TransactionAndEvents {
     TxnHash hash;
@@ -73,6 +73,9 @@ class TxCache {
   virtual EpochNumber GetBlockFilterChanges(EpochNumber after_epoch,
                                             PollResult &result) = 0;
 
+  /// Earliest epoch whose event logs are cached in memory
+  virtual EpochNumber GetEarliestEpoch() = 0;
+
   virtual EpochNumber GetPendingTxnsFilterChanges(EpochNumber after_counter,
                                                   PollResult &result) = 0;
 };
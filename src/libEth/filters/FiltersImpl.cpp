@@ -15,6 +15,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <limits>
+
 #include <boost/asio/steady_timer.hpp>
 
 #include "FiltersImpl.h"
@@ -305,19 +307,55 @@ PollResult FilterAPIBackendImpl::GetFilterLogs(const FilterId &filter_id) {
 PollResult FilterAPIBackendImpl::GetLogs(const Json::Value &params) {
   PollResult ret;
 
-  if (m_latestEpoch < 0) {
-    ret.error = API_NOT_READY;
+  EventFilterParams filter;
+
+  if (!InitializeEventFilter(params, filter, ret.error)) {
     return ret;
   }
 
-  EventFilterParams filter;
+  // Epochs which left the cache are answered from the persistent index, and
+  // so are all of them while the cache is still empty after a restart
+  const bool useIndex =
+      m_eventLogIndex &&
+      (filter.fromBlock >= 0 || filter.fromBlock == EARLIEST_EPOCH);
 
-  if (!InitializeEventFilter(params, filter, ret.error)) {
+  if (m_latestEpoch < 0 && !useIndex) {
+    ret.error = API_NOT_READY;
     return ret;
   }
 
+  Json::Value indexed(Json::arrayValue);
+  if (useIndex) {
+    const EpochNumber earliestCached = m_cache.GetEarliestEpoch();
+    EpochNumber from = std::max<EpochNumber>(filter.fromBlock, 0);
+    EpochNumber to = earliestCached >= 0
+                         ? earliestCached - 1
+                         : std::numeric_limits<EpochNumber>::max();
+    if (filter.toBlock >= 0) {
+      to = std::min(to, filter.toBlock);
+    }
+
+    if (from <= to) {
+      std::vector<EventLogIndex::Log> logs;
+      if (!m_eventLogIndex->GetLogs(from, to, filter.address,
+                                    filter.topicMatches, logs, ret.error)) {
+        return ret;
+      }
+      for (auto &log : logs) {
+        indexed.append(std::move(log.response));
+      }
+    }
+  }
+
   std::ignore = m_cache.GetEventFilterChanges(SEEN_NOTHING, filter, ret);
 
+  if (!indexed.empty() && ret.success) {
+    for (const auto &item : ret.result) {
+      indexed.append(item);
+    }
+    ret.result = std::move(indexed);
+  }
+
   return ret;
 }
 
@@ -20,6 +20,7 @@
 
 #include <cassert>
 #include <chrono>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <shared_mutex>
@@ -69,6 +70,10 @@ class FilterAPIBackendImpl : public FilterAPIBackend {
 
   explicit FilterAPIBackendImpl(TxCache &cache) : m_cache(cache) {}
 
+  void SetEventLogIndex(std::shared_ptr<EventLogIndex> index) {
+    m_eventLogIndex = std::move(index);
+  }
+
  private:
   void GetEventFilterChanges(const std::string &filter_id, PollResult &result,
                              std::chrono::seconds &expireTime,
@@ -84,6 +89,9 @@ class FilterAPIBackendImpl : public FilterAPIBackend {
   /// Metadata cache
   TxCache &m_cache;
 
+  /// Serves eth_getLogs for epochs no longer cached, if set
+  std::shared_ptr<EventLogIndex> m_eventLogIndex;
+
   /// Epoch range that can be polled at the moment
   EpochNumber m_earliestEpoch = SEEN_NOTHING;
   EpochNumber m_latestEpoch = SEEN_NOTHING;
@@ -3232,6 +3232,7 @@ bool Lookup::CommitTxBlocks(const vector<TxBlock>& txBlocks) {
       LOG_GENERAL(WARNING, "BlockStorage::PutTxBlock failed " << txBlock);
       return false;
     }
+    BlockStorage::GetBlockStorage().CommitBlockWrites();
 
     // If txblk not from vacaous epoch and is rejoining as ds node
     if ((blockNum + 1) % NUM_FINAL_BLOCK_PER_POW != 0 &&
@@ -3951,6 +3952,7 @@ bool Lookup::ProcessSetTxnsFromLookup(
                  // the entry from unavailable list
     }
   }
+  BlockStorage::GetBlockStorage().CommitBlockWrites();
 
   // Delete the mb from unavailable list here
   std::lock_guard<mutex> lock(m_mediator.m_node->m_mutexUnavailableMicroBlocks);
@@ -5283,17 +5285,21 @@ bool Lookup::AddTxnToMemPool(const Transaction& tx, TxnMemPool& txnMemPool,
     return false;
   }
 
-  // case where txn already exist
-  if (find_if(m_txnMemPool.cbegin(), m_txnMemPool.cend(),
-              [tx](const Transaction& txn) {
-                return tx.GetTranID() == txn.GetTranID();
-              }) != m_txnMemPool.end()) {
-    LOG_GENERAL(WARNING, "Same hash present " << tx.GetTranID());
+  MempoolInsertionStatus status;
+  if (!txnMemPool.insert(tx, status)) {
+    if (status.first == TxnStatus::MEMPOOL_ALREADY_PRESENT) {
+      LOG_GENERAL(WARNING, "Same hash present " << tx.GetTranID());
+    } else {
+      LOG_GENERAL(WARNING, "Same nonce with higher gas present "
+                               << tx.GetTranID());
+    }
     return false;
   }
 
-  txnMemPool.push_back(tx);
   if (tx.IsEth() && ENABLE_ETH_TXN_COUNT_PENDING_TXN) {
+    if (status.first == TxnStatus::MEMPOOL_SAME_NONCE_LOWER_GAS) {
+      m_txnLiteManager.RemoveTransaction(tx.GetSenderAddr(), status.second);
+    }
     TransactionLite lite(tx.GetTranID(), tx.GetNonce(),
                          m_mediator.m_currentEpochNum);
     m_txnLiteManager.AddTransaction(tx.GetSenderAddr(), std::move(lite));
@@ -5322,7 +5328,7 @@ bool Lookup::AddTxnToMemPool(const Transaction& tx) {
   return AddTxnToMemPool(tx, m_txnMemPool, m_txnMemPoolMutex);
 }
 
-void Lookup::AddTxnToMemPool(const std::vector<Transaction>& txns) {
+void Lookup::AddTxnToMemPool(std::vector<Transaction> txns) {
   LOG_MARKER();
   if (!LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
@@ -5331,7 +5337,8 @@ void Lookup::AddTxnToMemPool(const std::vector<Transaction>& txns) {
     return;
   }
 
-  unsigned long toAddCount = 0;
+  const bool toRemoteStorage = REMOTESTORAGE_DB_ENABLE && !ARCHIVAL_LOOKUP;
+  std::vector<Transaction> added;
   {
     lock_guard<mutex> g(m_txnMemPoolMutex);
 
@@ -5340,49 +5347,47 @@ void Lookup::AddTxnToMemPool(const std::vector<Transaction>& txns) {
       return;
     }
 
-    // Add no more than TXN_STORAGE_LIMIT and available in txns
-    toAddCount =
-        std::min(TXN_STORAGE_LIMIT - std::size(m_txnMemPool), std::size(txns));
-
-    m_txnMemPool.insert(std::end(m_txnMemPool), std::begin(txns),
-                        std::begin(txns) + toAddCount);
-
-    // Remove duplicates
-    std::sort(std::begin(m_txnMemPool), std::end(m_txnMemPool));
-    m_txnMemPool.erase(
-        std::unique(std::begin(m_txnMemPool), std::end(m_txnMemPool)),
-        std::end(m_txnMemPool));
+    // Add no more than TXN_STORAGE_LIMIT, skipping duplicates
+    MempoolInsertionStatus status;
+    for (auto& txn : txns) {
+      if (std::size(m_txnMemPool) >= TXN_STORAGE_LIMIT) {
+        LOG_GENERAL(INFO, "Number of txns exceeded limit");
+        break;
+      }
+      // Txns only need to be kept once pooled when they are also stored
+      if (!toRemoteStorage) {
+        m_txnMemPool.insert(std::move(txn), status);
+      } else if (m_txnMemPool.insert(txn, status)) {
+        added.push_back(std::move(txn));
+      }
+    }
   }
 
-  if (REMOTESTORAGE_DB_ENABLE && !ARCHIVAL_LOOKUP) {
-    auto mongoInsertFunc =
-        [transactions =
-             std::vector<Transaction>{
-                 std::make_move_iterator(std::begin(txns)),
-                 std::make_move_iterator(std::begin(txns) + toAddCount)},
-         epoch = m_mediator.m_currentEpochNum]() {
-          for (const auto& txn : transactions) {
-            RemoteStorageDB::GetInstance().InsertTxn(txn, TxnStatus::DISPATCHED,
-                                                     epoch);
-          }
-        };
+  if (toRemoteStorage && !added.empty()) {
+    auto mongoInsertFunc = [transactions = std::move(added),
+                            epoch = m_mediator.m_currentEpochNum]() {
+      for (const auto& txn : transactions) {
+        RemoteStorageDB::GetInstance().InsertTxn(txn, TxnStatus::DISPATCHED,
+                                                 epoch);
+      }
+    };
     DetachedFunction(1, mongoInsertFunc);
   }
 }
 
-bool Lookup::ClearTxnMemPool() {
+std::vector<Transaction> Lookup::DrainTxnMemPool() {
   if (!LOOKUP_NODE_MODE) {
     LOG_GENERAL(WARNING,
-                "Lookup::ClearTxnMemPool not expected to be called from "
+                "Lookup::DrainTxnMemPool not expected to be called from "
                 "other than the LookUp node.");
-    return true;
+    return {};
   }
-  LOG_GENERAL(INFO,
-              "Clearing m_txnMemPool, current size: " << m_txnMemPool.size());
 
-  m_txnMemPool.clear();
+  lock_guard<mutex> g(m_txnMemPoolMutex);
+  LOG_GENERAL(INFO,
+              "Draining m_txnMemPool, current size: " << m_txnMemPool.size());
 
-  return true;
+  return m_txnMemPool.drain();
 }
 
 void Lookup::SenderTxnBatchThread(std::vector<Transaction> transactions) {
@@ -5611,7 +5616,7 @@ bool Lookup::ProcessForwardTxn(const zbytes& message, unsigned int offset,
   } else {
     // I'm a lookup (non-seed & non-external) - save this message into
     // mempool. Mempool will be sent to ds members when final block arrives
-    AddTxnToMemPool(transactions);
+    AddTxnToMemPool(std::move(transactions));
   }
 
   return true;
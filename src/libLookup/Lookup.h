@@ -33,6 +33,7 @@
 #include "libBlockchain/TxBlock.h"
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionLite.h"
+#include "libData/AccountData/TxnMemPool.h"
 #include "libNetwork/Executable.h"
 #include "libNetwork/ShardStruct.h"
 #include "libUtils/IPConverter.h"
@@ -42,8 +43,6 @@ class Synchronizer;
 class LookupServer;
 class StakingServer;
 
-using TxnMemPool = std::vector<Transaction>;
-
 /// Processes requests pertaining to network, transaction, or block information
 class Lookup : public Executable {
   Mediator& m_mediator;
@@ -110,7 +109,7 @@ class Lookup : public Executable {
   std::mutex m_mutexMicroBlocksBuffer;
 
   TxnMemPool m_txnMemPool;
-  TxnMemPool m_txnMemPoolGenerated;
+  std::vector<Transaction> m_txnMemPoolGenerated;
 
   std::map<Address, uint64_t> m_gentxnAddrLatestNonceSent;
 
@@ -177,7 +176,6 @@ class Lookup : public Executable {
   // Getter for m_seedNodes
   VectorOfNode GetSeedNodes() const;
 
-  auto GetTransactionsFromMemPool() const { return m_txnMemPool; }
   TransactionLiteManager m_txnLiteManager;
   void RemoveTxnFromCurrentTxnLiteMemPool(const Address& address,
                                           const TxnHash& txn);
@@ -296,11 +294,12 @@ class Lookup : public Executable {
   bool AddTxnToMemPool(const Transaction& tx, TxnMemPool& txnMemPool,
                        std::mutex& txnMemPoolMutex);
 
-  void AddTxnToMemPool(const std::vector<Transaction>& tx);
+  void AddTxnToMemPool(std::vector<Transaction> txns);
 
   void CheckBufferTxBlocks();
 
-  bool ClearTxnMemPool();
+  /// Moves the pending txns out of the mempool in arrival order
+  std::vector<Transaction> DrainTxnMemPool();
 
   void SetServerTrue();
 
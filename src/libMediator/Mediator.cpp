@@ -122,10 +122,10 @@ void Mediator::UpdateDSBlockRand(bool isGenesis) {
     DataConversion::HexStrToStdArray(RAND1_GENESIS, rand1);
     copy(rand1.begin(), rand1.end(), m_dsBlockRand.begin());
   } else {
-    DSBlock lastBlock = m_dsBlockChain.GetLastBlock();
+    const auto lastBlock = m_dsBlockChain.GetLastBlockPtr();
     SHA256Calculator sha2;
     zbytes vec;
-    lastBlock.GetHeader().Serialize(vec, 0);
+    lastBlock->GetHeader().Serialize(vec, 0);
     sha2.Update(vec);
     zbytes randVec;
     randVec = sha2.Finalize();
@@ -142,10 +142,10 @@ void Mediator::UpdateTxBlockRand(bool isGenesis) {
     DataConversion::HexStrToStdArray(RAND2_GENESIS, rand2);
     copy(rand2.begin(), rand2.end(), m_txBlockRand.begin());
   } else {
-    TxBlock lastBlock = m_txBlockChain.GetLastBlock();
+    const auto lastBlock = m_txBlockChain.GetLastBlockPtr();
     SHA256Calculator sha2;
     zbytes vec;
-    lastBlock.GetHeader().Serialize(vec, 0);
+    lastBlock->GetHeader().Serialize(vec, 0);
     sha2.Update(vec);
     zbytes randVec;
     randVec = sha2.Finalize();
@@ -31,8 +31,10 @@
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <algorithm>
+#include <future>
 #include <map>
 #include <random>
+#include <thread>
 #include <unordered_set>
 
 using namespace boost::multiprecision;
@@ -909,7 +911,9 @@ bool ProtobufToTransaction(const ProtoTransaction& protoTransaction,
     return false;
   }
 
-  if (!transaction.IsSigned(txnData)) {
+  // The constructor already checked the signature against the re-serialized
+  // core fields; only fall back to the received bytes if that failed
+  if (!transaction.IsSignatureVerified() && !transaction.IsSigned(txnData)) {
     LOG_GENERAL(WARNING,
                 "Signature verification failed when converting tx to protobuf");
     return false;
@@ -948,22 +952,75 @@ void TransactionArrayToProtobuf(const deque<pair<Transaction, uint32_t>>& txns,
   }
 }
 
-bool ProtobufToTransactionArray(
-    const ProtoTransactionArray& protoTransactionArray,
+// Converting a txn is dominated by its signature check, so large arrays (such
+// as txn packets) are split across TXN_SIG_VERIFY_THREADS threads. The order
+// of the txns is preserved.
+bool ProtobufToTransactions(
+    const google::protobuf::RepeatedPtrField<ProtoTransaction>&
+        protoTransactions,
     std::vector<Transaction>& txns) {
-  txns.reserve(protoTransactionArray.transactions_size());
-  for (const auto& protoTransaction : protoTransactionArray.transactions()) {
-    Transaction txn;
-    if (!ProtobufToTransaction(protoTransaction, txn)) {
-      LOG_GENERAL(WARNING, "ProtobufToTransaction failed");
-      return false;
+  static const unsigned int MIN_TXNS_PER_THREAD = 64;
+
+  const size_t count = protoTransactions.size();
+  const size_t maxThreads = TXN_SIG_VERIFY_THREADS > 0
+                                ? TXN_SIG_VERIFY_THREADS
+                                : max(1U, thread::hardware_concurrency());
+  const size_t numThreads =
+      min(maxThreads, (count + MIN_TXNS_PER_THREAD - 1) / MIN_TXNS_PER_THREAD);
+
+  txns.reserve(txns.size() + count);
+
+  if (numThreads <= 1) {
+    for (const auto& protoTransaction : protoTransactions) {
+      Transaction txn;
+      if (!ProtobufToTransaction(protoTransaction, txn)) {
+        LOG_GENERAL(WARNING, "ProtobufToTransaction failed");
+        return false;
+      }
+      txns.emplace_back(std::move(txn));
     }
-    txns.push_back(txn);
+    return true;
   }
 
+  vector<Transaction> converted(count);
+  vector<future<bool>> workers;
+  workers.reserve(numThreads);
+
+  const size_t chunkSize = (count + numThreads - 1) / numThreads;
+  for (size_t begin = 0; begin < count; begin += chunkSize) {
+    const size_t end = min(begin + chunkSize, count);
+    workers.emplace_back(
+        async(launch::async, [&protoTransactions, &converted, begin, end]() {
+          for (size_t i = begin; i < end; ++i) {
+            if (!ProtobufToTransaction(protoTransactions.Get(i),
+                                       converted[i])) {
+              LOG_GENERAL(WARNING, "ProtobufToTransaction failed");
+              return false;
+            }
+          }
+          return true;
+        }));
+  }
+
+  // Wait for every worker, since they all reference converted
+  bool result = true;
+  for (auto& worker : workers) {
+    result = worker.get() && result;
+  }
+  if (!result) {
+    return false;
+  }
+
+  move(converted.begin(), converted.end(), back_inserter(txns));
   return true;
 }
 
+bool ProtobufToTransactionArray(
+    const ProtoTransactionArray& protoTransactionArray,
+    std::vector<Transaction>& txns) {
+  return ProtobufToTransactions(protoTransactionArray.transactions(), txns);
+}
+
 void TransactionReceiptToProtobuf(const TransactionReceipt& transReceipt,
                                   ProtoTransactionReceipt& protoTransReceipt) {
   protoTransReceipt.set_receipt(transReceipt.GetString());
@@ -3692,15 +3749,8 @@ bool Messenger::GetNodeForwardTxnBlock(
       LOG_GENERAL(WARNING, "Invalid signature in transactions");
       return false;
     }
-    txns.reserve(result.transactions_size());
-
-    for (const auto& txn : result.transactions()) {
-      Transaction t;
-      if (!ProtobufToTransaction(txn, t)) {
-        LOG_GENERAL(WARNING, "ProtobufToTransaction failed");
-        return false;
-      }
-      txns.emplace_back(std::move(t));
+    if (!ProtobufToTransactions(result.transactions(), txns)) {
+      return false;
     }
   }
 
@@ -43,7 +43,9 @@
   M(GLOBAL_ERROR)                 \
   M(DEMO)                         \
   M(CPS_EVM)                      \
-  M(CPS_SCILLA)
+  M(CPS_SCILLA)                   \
+  M(THREAD_POOL)                  \
+  M(STATE_PURGE)
 
 namespace zil {
 namespace metrics {
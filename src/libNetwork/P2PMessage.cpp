@@ -17,17 +17,75 @@
 
 #include "P2PMessage.h"
 
+#include <algorithm>
+
+#include <snappy.h>
+
 #include "common/Constants.h"
+#include "common/Messages.h"
+#include "libMetrics/Api.h"
 #include "libMetrics/Tracing.h"
 #include "libUtils/Logger.h"
+#include "libUtils/TimeUtils.h"
 
 namespace zil::p2p {
 
 namespace {
 
+constexpr uint8_t VERSION_TRACES_FLAG = 128;
+constexpr uint8_t VERSION_COMPRESSED_FLAG = 64;
+
 inline uint8_t MsgVersionWithTraces() {
-  assert(MSG_VERSION < 128);
-  return uint8_t(MSG_VERSION) + 128;
+  assert(MSG_VERSION < VERSION_COMPRESSED_FLAG);
+  return uint8_t(MSG_VERSION) + VERSION_TRACES_FLAG;
+}
+
+Z_DBLHIST& GetCompressionRatio() {
+  static std::vector<double> ratioBoundaries{0.05, 0.1, 0.2, 0.3, 0.4,
+                                             0.5,  0.6, 0.7, 0.8, 0.9, 1};
+  static Z_DBLHIST counter{Z_FL::MSG_DISPATCH, "p2p.compression.ratio",
+                           ratioBoundaries,
+                           "compressed to raw size of P2P messages", "ratio"};
+  return counter;
+}
+
+Z_DBLHIST& GetCompressionLatency() {
+  static std::vector<double> latencyBoundaries{0,  0.1, 0.25, 0.5, 1,  2,
+                                               5,  10,  20,   50,  100};
+  static Z_DBLHIST counter{Z_FL::MSG_DISPATCH, "p2p.compression.latency",
+                           latencyBoundaries,
+                           "CPU time spent compressing P2P messages", "ms"};
+  return counter;
+}
+
+/// Message classes that are large and compress well: blocks with sharding
+/// structures and state deltas, forwarded transactions and lookup sync data
+bool IsCompressible(const zbytes& message) {
+  if (message.size() <= MessageOffset::INST) {
+    return false;
+  }
+
+  const auto ins = message[MessageOffset::INST];
+  switch (message[MessageOffset::TYPE]) {
+    case MessageType::NODE:
+      return ins == NodeInstructionType::DSBLOCK ||
+             ins == NodeInstructionType::FINALBLOCK ||
+             ins == NodeInstructionType::MBNFORWARDTRANSACTION ||
+             ins == NodeInstructionType::VCBLOCK ||
+             ins == NodeInstructionType::VCFINALBLOCK;
+    case MessageType::LOOKUP:
+      return ins == LookupInstructionType::SETDSINFOFROMSEED ||
+             ins == LookupInstructionType::SETDSBLOCKFROMSEED ||
+             ins == LookupInstructionType::SETTXBLOCKFROMSEED ||
+             ins == LookupInstructionType::SETMICROBLOCKFROMLOOKUP ||
+             ins == LookupInstructionType::SETTXNFROMLOOKUP ||
+             ins == LookupInstructionType::SETDIRBLOCKSFROMSEED ||
+             ins == LookupInstructionType::SETSTATEDELTAFROMSEED ||
+             ins == LookupInstructionType::SETSTATEDELTASFROMSEED ||
+             ins == LookupInstructionType::SETMINERINFOFROMSEED;
+    default:
+      return false;
+  }
 }
 
 }  // namespace
@@ -37,6 +95,17 @@ RawMessage::RawMessage(uint8_t* buf, size_t sz)
 
 RawMessage CreateMessage(const zbytes& message, const zbytes& msg_hash,
                          uint8_t start_byte, bool inject_trace_context) {
+  // Gossip carries rumors behind its own header, so is never compressed
+  const bool compress = P2P_COMPRESSION && start_byte != START_BYTE_GOSSIP &&
+                        message.size() >= P2P_COMPRESSION_MIN_BYTES &&
+                        IsCompressible(message);
+  return CreateMessage(message, msg_hash, start_byte, inject_trace_context,
+                       compress);
+}
+
+RawMessage CreateMessage(const zbytes& message, const zbytes& msg_hash,
+                         uint8_t start_byte, bool inject_trace_context,
+                         bool compress) {
   assert(msg_hash.empty() || msg_hash.size() == HASH_LEN);
 
   if (message.empty()) {
@@ -51,21 +120,60 @@ RawMessage CreateMessage(const zbytes& message, const zbytes& msg_hash,
 
   size_t trace_size = trace_info.size();
 
-  size_t total_size = msg_hash.size() + message.size() + trace_size;
+  // Room for the compressed message is reserved up front so that it is
+  // compressed straight into the frame
+  size_t message_size = compress ? snappy::MaxCompressedLength(message.size())
+                                 : message.size();
+
+  size_t prefix_size = msg_hash.size();
   if (trace_size != 0) {
-    total_size += 4;
+    prefix_size += 4;
   }
 
-  size_t buf_size_with_header = HDR_LEN + total_size;
-
-  uint8_t* buf_base = (uint8_t*)malloc(buf_size_with_header);
+  uint8_t* buf_base =
+      (uint8_t*)malloc(HDR_LEN + prefix_size + message_size + trace_size);
   assert(buf_base);
   if (!buf_base) {
     throw std::bad_alloc{};
   }
-  auto* buf = buf_base;
 
-  uint8_t version = (trace_size != 0) ? MsgVersionWithTraces() : MSG_VERSION;
+  auto* buf = buf_base + HDR_LEN + prefix_size;
+  if (compress) {
+    auto start = r_timer_start();
+    snappy::RawCompress(reinterpret_cast<const char*>(message.data()),
+                        message.size(), reinterpret_cast<char*>(buf),
+                        &message_size);
+    const double ratio = double(message_size) / message.size();
+    if (GetCompressionLatency().Enabled()) {
+      GetCompressionLatency().Record(r_timer_end(start) / 1000,
+                                     {{"op", "compress"}});
+    }
+    if (GetCompressionRatio().Enabled()) {
+      GetCompressionRatio().Record(ratio, {{"type", "outgoing"}});
+    }
+
+    // Incompressible data goes out as is
+    if (message_size >= message.size()) {
+      compress = false;
+    }
+  }
+  if (!compress) {
+    message_size = message.size();
+    memcpy(buf, message.data(), message_size);
+  }
+
+  size_t total_size = prefix_size + message_size + trace_size;
+  size_t buf_size_with_header = HDR_LEN + total_size;
+
+  buf = buf_base;
+
+  uint8_t version = MSG_VERSION;
+  if (trace_size != 0) {
+    version = MsgVersionWithTraces();
+  }
+  if (compress) {
+    version |= VERSION_COMPRESSED_FLAG;
+  }
   *buf++ = version;
 
   *buf++ = (NETWORK_ID >> 8) & 0xFF;
@@ -91,35 +199,32 @@ RawMessage CreateMessage(const zbytes& message, const zbytes& msg_hash,
     buf += sz;
   }
 
-  memcpy(buf, message.data(), message.size());
+  // The message is already in place
+  buf += message_size;
 
   if (trace_size != 0) {
-    buf += message.size();
     memcpy(buf, trace_info.data(), trace_size);
   }
 
   return RawMessage(buf_base, buf_size_with_header);
 }
 
-ReadState TryReadMessage(const uint8_t* buf, size_t buf_size,
-                         ReadMessageResult& result) {
-  if (!buf || buf_size < HDR_LEN) {
-    LOG_GENERAL(WARNING, "Not enough data to read message header");
-    return ReadState::NOT_ENOUGH_DATA;
-  }
-
-  auto version = buf[0];
+ReadState ReadFrameHeader(const uint8_t* buf, MessageFrame& frame,
+                          ReadMessageResult& result) {
+  frame.version = buf[0];
+  frame.compressed = (frame.version & VERSION_COMPRESSED_FLAG) != 0;
+  const uint8_t version = frame.version & ~VERSION_COMPRESSED_FLAG;
+  const bool withTraces = version == MsgVersionWithTraces();
 
   // Check for version requirement
-  if (version != (unsigned char)(MSG_VERSION & 0xFF) &&
-      version != MsgVersionWithTraces()) {
+  if (version != (unsigned char)(MSG_VERSION & 0xFF) && !withTraces) {
     LOG_GENERAL(WARNING, "Header version wrong, received ["
-                             << version - 0x00 << "] while expected ["
+                             << frame.version - 0x00 << "] while expected ["
                              << MSG_VERSION << "] or ["
-                             << MsgVersionWithTraces() << "]");
+                             << MsgVersionWithTraces()
+                             << "], possibly compressed");
     return ReadState::WRONG_MSG_VERSION;
   }
-
   const uint16_t networkid = (uint16_t(buf[1]) << 8) + buf[2];
   if (networkid != NETWORK_ID) {
     LOG_GENERAL(WARNING, "Header networkid wrong, received ["
@@ -130,59 +235,139 @@ ReadState TryReadMessage(const uint8_t* buf, size_t buf_size,
 
   result.startByte = buf[3];
 
-  uint32_t length_of_remaining_message = ReadU32BE(buf + 4);
+  frame.remainingLength = ReadU32BE(buf + 4);
+  result.totalMessageBytes = HDR_LEN + frame.remainingLength;
 
-  result.totalMessageBytes = HDR_LEN + length_of_remaining_message;
-  if (buf_size < result.totalMessageBytes) {
-    return ReadState::NOT_ENOUGH_DATA;
+  frame.prefixLength = 0;
+  if (withTraces) {
+    if (frame.remainingLength < 5) {
+      LOG_GENERAL(WARNING,
+                  "Invalid length [" << frame.remainingLength << "]");
+      return ReadState::WRONG_MESSAGE_LENGTH;
+    }
+    frame.prefixLength += 4;
+  }
+  if (result.startByte == START_BYTE_BROADCAST) {
+    frame.prefixLength += HASH_LEN;
+  }
+  if (frame.prefixLength > frame.remainingLength) {
+    LOG_GENERAL(WARNING, "Invalid length [" << frame.remainingLength
+                                            << "] for start byte ["
+                                            << int(result.startByte) << "]");
+    return ReadState::WRONG_MESSAGE_LENGTH;
   }
 
   // For non-broadcast messages w/o trace info
-  uint32_t msg_length = length_of_remaining_message;
-  uint32_t trace_length = 0;
-
-  buf += HDR_LEN;
+  frame.messageLength = frame.remainingLength;
+  frame.traceLength = 0;
 
-  if (version == MsgVersionWithTraces()) {
-    if (length_of_remaining_message < 5) {
-      LOG_GENERAL(WARNING,
-                  "Invalid length [" << length_of_remaining_message << "]");
-      return ReadState::WRONG_MESSAGE_LENGTH;
-    }
+  return ReadState::SUCCESS;
+}
 
-    trace_length = ReadU32BE(buf);
-    if (trace_length == 0 || trace_length > length_of_remaining_message - 4) {
+ReadState ReadFramePrefix(const uint8_t* buf, MessageFrame& frame,
+                          ReadMessageResult& result) {
+  if ((frame.version & ~VERSION_COMPRESSED_FLAG) == MsgVersionWithTraces()) {
+    frame.traceLength = ReadU32BE(buf);
+    if (frame.traceLength == 0 ||
+        frame.traceLength > frame.remainingLength - 4) {
       LOG_GENERAL(WARNING,
-                  "Invalid trace info length [" << trace_length << "]");
+                  "Invalid trace info length [" << frame.traceLength << "]");
       return ReadState::WRONG_TRACE_LENGTH;
     }
 
-    const char* trace_buf = reinterpret_cast<const char*>(
-        buf + length_of_remaining_message - trace_length);
-
-    result.traceInfo.assign(trace_buf, trace_length);
-
     buf += 4;
-    msg_length -= (4 + trace_length);
+    frame.messageLength -= (4 + frame.traceLength);
   }
 
   if (result.startByte == START_BYTE_BROADCAST) {
-    if (msg_length < HASH_LEN) {
-      LOG_GENERAL(WARNING,
-                  "Invalid broadcast message length [" << msg_length << "]");
+    if (frame.messageLength < HASH_LEN) {
+      LOG_GENERAL(WARNING, "Invalid broadcast message length ["
+                               << frame.messageLength << "]");
       return ReadState::WRONG_MESSAGE_LENGTH;
     }
 
     result.hash.assign(buf, buf + HASH_LEN);
+    frame.messageLength -= HASH_LEN;
+  }
+
+  return ReadState::SUCCESS;
+}
+
+ReadState TryReadMessage(const uint8_t* buf, size_t buf_size,
+                         ReadMessageResult& result) {
+  if (!buf || buf_size < HDR_LEN) {
+    LOG_GENERAL(WARNING, "Not enough data to read message header");
+    return ReadState::NOT_ENOUGH_DATA;
+  }
+
+  MessageFrame frame;
+  auto state = ReadFrameHeader(buf, frame, result);
+  if (state != ReadState::SUCCESS) {
+    return state;
+  }
+
+  if (buf_size < result.totalMessageBytes) {
+    return ReadState::NOT_ENOUGH_DATA;
+  }
+
+  buf += HDR_LEN;
+  state = ReadFramePrefix(buf, frame, result);
+  if (state != ReadState::SUCCESS) {
+    return state;
+  }
+
+  buf += frame.prefixLength;
+  if (frame.messageLength > 0) {
+    result.message.assign(buf, buf + frame.messageLength);
+  }
+  if (frame.compressed) {
+    state = DecompressMessage(result.message);
+    if (state != ReadState::SUCCESS) {
+      return state;
+    }
+  }
 
-    buf += HASH_LEN;
-    msg_length -= HASH_LEN;
+  if (frame.traceLength > 0) {
+    result.traceInfo.assign(
+        reinterpret_cast<const char*>(buf + frame.messageLength),
+        frame.traceLength);
   }
 
-  if (msg_length > 0) {
-    result.message.assign(buf, buf + msg_length);
+  return ReadState::SUCCESS;
+}
+
+ReadState DecompressMessage(zbytes& message) {
+  auto start = r_timer_start();
+
+  const auto* compressed = reinterpret_cast<const char*>(message.data());
+  size_t length = 0;
+  if (!snappy::GetUncompressedLength(compressed, message.size(), &length) ||
+      length > std::max(MAX_GOSSIP_MSG_SIZE_IN_BYTES,
+                        MAX_READ_WATERMARK_IN_BYTES)) {
+    LOG_GENERAL(WARNING, "Invalid compressed message of size ["
+                             << message.size() << "] expanding to [" << length
+                             << "]");
+    return ReadState::WRONG_COMPRESSION;
+  }
+
+  zbytes expanded(length);
+  if (!snappy::RawUncompress(compressed, message.size(),
+                             reinterpret_cast<char*>(expanded.data()))) {
+    LOG_GENERAL(WARNING, "Corrupt compressed message of size ["
+                             << message.size() << "]");
+    return ReadState::WRONG_COMPRESSION;
+  }
+
+  if (GetCompressionLatency().Enabled()) {
+    GetCompressionLatency().Record(r_timer_end(start) / 1000,
+                                   {{"op", "decompress"}});
+  }
+  if (GetCompressionRatio().Enabled() && length > 0) {
+    GetCompressionRatio().Record(double(message.size()) / length,
+                                 {{"type", "incoming"}});
   }
 
+  message.swap(expanded);
   return ReadState::SUCCESS;
 }
 
@@ -61,7 +61,8 @@ struct RawMessage {
 /* Wire format:
 
  1) Header: 4 bytes
-    VERSION:    1 byte              MSG_VERSION or MSG_VERSION_WITH_TRACES
+    VERSION:    1 byte              MSG_VERSION, plus 128 with traces and
+                                    plus 64 if the raw message is compressed
     NETWORK_ID: 2 bytes big endian  NETWORK_ID from constants.xml
     START_BYTE: 1 byte              START_BYTE_*, see above
 
@@ -73,23 +74,30 @@ struct RawMessage {
  3opt) Only if START_BYTE==START_BYTE_BROADCAST
        Hash: 32 bytes
 
- 3) Raw message
+ 3) Raw message, snappy compressed if flagged in VERSION
 
  4opt) Only if VERSION==MSG_VERSION_WITH_TRACES
        Trace information
 */
 
-/// Serializes a message
+/// Serializes a message, compressing it if P2P_COMPRESSION is on and it is
+/// a large message of a class listed in P2PMessage.cpp
 RawMessage CreateMessage(const zbytes& message, const zbytes& msg_hash,
                          uint8_t start_byte, bool inject_trace_context);
 
+/// Serializes a message, compressing it if asked to and that makes it smaller
+RawMessage CreateMessage(const zbytes& message, const zbytes& msg_hash,
+                         uint8_t start_byte, bool inject_trace_context,
+                         bool compress);
+
 enum class ReadState {
   NOT_ENOUGH_DATA,
   SUCCESS,
   WRONG_MSG_VERSION,
   WRONG_NETWORK_ID,
   WRONG_MESSAGE_LENGTH,
-  WRONG_TRACE_LENGTH
+  WRONG_TRACE_LENGTH,
+  WRONG_COMPRESSION
 };
 
 struct ReadMessageResult {
@@ -117,6 +125,40 @@ struct ReadMessageResult {
 ReadState TryReadMessage(const uint8_t* buf, size_t buf_size,
                          ReadMessageResult& result);
 
+/// Layout of a message being read piecewise off a socket, so that the raw
+/// message can be read straight into the buffer that gets dispatched
+struct MessageFrame {
+  uint8_t version = 0;
+
+  /// The raw message has to be passed to DecompressMessage once read
+  bool compressed = false;
+
+  /// Bytes following the header
+  uint32_t remainingLength = 0;
+
+  /// Bytes between the header and the raw message, i.e. trace size and hash
+  uint32_t prefixLength = 0;
+
+  /// Known once the prefix is read, the trace info follows the raw message
+  uint32_t messageLength = 0;
+  uint32_t traceLength = 0;
+};
+
+constexpr size_t MAX_PREFIX_LEN = 4 + HASH_LEN;
+
+/// Parses the HDR_LEN bytes of header, setting the start byte and total
+/// message bytes in result
+ReadState ReadFrameHeader(const uint8_t* buf, MessageFrame& frame,
+                          ReadMessageResult& result);
+
+/// Parses the frame.prefixLength bytes following the header, setting the
+/// hash in result
+ReadState ReadFramePrefix(const uint8_t* buf, MessageFrame& frame,
+                          ReadMessageResult& result);
+
+/// Replaces a compressed raw message with its expansion
+ReadState DecompressMessage(zbytes& message);
+
 inline std::shared_ptr<Message> MakeMsg(P2PConnPtr connection, zbytes msg,
                                         Peer peer, uint8_t startByte,
                                         std::string& traceContext) {
@@ -216,19 +216,12 @@ void P2PServerConnection::StartReading() {
 }
 
 void P2PServerConnection::ReadNextMessage() {
-  static constexpr size_t RESERVE_SIZE = 1024;
-  static constexpr size_t THRESHOLD_SIZE = 1024 * 100;
-
-  auto cap = m_readBuffer.capacity();
-  if (cap > THRESHOLD_SIZE) {
-    zbytes b;
-    m_readBuffer.swap(b);
-  }
-  m_readBuffer.reserve(RESERVE_SIZE);
-  m_readBuffer.resize(HDR_LEN);
+  // The raw message is read straight into the buffer that gets dispatched,
+  // the header and prefix around it into m_headerBuffer
+  m_readResult = std::make_unique<ReadMessageResult>(shared_from_this());
 
   boost::asio::async_read(
-      m_socket, boost::asio::buffer(m_readBuffer),
+      m_socket, boost::asio::buffer(m_headerBuffer.data(), HDR_LEN),
       [self = shared_from_this()](const ErrorCode& ec, size_t n) {
         if (!ec) {
           assert(n == HDR_LEN);
@@ -251,9 +244,8 @@ void P2PServerConnection::OnHeaderRead(const ErrorCode& ec) {
     return;
   }
 
-  assert(m_readBuffer.size() == HDR_LEN);
   m_last_time_packet_received = std::chrono::steady_clock::now();
-  auto remainingLength = ReadU32BE(m_readBuffer.data() + 4);
+  auto remainingLength = ReadU32BE(m_headerBuffer.data() + 4);
   if (remainingLength > m_maxMessageSize) {
     LOG_GENERAL(WARNING, "[blacklist] Encountered data of size: "
                              << remainingLength << " being received."
@@ -269,13 +261,60 @@ void P2PServerConnection::OnHeaderRead(const ErrorCode& ec) {
     return;
   }
 
-  m_readBuffer.resize(HDR_LEN + remainingLength);
+  if (ReadFrameHeader(m_headerBuffer.data(), m_frame, *m_readResult) !=
+      ReadState::SUCCESS) {
+    OnMalformedMessage();
+    return;
+  }
+
+  if (m_frame.prefixLength == 0) {
+    ReadBody();
+    return;
+  }
+
   boost::asio::async_read(
       m_socket,
-      boost::asio::buffer(m_readBuffer.data() + HDR_LEN, remainingLength),
+      boost::asio::buffer(m_headerBuffer.data() + HDR_LEN,
+                          m_frame.prefixLength),
+      [self = shared_from_this()](const ErrorCode& ec, size_t n) {
+        if (!ec) {
+          assert(n == self->m_frame.prefixLength);
+        }
+        if (ec != OPERATION_ABORTED) {
+          self->OnPrefixRead(ec);
+        }
+      });
+}
+
+void P2PServerConnection::OnPrefixRead(const ErrorCode& ec) {
+  if (ec) {
+    CloseSocket();
+    OnConnectionClosed();
+    return;
+  }
+
+  if (ReadFramePrefix(m_headerBuffer.data() + HDR_LEN, m_frame,
+                      *m_readResult) != ReadState::SUCCESS) {
+    OnMalformedMessage();
+    return;
+  }
+
+  ReadBody();
+}
+
+void P2PServerConnection::ReadBody() {
+  auto& message = m_readResult->message;
+  auto& traceInfo = m_readResult->traceInfo;
+  message.resize(m_frame.messageLength);
+  traceInfo.resize(m_frame.traceLength);
+
+  const std::array<boost::asio::mutable_buffer, 2> buffers{
+      boost::asio::buffer(message), boost::asio::buffer(traceInfo)};
+  boost::asio::async_read(
+      m_socket, buffers,
       [self = shared_from_this()](const ErrorCode& ec, size_t n) {
         if (!ec) {
-          assert(n == self->m_readBuffer.size() - HDR_LEN);
+          assert(n == self->m_frame.messageLength + self->m_frame.traceLength);
         }
         if (ec) {
           // LOG_GENERAL(WARNING, "Got error code: " << ec.message());
@@ -293,22 +332,15 @@ void P2PServerConnection::OnBodyRead(const ErrorCode& ec) {
     return;
   }
   m_last_time_packet_received = std::chrono::steady_clock::now();
-  ReadMessageResult result{shared_from_this()};
-  auto state = TryReadMessage(m_readBuffer.data(), m_readBuffer.size(), result);
-
-  if (state != ReadState::SUCCESS) {
-    LOG_GENERAL(WARNING, "Message deserialize error: blacklisting "
-                             << m_remotePeer.GetPrintableIPAddress());
-    Blacklist::GetInstance().Add({m_remotePeer.GetIpAddress(),
-                                  m_remotePeer.GetListenPortHost(),
-                                  m_remotePeer.GetNodeIndentifier()});
 
-    CloseSocket();
-    OnConnectionClosed();
+  if (m_frame.compressed &&
+      DecompressMessage(m_readResult->message) != ReadState::SUCCESS) {
+    OnMalformedMessage();
     return;
   }
+
   auto owner = m_owner.lock();
-  if (!owner || !owner->OnMessage(m_id, m_remotePeer, result)) {
+  if (!owner || !owner->OnMessage(m_id, m_remotePeer, *m_readResult)) {
     CloseSocket();
     OnConnectionClosed();
     return;
@@ -317,6 +349,17 @@ void P2PServerConnection::OnBodyRead(const ErrorCode& ec) {
   ReadNextMessage();
 }
 
+void P2PServerConnection::OnMalformedMessage() {
+  LOG_GENERAL(WARNING, "Message deserialize error: blacklisting "
+                           << m_remotePeer.GetPrintableIPAddress());
+  Blacklist::GetInstance().Add({m_remotePeer.GetIpAddress(),
+                                m_remotePeer.GetListenPortHost(),
+                                m_remotePeer.GetNodeIndentifier()});
+
+  CloseSocket();
+  OnConnectionClosed();
+}
+
 void P2PServerConnection::SetupHeartBeat() {
   ErrorCode ec;
   m_timer.cancel(ec);
@@ -17,6 +17,7 @@
 
 #include "P2PMessage.h"
 
+#include <array>
 #include <deque>
 
 #include <boost/asio/deadline_timer.hpp>
@@ -75,8 +76,14 @@ class P2PServerConnection
  private:
   void OnHeaderRead(const ErrorCode& ec);
 
+  void OnPrefixRead(const ErrorCode& ec);
+
+  void ReadBody();
+
   void OnBodyRead(const ErrorCode& ec);
 
+  void OnMalformedMessage();
+
   void ReadNextMessage();
 
   void SetupHeartBeat();
@@ -98,7 +105,9 @@ class P2PServerConnection
   bool m_is_marked_as_closed;
   size_t m_maxMessageSize;
   bool m_additionalServer;
-  zbytes m_readBuffer;
+  std::array<uint8_t, HDR_LEN + MAX_PREFIX_LEN> m_headerBuffer;
+  MessageFrame m_frame;
+  std::unique_ptr<ReadMessageResult> m_readResult;
   std::deque<RawMessage> m_sendQueue;
 };
 
@@ -129,12 +129,8 @@ static RumourManagerVariables variables{};
 RumorManager::RumorManager()
     : m_peerIdPeerBimap(),
       m_peerIdSet(),
-      m_rumorIdHashBimap(),
-      m_rumorHashRawMsgBimap(),
       m_selfPeer(),
       m_selfKey(),
-      m_rumorRawMsgTimestamp(),
-      m_rumorIdGenerator(0),
       m_mutex(),
       m_continueRoundMutex(),
       m_continueRound(false),
@@ -166,12 +162,16 @@ void RumorManager::StartRounds() {
                                       << result.first.size() << " peers");
 
         // Get the corresponding Peer to which to send Push Messages if any.
+        VectorOfPeer toPeers;
         for (const auto& i : result.first) {
           auto l = m_peerIdPeerBimap.left.find(i);
           if (l != m_peerIdPeerBimap.left.end()) {
-            SendMessages(l->second, result.second);
+            toPeers.emplace_back(l->second);
           }
         }
+        if (!toPeers.empty()) {
+          SendMessages(toPeers, result.second);
+        }
         if (++rounds % KEEP_RAWMSG_FROM_LAST_N_ROUNDS == 0) {
           CleanUp();
           rounds = 0;
@@ -212,18 +212,25 @@ bool RumorManager::Initialize(const VectorOfNode& peers, const Peer& myself,
 
   std::lock_guard<std::mutex> guard(m_mutex);  // critical section
 
-  if (m_rumorIdGenerator) {
+  if (m_rumorStore.LastId()) {
     PrintStatistics();
   }
 
-  m_rumorIdGenerator = 0;
+  // RawMessage older than below expiry will be cleared.
+  // Its calculated as (last KEEP_RAWMSG_FROM_LAST_N_ROUNDS rounds X each ROUND
+  // time), and counted in CleanUp calls, which come every
+  // KEEP_RAWMSG_FROM_LAST_N_ROUNDS rounds
+  const unsigned int rawMessageExpiryInRounds =
+      (KEEP_RAWMSG_FROM_LAST_N_ROUNDS < MAX_TOTAL_ROUNDS)
+          ? MAX_TOTAL_ROUNDS * 3
+          : KEEP_RAWMSG_FROM_LAST_N_ROUNDS;
+  m_rumorStore.Reset(rawMessageExpiryInRounds / KEEP_RAWMSG_FROM_LAST_N_ROUNDS +
+                     1);
+
   m_peerIdPeerBimap.clear();
-  m_rumorIdHashBimap.clear();
   m_peerIdSet.clear();
   m_selfPeer = myself;
   m_selfKey = myKeys;
-  m_rumorHashRawMsgBimap.clear();
-  m_rumorRawMsgTimestamp.clear();
   m_fullNetworkKeys.clear();
   m_pubKeyPeerBiMap.clear();
   m_hashesSubscriberMap.clear();
@@ -249,14 +256,6 @@ bool RumorManager::Initialize(const VectorOfNode& peers, const Peer& myself,
     m_rumorHolder.reset(new RRS::RumorHolder(m_peerIdSet, 0));
   }
 
-  // RawMessage older than below expiry will be cleared.
-  // Its calculated as (last KEEP_RAWMSG_FROM_LAST_N_ROUNDS rounds X each ROUND
-  // time)
-  m_rawMessageExpiryInMs = (KEEP_RAWMSG_FROM_LAST_N_ROUNDS < MAX_TOTAL_ROUNDS)
-                               ? MAX_TOTAL_ROUNDS * 3 * (ROUND_TIME_IN_MS)
-                               : KEEP_RAWMSG_FROM_LAST_N_ROUNDS *
-                                     (ROUND_TIME_IN_MS);  // milliseconds
-
   return true;
 }
 
@@ -329,11 +328,8 @@ bool RumorManager::AddForeignRumor(const RumorManager::RawBytes& message) {
 
 bool RumorManager::AddRumor(const RumorManager::RawBytes& message) {
   if (message.size() > 0 && message.size() <= MAX_GOSSIP_MSG_SIZE_IN_BYTES) {
-    RawBytes hash = SHA256Calculator::FromBytes(message);
-    std::string output;
-    if (!DataConversion::Uint8VecToHexStr(hash, output)) {
-      return false;
-    }
+    const RumorHash hash(SHA256Calculator::FromBytes(message));
+    const std::string output = hash.hex();
 
     {
       std::lock_guard<std::mutex> guard(m_continueRoundMutex);
@@ -355,30 +351,17 @@ bool RumorManager::AddRumor(const RumorManager::RawBytes& message) {
       return true;
     }
 
-    auto it = m_rumorIdHashBimap.right.find(hash);
-    if (it == m_rumorIdHashBimap.right.end()) {
-      m_rumorIdHashBimap.insert(
-          RumorIdRumorBimap::value_type(++m_rumorIdGenerator, hash));
-
-      auto result = m_rumorHashRawMsgBimap.insert(
-          RumorHashRumorBiMap::value_type(hash, message));
-
-      if (result.second) {
-        // add the timestamp for this raw rumor message
-        m_rumorRawMsgTimestamp.push_back(std::make_pair(
-            result.first, std::chrono::high_resolution_clock::now()));
-
-        std::string output;
-        if (!DataConversion::Uint8VecToHexStr(hash, output)) {
-          return false;
-        }
+    auto rumor = m_rumorStore.Add(hash);
+    if (rumor.second) {
+      if (m_rumorStore.SetPayload(hash,
+                                  std::make_shared<const RawBytes>(message))) {
         LOG_PAYLOAD(INFO,
                     "Initiated msg ("
-                        << m_selfPeer << "): [ RumorId: " << m_rumorIdGenerator
+                        << m_selfPeer << "): [ RumorId: " << rumor.first->id
                         << ", Round: 0, Hash: " << output.substr(0, 6) << " ]",
                     message, 10);
 
-        return m_rumorHolder->addRumor(m_rumorIdGenerator);
+        return m_rumorHolder->addRumor(rumor.first->id);
       }
     } else {
       LOG_GENERAL(DEBUG, "This Rumor was already received. No problem.");
@@ -579,25 +562,19 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
       LOG_CHECK_FAIL("Hash Size", message_wo_keysig.size(), COMMON_HASH_SIZE);
       return {false, {}};
     }
-    auto it = m_rumorIdHashBimap.right.find(message_wo_keysig);
-    if (it == m_rumorIdHashBimap.right.end()) {
-      recvdRumorId = ++m_rumorIdGenerator;
-
-      m_rumorIdHashBimap.insert(
-          RumorIdRumorBimap::value_type(recvdRumorId, message_wo_keysig));
-
+    auto rumor = m_rumorStore.Add(RumorHash(message_wo_keysig));
+    recvdRumorId = rumor.first->id;
+    if (rumor.second) {
       // Now that's the new hash message. So we dont have the real message.
       // So lets ask the sender for it.
       RRS::Message pullMsg(RRS::Message::Type::PULL, recvdRumorId, -1);
       SendMessage(from, pullMsg);
     } else {
-      recvdRumorId = it->second;
       LOG_GENERAL(DEBUG, "Old Gossip hash message received from "
                              << from << ". [ RumorId: " << recvdRumorId
                              << ", Current Round: " << round);
       // check if we have received the real message for this old rumor.
-      auto it = m_rumorHashRawMsgBimap.left.find(message_wo_keysig);
-      if (it == m_rumorHashRawMsgBimap.left.end()) {
+      if (!rumor.first->payload) {
         // didn't receive real message (PUSH) yet :( Lets ask this peer.
         RRS::Message pullMsg(RRS::Message::Type::PULL, recvdRumorId, -1);
         SendMessage(from, pullMsg);
@@ -605,55 +582,46 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
     }
   } else if (RRS::Message::Type::PULL == t) {
     // Now that sender wants the real message, lets send it to him.
-    auto it1 = m_rumorHashRawMsgBimap.left.find(message_wo_keysig);
-    if (it1 != m_rumorHashRawMsgBimap.left.end()) {
-      auto it2 = m_rumorIdHashBimap.right.find(message_wo_keysig);
-      if (it2 != m_rumorIdHashBimap.right.end()) {
-        recvdRumorId = it2->second;
-        RRS::Message pushMsg(RRS::Message::Type::PUSH, recvdRumorId, -1);
-        SendMessage(from, pushMsg);
-      }
+    if (message_wo_keysig.size() != COMMON_HASH_SIZE) {
+      LOG_CHECK_FAIL("Hash Size", message_wo_keysig.size(), COMMON_HASH_SIZE);
+      return {false, {}};
+    }
+    const RumorHash hash(message_wo_keysig);
+    const auto* rumor = m_rumorStore.Find(hash);
+    if (rumor != nullptr && rumor->payload) {
+      recvdRumorId = rumor->id;
+      RRS::Message pushMsg(RRS::Message::Type::PUSH, recvdRumorId, -1);
+      SendMessage(from, pushMsg);
     } else  // I dont have it as of now. Add this peer to subscriber list for
             // this hash message.
     {
-      auto it2 = m_hashesSubscriberMap.find(message_wo_keysig);
-      if (it2 == m_hashesSubscriberMap.end()) {
-        m_hashesSubscriberMap.insert(RumorHashesPeersMap::value_type(
-            message_wo_keysig, std::set<Peer>()));
-      }
-      m_hashesSubscriberMap[message_wo_keysig].insert(from);
+      m_hashesSubscriberMap[hash].insert(from);
     }
     return {false, {}};
   } else if (RRS::Message::Type::PUSH == t) {
     // I got it from my peer for what i asked him
-    RawBytes hash;
     if (message_wo_keysig.size() >
         0)  // if someone malaciously sends empty message, sha2 will assert fail
     {
-      hash = SHA256Calculator::FromBytes(message_wo_keysig);
-      std::string hashStr;
-      DataConversion::Uint8VecToHexStr(hash, hashStr);
+      const RumorHash hash(SHA256Calculator::FromBytes(message_wo_keysig));
+      const std::string hashStr = hash.hex();
 
-      auto it1 = m_rumorIdHashBimap.right.find(hash);
-      if (it1 != m_rumorIdHashBimap.right.end()) {
-        recvdRumorId = it1->second;
+      const auto* rumor = m_rumorStore.Find(hash);
+      if (rumor != nullptr) {
+        recvdRumorId = rumor->id;
       } else {
         // I have not asked for this raw message.. so ignoring
         return {false, {}};
       }
 
       // toBeDispatched
-      auto result1 = m_rumorHashRawMsgBimap.insert(
-          RumorHashRumorBiMap::value_type(hash, message_wo_keysig));
-      if (result1.second) {
+      if (m_rumorStore.SetPayload(
+              hash, std::make_shared<const RawBytes>(message_wo_keysig))) {
         LOG_PAYLOAD(
             INFO,
             "New msg for hash [" << hashStr.substr(0, 6) << "] from " << from,
             message_wo_keysig, Logger::MAX_BYTES_TO_DISPLAY);
         toBeDispatched = true;
-        // add the timestamp for this raw rumor message
-        m_rumorRawMsgTimestamp.push_back(std::make_pair(
-            result1.first, std::chrono::high_resolution_clock::now()));
       } else {
         LOG_PAYLOAD(DEBUG,
                     "Old Gossip Raw message received from Peer: "
@@ -670,13 +638,17 @@ std::pair<bool, RumorManager::RawBytes> RumorManager::RumorReceived(
             DEBUG,
             "Sending Gossip Raw Message to subscribers of Gossip_Message_Hash: "
                 << hashStr.substr(0, 6));
+        VectorOfPeer subscribers;
         for (auto& p : it2->second) {
           // avoid un-neccessarily sending again back to sender itself
           if (p == from) {
             continue;
           }
+          subscribers.emplace_back(p);
+        }
+        if (!subscribers.empty()) {
           RRS::Message pushMsg(RRS::Message::Type::PUSH, recvdRumorId, -1);
-          SendMessage(p, pushMsg);
+          SendMessage(subscribers, pushMsg);
         }
         m_hashesSubscriberMap.erase(hash);
       }
@@ -726,13 +698,11 @@ void RumorManager::AppendKeyAndSignature(RawBytes& result,
   result.insert(result.end(), tmp.begin(), tmp.end());
 }
 
-void RumorManager::SendMessage(const Peer& toPeer,
-                               const RRS::Message& message) {
-  zil::local::variables.AddSendMessage(1);
-
+bool RumorManager::GenerateGossipMessage(const RRS::Message& message,
+                                         RawBytes& cmd) {
   // Add round and type to outgoing message
   RRS::Message::Type t = message.type();
-  RawBytes cmd = {(unsigned char)t};
+  cmd = {(unsigned char)t};
   unsigned int cur_offset = RRSMessageOffset::R_ROUNDS;
 
   Serializable::SetNumber<uint32_t>(cmd, cur_offset, message.rounds(),
@@ -746,44 +716,39 @@ void RumorManager::SendMessage(const Peer& toPeer,
   if (!(RRS::Message::Type::EMPTY_PUSH == t ||
         RRS::Message::Type::EMPTY_PULL == t)) {
     // Get the hash messages based on rumor id.
-    auto it1 = m_rumorIdHashBimap.left.find(message.rumorId());
-    if (it1 != m_rumorIdHashBimap.left.end()) {
+    const auto* hash = m_rumorStore.FindHash(message.rumorId());
+    if (hash != nullptr) {
       if (RRS::Message::Type::PUSH == t) {
         // Get the raw message based on hash
-        auto it2 = m_rumorHashRawMsgBimap.left.find(it1->second);
-        if (it2 != m_rumorHashRawMsgBimap.left.end()) {
+        const auto* rumor = m_rumorStore.Find(*hash);
+        if (rumor != nullptr && rumor->payload) {
+          const RumorStore::Payload payload = rumor->payload;
           if (SIGN_VERIFY_NONEMPTY_MSGTYP) {
             // Add pubkey and signature before message body
-            AppendKeyAndSignature(cmd, it2->second);
+            AppendKeyAndSignature(cmd, *payload);
           }
 
           // Add raw message to outgoing message
-          cmd.insert(cmd.end(), it2->second.begin(), it2->second.end());
-          std::string gossipHashStr;
-          if (!DataConversion::Uint8VecToHexStr(it1->second, gossipHashStr)) {
-            return;
-          }
-          LOG_GENERAL(INFO, "Sending [" << gossipHashStr.substr(0, 6) << "] to "
-                                        << toPeer);
+          cmd.insert(cmd.end(), payload->begin(), payload->end());
+          LOG_GENERAL(INFO, "Sending [" << hash->hex().substr(0, 6) << "]");
         } else {
           // Nothing to send.
-          return;
+          return false;
         }
       } else if (RRS::Message::Type::LAZY_PUSH == t ||
                  RRS::Message::Type::LAZY_PULL == t ||
                  RRS::Message::Type::PULL == t) {
         if (SIGN_VERIFY_NONEMPTY_MSGTYP) {
           // Add pubkey and signature before message body
-          AppendKeyAndSignature(cmd, it1->second);
+          AppendKeyAndSignature(cmd, hash->asBytes());
         }
 
         // Add hash message to outgoing message for types
         // LAZY_PULL/LAZY_PUSH/PULL
-        cmd.insert(cmd.end(), it1->second.begin(), it1->second.end());
-        LOG_GENERAL(DEBUG, "Sending Gossip Hash Message: "
-                               << message << " To Peer : " << toPeer);
+        cmd.insert(cmd.end(), hash->begin(), hash->end());
+        LOG_GENERAL(DEBUG, "Sending Gossip Hash Message: " << message);
       } else {
-        return;
+        return false;
       }
     }
   } else {  // EMPTY_PULL/ EMPTY_PUSH
@@ -796,26 +761,45 @@ void RumorManager::SendMessage(const Peer& toPeer,
     }
   }
 
-  // Send the message to peer .
+  return true;
+}
+
+void RumorManager::SendMessage(const VectorOfPeer& toPeers,
+                               const RRS::Message& message) {
+  zil::local::variables.AddSendMessage(1);
+
+  // Composed and signed once, the serialized message is shared by all peers
+  RawBytes cmd;
+  if (!GenerateGossipMessage(message, cmd)) {
+    return;
+  }
+
+  // Send the message to peers.
   if (SIMULATED_NETWORK_DELAY_IN_MS > 0) {
     std::this_thread::sleep_for(
         std::chrono::milliseconds(SIMULATED_NETWORK_DELAY_IN_MS));
   }
-  zil::p2p::GetInstance().SendMessage(nullptr, toPeer, cmd,
+  LOG_GENERAL(DEBUG, "Sending " << message << " to " << toPeers.size()
+                                << " peer(s)");
+  zil::p2p::GetInstance().SendMessage(toPeers, cmd,
                                       zil::p2p::START_BYTE_GOSSIP);
 }
 
-void RumorManager::SendMessages(const Peer& toPeer,
+void RumorManager::SendMessage(const Peer& toPeer,
+                               const RRS::Message& message) {
+  SendMessage(VectorOfPeer{toPeer}, message);
+}
+
+void RumorManager::SendMessages(const VectorOfPeer& toPeers,
                                 const std::vector<RRS::Message>& messages) {
-  zil::local::variables.AddSendMessage(1);
   for (auto& k : messages) {
-    SendMessage(toPeer, k);
+    SendMessage(toPeers, k);
   }
 }
 
-// PUBLIC CONST METHODS
-const RumorManager::RumorIdRumorBimap& RumorManager::rumors() const {
-  return m_rumorIdHashBimap;
+void RumorManager::SendMessages(const Peer& toPeer,
+                                const std::vector<RRS::Message>& messages) {
+  SendMessages(VectorOfPeer{toPeer}, messages);
 }
 
 void RumorManager::PrintStatistics() {
@@ -823,9 +807,9 @@ void RumorManager::PrintStatistics() {
   // in network.
   for (const auto& i : m_rumorHolder->rumorsMap()) {
     uint32_t rumorId = i.first;
-    auto it = m_rumorIdHashBimap.left.find(rumorId);
-    if (it != m_rumorIdHashBimap.left.end()) {
-      zbytes this_msg_hash = SHA256Calculator::FromBytes(it->second);
+    const auto* hash = m_rumorStore.FindHash(rumorId);
+    if (hash != nullptr) {
+      zbytes this_msg_hash = SHA256Calculator::FromBytes(hash->asBytes());
       const RRS::RumorStateMachine& state = i.second;
       std::string gossipHashStr;
       if (!DataConversion::Uint8VecToHexStr(this_msg_hash, gossipHashStr)) {
@@ -839,27 +823,7 @@ void RumorManager::PrintStatistics() {
 }
 
 void RumorManager::CleanUp() {
-  int count = 0;
-  auto now = std::chrono::high_resolution_clock::now();
-  while (!m_rumorRawMsgTimestamp.empty()) {
-    auto elapsed_milliseconds =
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            now - m_rumorRawMsgTimestamp.front().second)
-            .count();
-    LOG_GENERAL(DEBUG, "elapsed_milliseconds:" << elapsed_milliseconds
-                                               << " , m_rawMessageExpiryInMs:"
-                                               << m_rawMessageExpiryInMs);
-    if (elapsed_milliseconds > m_rawMessageExpiryInMs) {  // older
-      auto hash = m_rumorRawMsgTimestamp.front().first->left;
-      m_rumorHashRawMsgBimap.erase(m_rumorRawMsgTimestamp.front().first);
-
-      m_rumorIdHashBimap.right.erase(hash);
-      m_rumorRawMsgTimestamp.pop_front();
-      count++;
-    } else {
-      break;  // other in deque are definately not older. so quit loop
-    }
-  }
+  const auto count = m_rumorStore.Expire();
   if (count != 0) {
     LOG_GENERAL(INFO, "Cleaned " << count << " messages");
   }
@@ -23,10 +23,12 @@
 #include <deque>
 #include <map>
 #include <mutex>
+#include <set>
 #include <unordered_map>
 
 #include <Schnorr.h>
 #include "Peer.h"
+#include "RumorStore.h"
 #include "ShardStruct.h"
 #include "libRumorSpreading/RumorHolder.h"
 
@@ -45,12 +47,7 @@ class RumorManager {
  private:
   // TYPES
   typedef boost::bimap<int, Peer> PeerIdPeerBiMap;
-  typedef boost::bimap<int, RawBytes> RumorIdRumorBimap;
-  typedef boost::bimap<RawBytes, RawBytes> RumorHashRumorBiMap;
-  typedef std::map<RawBytes, std::set<Peer>> RumorHashesPeersMap;
-  typedef std::deque<std::pair<RumorHashRumorBiMap::iterator,
-                               std::chrono::high_resolution_clock::time_point>>
-      RumorRawMsgTimestampDeque;
+  typedef std::unordered_map<RumorHash, std::set<Peer>> RumorHashesPeersMap;
   typedef boost::bimap<PubKey, Peer> PubKeyPeerBiMap;
 
   // MEMBERS
@@ -58,28 +55,30 @@ class RumorManager {
   PeerIdPeerBiMap m_peerIdPeerBimap;
   PubKeyPeerBiMap m_pubKeyPeerBiMap;
   std::unordered_set<int> m_peerIdSet;
-  RumorIdRumorBimap m_rumorIdHashBimap;
-  RumorHashRumorBiMap m_rumorHashRawMsgBimap;
+  RumorStore m_rumorStore;
   RumorHashesPeersMap m_hashesSubscriberMap;
   Peer m_selfPeer;
   PairOfKey m_selfKey;
   std::vector<RawBytes> m_bufferRawMsg;
-  RumorRawMsgTimestampDeque m_rumorRawMsgTimestamp;
   std::vector<PubKey> m_fullNetworkKeys;
 
-  int64_t m_rumorIdGenerator;
   std::mutex m_mutex;
   std::mutex m_continueRoundMutex;
   std::atomic<bool> m_continueRound;
   std::condition_variable m_condStopRound;
 
-  int32_t m_rawMessageExpiryInMs{};
-
   void SendMessages(const Peer& toPeer,
                     const std::vector<RRS::Message>& messages);
 
+  void SendMessages(const VectorOfPeer& toPeers,
+                    const std::vector<RRS::Message>& messages);
+
   void SendMessage(const Peer& toPeer, const RRS::Message& message);
 
+  void SendMessage(const VectorOfPeer& toPeers, const RRS::Message& message);
+
+  bool GenerateGossipMessage(const RRS::Message& message, RawBytes& cmd);
+
   RawBytes GenerateGossipForwardMessage(const RawBytes& message);
 
  public:
@@ -124,8 +123,6 @@ class RumorManager {
   void AppendKeyAndSignature(RawBytes& result, const RawBytes& messageToSig);
 
   void UpdatePeerInfo(const Peer& newPeerInfo, const PubKey& pubKey);
-  // CONST METHODS
-  const RumorIdRumorBimap& rumors() const;
 };
 
 #endif  // ZILLIQA_SRC_LIBNETWORK_RUMORMANAGER_H_
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBNETWORK_RUMORSTORE_H_
+#define ZILLIQA_SRC_LIBNETWORK_RUMORSTORE_H_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/BaseType.h"
+#include "common/Hashes.h"
+
+using RumorHash = dev::h256;
+
+// Rumors a node knows of, keyed by the SHA256 of their payload. A rumor is
+// known by its hash first (from a LAZY_PUSH/LAZY_PULL) and gets its payload
+// once it is pushed; payloads are held once and shared with whoever sends
+// them. Rumors with a payload expire after a fixed number of ticks, kept on a
+// timer wheel so that a tick only visits what expires on it.
+class RumorStore {
+ public:
+  using Payload = std::shared_ptr<const zbytes>;
+
+  struct Rumor {
+    int64_t id;
+    Payload payload;
+  };
+
+  // Empties the store and restarts ids from 1; payloads set from now on
+  // live for expiryTicks calls to Expire.
+  void Reset(unsigned int expiryTicks) {
+    m_rumors.clear();
+    m_hashes.clear();
+    m_wheel.assign(expiryTicks + 1, {});
+    m_tick = 0;
+    m_lastId = 0;
+  }
+
+  // Id of the last rumor added, 0 if none
+  int64_t LastId() const { return m_lastId; }
+
+  Rumor* Find(const RumorHash& hash) {
+    auto it = m_rumors.find(hash);
+    return it == m_rumors.end() ? nullptr : &it->second;
+  }
+
+  const RumorHash* FindHash(int64_t id) const {
+    auto it = m_hashes.find(id);
+    return it == m_hashes.end() ? nullptr : &it->second;
+  }
+
+  // Adds a rumor under a new id, or returns the one known by that hash.
+  std::pair<Rumor*, bool> Add(const RumorHash& hash) {
+    auto result = m_rumors.emplace(hash, Rumor{m_lastId + 1, nullptr});
+    if (result.second) {
+      m_hashes.emplace(++m_lastId, hash);
+    }
+    return {&result.first->second, result.second};
+  }
+
+  // Gives a rumor its payload and starts its expiry. Fails if the rumor
+  // is unknown or already has one.
+  bool SetPayload(const RumorHash& hash, Payload payload) {
+    auto it = m_rumors.find(hash);
+    if (it == m_rumors.end() || it->second.payload || m_wheel.empty()) {
+      return false;
+    }
+    it->second.payload = std::move(payload);
+    const auto expiryTicks = m_wheel.size() - 1;
+    m_wheel.at((m_tick + expiryTicks) % m_wheel.size())
+        .emplace_back(hash, it->second.id);
+    return true;
+  }
+
+  // Moves the wheel on one tick and forgets the rumors whose payload
+  // expires on it. Returns the number of rumors forgotten.
+  std::size_t Expire() {
+    if (m_wheel.empty()) {
+      return 0;
+    }
+    m_tick = (m_tick + 1) % m_wheel.size();
+
+    std::size_t count = 0;
+    for (const auto& expiring : m_wheel.at(m_tick)) {
+      // The hash may have expired before and come back under a new id
+      auto it = m_rumors.find(expiring.first);
+      if (it != m_rumors.end() && it->second.id == expiring.second) {
+        m_hashes.erase(it->second.id);
+        m_rumors.erase(it);
+        count++;
+      }
+    }
+    m_wheel.at(m_tick).clear();
+    return count;
+  }
+
+  std::size_t size() const { return m_rumors.size(); }
+
+ private:
+  std::unordered_map<RumorHash, Rumor> m_rumors;
+  std::unordered_map<int64_t, RumorHash> m_hashes;
+  std::vector<std::vector<std::pair<RumorHash, int64_t>>> m_wheel;
+  std::size_t m_tick{0};
+  int64_t m_lastId{0};
+};
+
+#endif  // ZILLIQA_SRC_LIBNETWORK_RUMORSTORE_H_
@@ -527,8 +527,9 @@ class PeerSendQueue : public std::enable_shared_from_this<PeerSendQueue> {
 
     if (state == ReadState::SUCCESS) {
       if (result.startByte == START_BYTE_NORMAL) {
-        m_readMsgDispatcher(MakeMsg(nullptr, result.message, m_peer,
-                                    START_BYTE_NORMAL, result.traceInfo));
+        m_readMsgDispatcher(MakeMsg(nullptr, std::move(result.message),
+                                    m_peer, START_BYTE_NORMAL,
+                                    result.traceInfo));
       } else {
         LOG_GENERAL(WARNING, "Skipping msg because of start byte which is: "
                                  << static_cast<int>(result.startByte));
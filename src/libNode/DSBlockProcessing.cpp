@@ -400,9 +400,9 @@ bool Node::ProcessVCDSBlocksMessage(
   // Check timestamp (must be greater than timestamp of last Tx block header in
   // the Tx blockchain)
   if (m_mediator.m_txBlockChain.GetBlockCount() > 0) {
-    const TxBlock& lastTxBlock = m_mediator.m_txBlockChain.GetLastBlock();
+    const auto lastTxBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
     uint64_t thisDSTimestamp = dsblock.GetTimestamp();
-    uint64_t lastTxBlockTimestamp = lastTxBlock.GetTimestamp();
+    uint64_t lastTxBlockTimestamp = lastTxBlock->GetTimestamp();
     if (thisDSTimestamp <= lastTxBlockTimestamp) {
       LOG_GENERAL(WARNING, "Timestamp check failed. Last Tx Block: "
                                << lastTxBlockTimestamp
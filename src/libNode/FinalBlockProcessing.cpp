@@ -161,6 +161,7 @@ bool Node::StoreFinalBlock(const TxBlock& txBlock) {
     LOG_GENERAL(WARNING, "BlockStorage::PutTxBlock failed " << txBlock);
     return false;
   }
+  BlockStorage::GetBlockStorage().CommitBlockWrites();
 
   // Update average block time except when txblock is first block for the epoch
   if ((txBlock.GetHeader().GetBlockNum() % NUM_FINAL_BLOCK_PER_POW) > 0) {
@@ -1134,6 +1135,7 @@ bool Node::ProcessFinalBlockCore(uint64_t& dsBlockNumber,
     LOG_GENERAL(WARNING, "BlockStorage::PutStateDelta failed");
     return false;
   }
+  BlockStorage::GetBlockStorage().CommitBlockWrites();
 
   if (!LOOKUP_NODE_MODE &&
       (!CheckStateRoot(txBlock) || m_doRejoinAtStateRoot)) {
@@ -1306,12 +1308,7 @@ void Node::SendTxnMemPoolToNextLayer() {
   LOG_MARKER();
   // Only used in pure lookups
   if (!ARCHIVAL_LOOKUP && LOOKUP_NODE_MODE) {
-    std::vector<Transaction> txnsInMemPool;
-    {
-      lock_guard<mutex> g(m_mediator.m_lookup->m_txnMemPoolMutex);
-      txnsInMemPool = m_mediator.m_lookup->GetTransactionsFromMemPool();
-      m_mediator.m_lookup->ClearTxnMemPool();
-    }
+    auto txnsInMemPool = m_mediator.m_lookup->DrainTxnMemPool();
 
     if (std::empty(txnsInMemPool)) {
       LOG_GENERAL(INFO, "Txn pool is empty - nothing to send to ds nodes");
@@ -1431,6 +1428,7 @@ void Node::CommitForwardedTransactions(const MBnForwardedTxnEntry& entry) {
       }
     }
   }
+  BlockStorage::GetBlockStorage().CommitBlockWrites();
 
   if (!ARCHIVAL_LOOKUP && REMOTESTORAGE_DB_ENABLE) {
     auto mongoInsertFunc = [transactions = entry.m_transactions,
@@ -1921,17 +1919,17 @@ bool Node::ProcessMBnForwardTransactionCore(const MBnForwardedTxnEntry& entry) {
 
       if (ENABLE_WEBSOCKET) {
         // send tx block and attach txhashes
-        const TxBlock& txBlock = m_mediator.m_txBlockChain.GetLastBlock();
+        const auto txBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
         Json::Value j_txnhashes;
         try {
-          j_txnhashes = LookupServer::GetTransactionsForTxBlock(txBlock);
+          j_txnhashes = LookupServer::GetTransactionsForTxBlock(*txBlock);
         } catch (...) {
           j_txnhashes = Json::arrayValue;
         }
 
         // sends out everything to subscriptions
         m_mediator.m_websocketServer->FinalizeTxBlock(
-            JSONConversion::convertTxBlocktoJson(txBlock), j_txnhashes);
+            JSONConversion::convertTxBlocktoJson(*txBlock), j_txnhashes);
       }
     }
   }
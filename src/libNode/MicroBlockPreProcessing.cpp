@@ -16,6 +16,7 @@
  */
 
 #include <boost/pool/pool_alloc.hpp>
+#include <unordered_set>
 
 #include "Node.h"
 #include "RootComputation.h"
@@ -26,6 +27,7 @@
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionReceipt.h"
 #include "libData/AccountData/TxnOrderVerifier.h"
+#include "libData/AccountData/TxnReadyQueue.h"
 #include "libData/AccountStore/AccountStore.h"
 #include "libData/CoinbaseData/RewardControlContractState.h"
 #include "libMediator/Mediator.h"
@@ -384,7 +386,7 @@ void Node::ProcessTransactionWhenShardLeader(
     t_createdTxns = m_createdTxns;
   }
 
-  map<Address, map<uint64_t, Transaction>> t_addrNonceTxnMap;
+  TxnReadyQueue t_addrNonceTxnMap;
   t_processedTransactions.clear();
   m_TxnOrder.clear();
 
@@ -398,29 +400,23 @@ void Node::ProcessTransactionWhenShardLeader(
 
   this_thread::sleep_for(chrono::milliseconds(100));
 
-  auto findOneFromAddrNonceTxnMap =
-      [](Transaction& t,
-         map<Address, map<uint64_t, Transaction>>& t_addrNonceTxnMap) -> bool {
-    for (auto it = t_addrNonceTxnMap.begin(); it != t_addrNonceTxnMap.end();
-         it++) {
-      if (it->second.begin()->first ==
-          AccountStore::GetInstance().GetNonceTemp(it->first) + 1) {
-        t = std::move(it->second.begin()->second);
-        it->second.erase(it->second.begin());
-
-        if (it->second.empty()) {
-          t_addrNonceTxnMap.erase(it);
-        }
-        return true;
-      }
-    }
-    return false;
+  auto getExpectedNonce = [](const Address& addr) -> uint128_t {
+    return AccountStore::GetInstance().GetNonceTemp(addr) + 1;
   };
 
-  auto appendOne = [this](const Transaction& t, const TransactionReceipt& tr) {
+  // Once a txn of a sender has been applied, its next queued txn may have
+  // become runnable
+  auto promoteSender = [&t_addrNonceTxnMap,
+                        &getExpectedNonce](const Address& senderAddr) {
+    t_addrNonceTxnMap.promote(senderAddr, getExpectedNonce(senderAddr));
+  };
+
+  auto appendOne = [this, &promoteSender](const Transaction& t,
+                                          const TransactionReceipt& tr) {
     t_processedTransactions.insert(
         make_pair(t.GetTranID(), TransactionWithReceipt(t, tr)));
     m_TxnOrder.push_back(t.GetTranID());
+    promoteSender(t.GetSenderAddr());
   };
 
   m_gasUsedTotal = 0;
@@ -434,6 +430,156 @@ void Node::ProcessTransactionWhenShardLeader(
   unsigned int count_createdTxns = 0;
   uint32_t highNonce = 0;
 
+  // Books an executed txn, returns false if txn processing has to stop
+  auto commitOne = [this, &appendOne](const Transaction& txn,
+                                      const TransactionReceipt& txnReceipt) {
+    if (!SafeMath<uint64_t>::add(m_gasUsedTotal, txnReceipt.GetCumGas(),
+                                 m_gasUsedTotal)) {
+      LOG_GENERAL(WARNING, "m_gasUsedTotal addition unsafe!");
+      return false;
+    }
+    uint128_t txnFee;
+    if (!SafeMath<uint128_t>::mul(txnReceipt.GetCumGas(), txn.GetGasPriceQa(),
+                                  txnFee)) {
+      LOG_GENERAL(WARNING, "txnFee multiplication unsafe!");
+      return true;
+    }
+    if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
+      LOG_GENERAL(WARNING, "m_txnFees addition unsafe!");
+      return false;
+    }
+    appendOne(txn, txnReceipt);
+    return true;
+  };
+
+  auto dropOne = [&droppedTxns, &promoteSender](const Transaction& txn,
+                                                const TxnStatus& error_code) {
+    LOG_GENERAL(DEBUG, "Adding to dropped Txns failed transaction with id: "
+                           << txn.GetTranID());
+    droppedTxns.emplace_back(txn.GetTranID(), error_code);
+    promoteSender(txn.GetSenderAddr());
+  };
+
+  // Txns taken from t_addrNonceTxnMap but not processed go back there, so
+  // that they are reinstated into the mempool
+  auto requeue = [&t_addrNonceTxnMap, &getExpectedNonce](const Transaction& t,
+                                                         bool fromQueue) {
+    if (fromQueue) {
+      t_addrNonceTxnMap.insert(t, getExpectedNonce(t.GetSenderAddr()));
+    }
+  };
+
+  // With SPECULATIVE_TXN_EXECUTION, consecutive plain transfers touching
+  // disjoint accounts are deferred here and run together on worker threads.
+  // The batch is flushed, in the order its txns were picked, before anything
+  // that could observe their effects is looked at, so m_TxnOrder and the state
+  // delta are the same as when running them one at a time.
+  vector<SpeculativeTransfer> specTransfers;
+  vector<bool> specFromQueue;
+  unordered_set<Address> specTouched;
+
+  auto flushTransfers = [&]() -> bool {
+    if (specTransfers.empty()) {
+      return true;
+    }
+
+    AccountStore::GetInstance().SpeculateTransfersTemp(
+        m_mediator.m_currentEpochNum, specTransfers);
+
+    bool proceed = true;
+    bool serial = false;
+    size_t i = 0;
+    for (; i < specTransfers.size() && proceed; ++i) {
+      const auto& transfer = specTransfers[i];
+      const Transaction& txn = transfer.transaction;
+      TransactionReceipt txnReceipt;
+      TxnStatus error_code;
+
+      if (transfer.clean && !serial) {
+        AccountStore::GetInstance().CommitSpeculativeTransferTemp(transfer);
+        proceed = commitOne(txn, transfer.receipt);
+        continue;
+      }
+
+      // Sending to an EVM contract runs its code, which may touch the
+      // accounts of the remaining transfers, so run those serially too
+      serial = serial || transfer.contractRecipient;
+      if (m_mediator.m_validator->CheckCreatedTransaction(txn, txnReceipt,
+                                                          error_code)) {
+        proceed = commitOne(txn, txnReceipt);
+      } else {
+        dropOne(txn, error_code);
+      }
+    }
+    for (; i < specTransfers.size(); ++i) {
+      requeue(specTransfers[i].transaction, specFromQueue[i]);
+    }
+
+    LOG_GENERAL(DEBUG, "Flushed " << specTransfers.size()
+                                  << " speculative transfers");
+    specTransfers.clear();
+    specFromQueue.clear();
+    specTouched.clear();
+    return proceed;
+  };
+
+  auto addTransfer = [&](const Transaction& txn, bool fromQueue) -> bool {
+    specTransfers.emplace_back(txn);
+    specFromQueue.push_back(fromQueue);
+    specTouched.insert(txn.GetSenderAddr());
+    specTouched.insert(txn.GetToAddr());
+
+    // The sender's next queued txn can only be picked once this one has run
+    if (t_addrNonceTxnMap.PendingIndex.count(txn.GetSenderAddr()) > 0 ||
+        specTransfers.size() >= SPECULATIVE_TXN_BATCH_SIZE) {
+      return flushTransfers();
+    }
+    return true;
+  };
+
+  // Upper bound of the gas the deferred transfers will use
+  auto specGas = [&specTransfers]() -> uint64_t {
+    return specTransfers.size() * NORMAL_TRAN_GAS;
+  };
+
+  // Runs a txn with the expected nonce, returns false if txn processing has to
+  // stop
+  auto processOne = [&](const Transaction& txn, bool fromQueue) -> bool {
+    if (!specTransfers.empty() &&
+        m_gasUsedTotal + specGas() + txn.GetGasLimitZil() >
+            microblock_gas_limit &&
+        !flushTransfers()) {
+      requeue(txn, fromQueue);
+      return false;
+    }
+
+    if (m_gasUsedTotal + txn.GetGasLimitZil() > microblock_gas_limit) {
+      LOG_GENERAL(WARNING, "Gas limit exceeded = " << txn.GetTranID());
+      LOG_GENERAL(WARNING, "m_gasUsedTotal     = " << m_gasUsedTotal);
+      LOG_GENERAL(WARNING, "t.GetGasLimitZil      = " << txn.GetGasLimitZil());
+      gasLimitExceededTxnBuffer.emplace_back(txn);
+      return true;
+    }
+
+    if (SPECULATIVE_TXN_EXECUTION && SpeculativeTransfer::IsCandidate(txn)) {
+      return addTransfer(txn, fromQueue);
+    }
+
+    if (!flushTransfers()) {
+      requeue(txn, fromQueue);
+      return false;
+    }
+
+    TransactionReceipt txnReceipt;
+    TxnStatus error_code;
+    if (m_mediator.m_validator->CheckCreatedTransaction(txn, txnReceipt,
+                                                        error_code)) {
+      return commitOne(txn, txnReceipt);
+    }
+    dropOne(txn, error_code);
+    return true;
+  };
+
   AccountStore::GetInstance().CleanStorageRootUpdateBufferTemp();
 
   LOG_GENERAL(INFO, "microblock_gas_limit = " << microblock_gas_limit);
@@ -441,54 +587,39 @@ void Node::ProcessTransactionWhenShardLeader(
   while (m_gasUsedTotal < microblock_gas_limit) {
     if (txnProcTimeout) {
       LOG_GENERAL(INFO, "txnProcTimeout is set!");
+      flushTransfers();
       break;
     }
 
+    // The deferred transfers may use up the remaining gas
+    if (!specTransfers.empty() &&
+        m_gasUsedTotal + specGas() >= microblock_gas_limit) {
+      if (!flushTransfers()) {
+        break;
+      }
+      continue;
+    }
+
     Transaction txn;
-    TransactionReceipt txnReceipt;
 
     // check m_addrNonceTxnMap contains any txn meets right nonce,
     // if contains, process it
-    if (findOneFromAddrNonceTxnMap(txn, t_addrNonceTxnMap)) {
+    if (t_addrNonceTxnMap.findOne(txn, getExpectedNonce)) {
       count_addrNonceTxnMap++;
       // check whether m_createdTransaction have transaction with same Addr and
       // nonce if has and with larger gasPrice then replace with that one.
       // (*optional step)
       t_createdTxns.findSameNonceButHigherGas(txn);
 
-      if (m_gasUsedTotal + txn.GetGasLimitZil() > microblock_gas_limit) {
-        LOG_GENERAL(WARNING, "Gas limit exceeded = " << txn.GetTranID());
-        LOG_GENERAL(WARNING, "m_gasUsedTotal     = " << m_gasUsedTotal);
-        LOG_GENERAL(WARNING,
-                    "t.GetGasLimitZil      = " << txn.GetGasLimitZil());
-        gasLimitExceededTxnBuffer.emplace_back(txn);
-        continue;
+      if ((specTouched.count(txn.GetSenderAddr()) > 0 ||
+           specTouched.count(txn.GetToAddr()) > 0) &&
+          !flushTransfers()) {
+        requeue(txn, true);
+        break;
       }
-      TxnStatus error_code;
-      if (m_mediator.m_validator->CheckCreatedTransaction(txn, txnReceipt,
-                                                          error_code)) {
-        if (!SafeMath<uint64_t>::add(m_gasUsedTotal, txnReceipt.GetCumGas(),
-                                     m_gasUsedTotal)) {
-          LOG_GENERAL(WARNING, "m_gasUsedTotal addition unsafe!");
-          break;
-        }
-        uint128_t txnFee;
-        if (!SafeMath<uint128_t>::mul(txnReceipt.GetCumGas(),
-                                      txn.GetGasPriceQa(), txnFee)) {
-          LOG_GENERAL(WARNING, "txnFee multiplication unsafe!");
-          continue;
-        }
-        if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
-          LOG_GENERAL(WARNING, "m_txnFees addition unsafe!");
-          break;
-        }
-        appendOne(txn, txnReceipt);
 
-        continue;
-      } else {
-        LOG_GENERAL(DEBUG, "Adding to dropped Txns failed transaction with id: "
-                               << txn.GetTranID());
-        droppedTxns.emplace_back(txn.GetTranID(), error_code);
+      if (!processOne(txn, true)) {
+        break;
       }
     }
     // if no txn in u_map meet right nonce process new come-in transactions
@@ -497,6 +628,14 @@ void Node::ProcessTransactionWhenShardLeader(
       // LOG_GENERAL(INFO, "findOneFromCreated");
 
       Address senderAddr = txn.GetSenderAddr();
+
+      // The nonce checks below need the effects of the deferred transfers
+      if ((specTouched.count(senderAddr) > 0 ||
+           specTouched.count(txn.GetToAddr()) > 0) &&
+          !flushTransfers()) {
+        break;
+      }
+
       // check nonce, if nonce larger than expected, put it into
       // m_addrNonceTxnMap
       if (txn.GetNonce() >
@@ -507,19 +646,9 @@ void Node::ProcessTransactionWhenShardLeader(
                        << " nonce: "
                        << AccountStore::GetInstance().GetNonceTemp(senderAddr));
         highNonce++;
-        auto it1 = t_addrNonceTxnMap.find(senderAddr);
-        if (it1 != t_addrNonceTxnMap.end()) {
-          auto it2 = it1->second.find(txn.GetNonce());
-          if (it2 != it1->second.end()) {
-            // found the txn with same addr and same nonce
-            // then compare the gasprice and remains the higher one
-            if (txn.GetGasPriceQa() > it2->second.GetGasPriceQa()) {
-              it2->second = txn;
-            }
-            continue;
-          }
-        }
-        t_addrNonceTxnMap[senderAddr].insert({txn.GetNonce(), txn});
+        // if a txn with same addr and same nonce is already queued, the one
+        // with the higher gasprice remains
+        t_addrNonceTxnMap.insert(txn, getExpectedNonce(senderAddr));
       }
       // if nonce too small, ignore it
       else if (txn.GetNonce() <
@@ -533,40 +662,13 @@ void Node::ProcessTransactionWhenShardLeader(
         droppedTxns.emplace_back(txn.GetTranID(), TxnStatus::NONCE_TOO_LOW);
       }
       // if nonce correct, process it
-      else {
-        if (m_gasUsedTotal + txn.GetGasLimitZil() > microblock_gas_limit) {
-          LOG_GENERAL(WARNING, "Gas limit exceeded = " << txn.GetTranID());
-          LOG_GENERAL(WARNING, "m_gasUsedTotal     = " << m_gasUsedTotal);
-          LOG_GENERAL(WARNING,
-                      "t.GetGasLimitZil      = " << txn.GetGasLimitZil());
-          gasLimitExceededTxnBuffer.emplace_back(txn);
-          continue;
-        }
-        TxnStatus error_code;
-        if (m_mediator.m_validator->CheckCreatedTransaction(txn, txnReceipt,
-                                                            error_code)) {
-          if (!SafeMath<uint64_t>::add(m_gasUsedTotal, txnReceipt.GetCumGas(),
-                                       m_gasUsedTotal)) {
-            LOG_GENERAL(WARNING, "m_gasUsedTotal addition unsafe!");
-            break;
-          }
-          uint128_t txnFee;
-          if (!SafeMath<uint128_t>::mul(txnReceipt.GetCumGas(),
-                                        txn.GetGasPriceQa(), txnFee)) {
-            LOG_GENERAL(WARNING, "txnFee multiplication unsafe!");
-            continue;
-          }
-          if (!SafeMath<uint128_t>::add(m_txnFees, txnFee, m_txnFees)) {
-            LOG_GENERAL(WARNING, "m_txnFees addition unsafe!");
-            break;
-          }
-          appendOne(txn, txnReceipt);
-        } else {
-          LOG_GENERAL(DEBUG,
-                      "Adding to dropped Txns failed transaction with id: "
-                          << txn.GetTranID());
-          droppedTxns.emplace_back(txn.GetTranID(), error_code);
-        }
+      else if (!processOne(txn, false)) {
+        break;
+      }
+    } else if (!specTransfers.empty()) {
+      // Running the deferred transfers may make queued txns runnable
+      if (!flushTransfers()) {
+        break;
       }
     } else {
       LOG_GENERAL(INFO, "Ending txn processing loop");
@@ -701,7 +803,7 @@ void Node::ProcessTransactionWhenShardBackup(
 
   t_createdTxns = m_createdTxns;
   m_expectedTranOrdering.clear();
-  map<Address, map<uint64_t, Transaction>> t_addrNonceTxnMap;
+  TxnReadyQueue t_addrNonceTxnMap;
   t_processedTransactions.clear();
 
   bool txnProcTimeout = false;
@@ -715,30 +817,23 @@ void Node::ProcessTransactionWhenShardBackup(
 
   this_thread::sleep_for(chrono::milliseconds(100));
 
-  auto findOneFromAddrNonceTxnMap =
-      [](Transaction& t,
-         std::map<Address, map<uint64_t, Transaction>>& t_addrNonceTxnMap)
-      -> bool {
-    for (auto it = t_addrNonceTxnMap.begin(); it != t_addrNonceTxnMap.end();
-         it++) {
-      if (it->second.begin()->first ==
-          AccountStore::GetInstance().GetNonceTemp(it->first) + 1) {
-        t = std::move(it->second.begin()->second);
-        it->second.erase(it->second.begin());
-
-        if (it->second.empty()) {
-          t_addrNonceTxnMap.erase(it);
-        }
-        return true;
-      }
-    }
-    return false;
+  auto getExpectedNonce = [](const Address& addr) -> uint128_t {
+    return AccountStore::GetInstance().GetNonceTemp(addr) + 1;
+  };
+
+  // Once a txn of a sender has been applied, its next queued txn may have
+  // become runnable
+  auto promoteSender = [&t_addrNonceTxnMap,
+                        &getExpectedNonce](const Address& senderAddr) {
+    t_addrNonceTxnMap.promote(senderAddr, getExpectedNonce(senderAddr));
   };
 
-  auto appendOne = [this](const Transaction& t, const TransactionReceipt& tr) {
+  auto appendOne = [this, &promoteSender](const Transaction& t,
+                                          const TransactionReceipt& tr) {
     m_expectedTranOrdering.emplace_back(t.GetTranID());
     t_processedTransactions.insert(
         make_pair(t.GetTranID(), TransactionWithReceipt(t, tr)));
+    promoteSender(t.GetSenderAddr());
   };
 
   m_gasUsedTotal = 0;
@@ -768,7 +863,7 @@ void Node::ProcessTransactionWhenShardBackup(
 
     // check t_addrNonceTxnMap contains any txn meets right nonce,
     // if contains, process it
-    if (findOneFromAddrNonceTxnMap(t, t_addrNonceTxnMap)) {
+    if (t_addrNonceTxnMap.findOne(t, getExpectedNonce)) {
       count_addrNonceTxnMap++;
       // check whether m_createdTransaction have transaction with same Addr and
       // nonce if has and with larger gasPrice then replace with that one.
@@ -805,6 +900,7 @@ void Node::ProcessTransactionWhenShardBackup(
 
       else {
         droppedTxns.emplace_back(t.GetTranID(), error_code);
+        promoteSender(t.GetSenderAddr());
       }
 
     }
@@ -822,19 +918,9 @@ void Node::ProcessTransactionWhenShardBackup(
                        << " nonce: "
                        << AccountStore::GetInstance().GetNonceTemp(senderAddr));
         highNonce++;
-        auto it1 = t_addrNonceTxnMap.find(senderAddr);
-        if (it1 != t_addrNonceTxnMap.end()) {
-          auto it2 = it1->second.find(t.GetNonce());
-          if (it2 != it1->second.end()) {
-            // found the txn with same addr and same nonce
-            // then compare the gasprice and remains the higher one
-            if (t.GetGasPriceQa() > it2->second.GetGasPriceQa()) {
-              it2->second = t;
-            }
-            continue;
-          }
-        }
-        t_addrNonceTxnMap[senderAddr].insert({t.GetNonce(), t});
+        // if a txn with same addr and same nonce is already queued, the one
+        // with the higher gasprice remains
+        t_addrNonceTxnMap.insert(t, getExpectedNonce(senderAddr));
       }
       // if nonce too small, ignore it
       else if (t.GetNonce() <
@@ -878,6 +964,7 @@ void Node::ProcessTransactionWhenShardBackup(
           appendOne(t, tr);
         } else {
           droppedTxns.emplace_back(t.GetTranID(), error_code);
+          promoteSender(t.GetSenderAddr());
         }
       }
     } else {
@@ -961,7 +1048,7 @@ std::string Node::GetAwsS3CpString(const std::string& uploadFilePath) {
 }
 
 void Node::ReinstateMemPool(
-    const map<Address, map<uint64_t, Transaction>>& addrNonceTxnMap,
+    const TxnReadyQueue& addrNonceTxnMap,
     const vector<Transaction>& gasLimitExceededTxnBuffer,
     vector<pair<TxnHash, TxnStatus>,
            boost::pool_allocator<std::pair<TxnHash, TxnStatus>>>
@@ -970,7 +1057,7 @@ void Node::ReinstateMemPool(
 
   MempoolInsertionStatus status;
   // Put remaining txns back in pool
-  for (const auto& kv : addrNonceTxnMap) {
+  for (const auto& kv : addrNonceTxnMap.PendingIndex) {
     for (const auto& nonceTxn : kv.second) {
       t_createdTxns.insert(nonceTxn.second, status);
       LOG_GENERAL(DEBUG, "Txn " << nonceTxn.second.GetTranID() << ", Status: "
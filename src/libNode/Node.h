@@ -34,6 +34,7 @@
 #include "libData/AccountData/Transaction.h"
 #include "libData/AccountData/TransactionReceipt.h"
 #include "libData/AccountData/TxnPool.h"
+#include "libData/AccountData/TxnReadyQueue.h"
 #include "libLookup/Synchronizer.h"
 #include "libNetwork/DataSender.h"
 #include "libNetwork/Executable.h"
@@ -239,7 +240,7 @@ class Node : public Executable {
       const uint64_t& blocknum);
 
   void ReinstateMemPool(
-      const std::map<Address, std::map<uint64_t, Transaction>>& addrNonceTxnMap,
+      const TxnReadyQueue& addrNonceTxnMap,
       const std::vector<Transaction>& gasLimitExceededTxnBuffer,
       std::vector<std::pair<TxnHash, TxnStatus>,
                   boost::pool_allocator<std::pair<TxnHash, TxnStatus>>>
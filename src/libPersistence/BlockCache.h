@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBPERSISTENCE_BLOCKCACHE_H_
+#define ZILLIQA_SRC_LIBPERSISTENCE_BLOCKCACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/compute/detail/lru_cache.hpp>
+#include <boost/noncopyable.hpp>
+
+#include "depends/common/FixedHash.h"
+#include "libMetrics/Api.h"
+
+inline Z_I64METRIC& GetBlockCacheCounter() {
+  static Z_I64METRIC counter{Z_FL::BLOCKS, "blockstorage.cache",
+                             "Lookups in the BlockStorage object caches",
+                             "Lookups"};
+  return counter;
+}
+
+/// Sharded LRU of deserialized objects kept in front of BlockStorage, keyed
+/// by hash. Cached objects are shared with every reader, so callers must
+/// treat them as read-only.
+template <typename Value>
+class BlockCache : boost::noncopyable {
+ public:
+  static constexpr size_t NUM_SHARDS = 16;
+
+ private:
+  struct Shard {
+    explicit Shard(size_t capacity) : m_lru(capacity) {}
+
+    std::mutex m_mutex;
+    boost::compute::detail::lru_cache<dev::h256, std::shared_ptr<Value>> m_lru;
+  };
+
+  std::string m_name;
+  std::vector<std::unique_ptr<Shard>> m_shards;
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_misses{0};
+
+  Shard& GetShard(const dev::h256& key) { return *m_shards[ShardOf(key)]; }
+
+ public:
+  /// A zero capacity disables the cache.
+  BlockCache(const std::string& name, size_t capacity) : m_name(name) {
+    if (capacity == 0) {
+      return;
+    }
+    for (size_t i = 0; i < NUM_SHARDS; i++) {
+      m_shards.emplace_back(
+          std::make_unique<Shard>((capacity + NUM_SHARDS - 1) / NUM_SHARDS));
+    }
+  }
+
+  bool Enabled() const { return !m_shards.empty(); }
+
+  static size_t ShardOf(const dev::h256& key) {
+    return std::hash<dev::h256>{}(key) % NUM_SHARDS;
+  }
+
+  /// Lookups since construction, as also reported to the metrics
+  uint64_t Hits() const { return m_hits; }
+  uint64_t Misses() const { return m_misses; }
+
+  /// Returns the cached object, or nullptr on a miss.
+  std::shared_ptr<Value> Get(const dev::h256& key) {
+    if (!Enabled()) {
+      return nullptr;
+    }
+
+    boost::optional<std::shared_ptr<Value>> value;
+    {
+      auto& shard = GetShard(key);
+      std::lock_guard<std::mutex> g(shard.m_mutex);
+      value = shard.m_lru.get(key);
+    }
+
+    (value ? m_hits : m_misses)++;
+    GetBlockCacheCounter().IncrementAttr(
+        {{"cache", m_name.c_str()}, {"result", value ? "hit" : "miss"}});
+    return value ? *value : nullptr;
+  }
+
+  void Put(const dev::h256& key, const std::shared_ptr<Value>& value) {
+    if (!Enabled() || !value) {
+      return;
+    }
+
+    auto& shard = GetShard(key);
+    std::lock_guard<std::mutex> g(shard.m_mutex);
+    shard.m_lru.insert(key, value);
+  }
+
+  void Clear() {
+    for (auto& shard : m_shards) {
+      std::lock_guard<std::mutex> g(shard->m_mutex);
+      shard->m_lru.clear();
+    }
+  }
+};
+
+#endif  // ZILLIQA_SRC_LIBPERSISTENCE_BLOCKCACHE_H_
@@ -17,9 +17,12 @@
 
 #include <unistd.h>
 #include <algorithm>
+#include <array>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <set>
+#include <sstream>
 #include <string>
 
 #include <boost/lexical_cast.hpp>
@@ -27,25 +30,141 @@
 #include "BlockStorage.h"
 #include "common/Constants.h"
 #include "common/Serializable.h"
+#include "depends/common/RLP.h"
 #include "depends/libDatabase/LevelDB.h"
 #include "libData/AccountStore/AccountStore.h"
+#include "libCrypto/Sha2.h"
 #include "libData/BlockChainData/BlockLinkChain.h"
 #include "libMessage/Messenger.h"
 #include "libMetrics/Api.h"
 #include "libMetrics/TracedIds.h"
 #include "libPersistence/ContractStorage.h"
+#include "libPersistence/SegmentStore.h"
 #include "libUtils/DataConversion.h"
 
 constexpr int TX_TRACES_TO_STORE = 30 * 1024;
 
 using namespace std;
 
+namespace {
+
+// Layout of the event log DB:
+//   "b" <epoch>                 -> bloom of the terms of the epoch's logs
+//   "l" <epoch>                 -> RLP list of the epoch's logs
+//   "i" <term> "/" <epoch> <txn index> <log index> -> empty (term index)
+// A term is the lowercased address ("a"), a topic at its position ("t<i>")
+// or, for a position the log has no topic at, a marker ("s<i>") as such logs
+// match any topic filter at that position.
+constexpr size_t EVENT_LOG_MAX_TOPICS = 4;
+constexpr size_t EVENT_LOG_BLOOM_BITS = 2048;
+constexpr size_t EVENT_LOG_BLOOM_HASHES = 3;
+
+string EventLogEpochKey(const uint64_t& epochNum) {
+  stringstream ss;
+  ss << setw(20) << setfill('0') << epochNum;
+  return ss.str();
+}
+
+string EventLogAddressTerm(string address) {
+  transform(address.begin(), address.end(), address.begin(), ::tolower);
+  return "a" + address;
+}
+
+string EventLogTopicTerm(size_t position, string topic) {
+  transform(topic.begin(), topic.end(), topic.begin(), ::tolower);
+  return "t" + to_string(position) + topic;
+}
+
+string EventLogNoTopicTerm(size_t position) {
+  return "s" + to_string(position);
+}
+
+vector<string> EventLogTerms(const EventLogRecord& record) {
+  vector<string> terms{EventLogAddressTerm(record.address)};
+  for (size_t i = 0; i < EVENT_LOG_MAX_TOPICS; ++i) {
+    terms.emplace_back(i < record.topics.size()
+                           ? EventLogTopicTerm(i, record.topics[i])
+                           : EventLogNoTopicTerm(i));
+  }
+  return terms;
+}
+
+array<size_t, EVENT_LOG_BLOOM_HASHES> EventLogBloomBits(const string& term) {
+  SHA256Calculator sha2;
+  sha2.Update(term);
+  const zbytes digest = sha2.Finalize();
+
+  array<size_t, EVENT_LOG_BLOOM_HASHES> bits;
+  for (size_t i = 0; i < EVENT_LOG_BLOOM_HASHES; ++i) {
+    bits[i] = ((digest[2 * i] << 8) | digest[2 * i + 1]) % EVENT_LOG_BLOOM_BITS;
+  }
+  return bits;
+}
+
+void EventLogBloomAdd(string& bloom, const string& term) {
+  for (auto bit : EventLogBloomBits(term)) {
+    bloom[bit / 8] |= static_cast<char>(1 << (bit % 8));
+  }
+}
+
+bool EventLogBloomContains(const string& bloom, const string& term) {
+  if (bloom.size() != EVENT_LOG_BLOOM_BITS / 8) {
+    return true;
+  }
+  for (auto bit : EventLogBloomBits(term)) {
+    if ((bloom[bit / 8] & (1 << (bit % 8))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Applies the eth_getLogs filter semantics to a set of terms, which is
+/// either exact (a single log) or probabilistic (an epoch bloom)
+template <typename ContainsTerm>
+bool EventLogTermsMatch(const vector<string>& addresses,
+                        const vector<vector<string>>& topics,
+                        ContainsTerm&& contains) {
+  if (!addresses.empty() &&
+      none_of(addresses.begin(), addresses.end(), [&](const string& a) {
+        return contains(EventLogAddressTerm(a));
+      })) {
+    return false;
+  }
+
+  for (size_t i = 0; i < topics.size() && i < EVENT_LOG_MAX_TOPICS; ++i) {
+    if (topics[i].empty() || contains(EventLogNoTopicTerm(i))) {
+      continue;
+    }
+    if (none_of(topics[i].begin(), topics[i].end(), [&](const string& t) {
+          return contains(EventLogTopicTerm(i, t));
+        })) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 BlockStorage& BlockStorage::GetBlockStorage(const std::string& path,
                                             bool diagnostic) {
   static BlockStorage bs(path, diagnostic);
   return bs;
 }
 
+BlockStorage::~BlockStorage() {
+  FlushBlockWrites();
+  {
+    lock_guard<mutex> g(m_mutexStagedWrites);
+    m_stopWriteBehind = true;
+  }
+  m_cvStagedWrites.notify_all();
+  if (m_writeBehindThread.joinable()) {
+    m_writeBehindThread.join();
+  }
+}
+
 void BlockStorage::Initialize(const std::string& path, bool diagnostic) {
   m_metadataDB = std::make_shared<LevelDB>("metadata");
 
@@ -79,8 +198,15 @@ void BlockStorage::Initialize(const std::string& path, bool diagnostic) {
     m_minerInfoShardsDB = std::make_shared<LevelDB>("minerInfoShards");
     m_extSeedPubKeysDB = std::make_shared<LevelDB>("extSeedPubKeys");
     m_contractCreatorDB = std::make_shared<LevelDB>("contractCreators");
+    m_eventLogDB = std::make_shared<LevelDB>("eventLogs");
+    if (BLOCKSTORAGE_SEGMENT_STORE) {
+      m_txBodySegments = std::make_shared<SegmentStore>("txBodySegments");
+    }
   }
   m_microBlockDBs.emplace_back(std::make_shared<LevelDB>("microBlocks"));
+  if (BLOCKSTORAGE_SEGMENT_STORE) {
+    m_microBlockSegments = std::make_shared<SegmentStore>("microBlockSegments");
+  }
 }
 
 bool BlockStorage::PutBlock(const uint64_t& blockNum, const zbytes& body,
@@ -92,7 +218,10 @@ bool BlockStorage::PutBlock(const uint64_t& blockNum, const zbytes& body,
     LOG_GENERAL(INFO, "Stored DSBlock num = " << blockNum);
   } else if (blockType == BlockType::Tx) {
     unique_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
-    ret = m_txBlockchainDB->Insert(blockNum, body);
+    ret = StageWrite(m_txBlockchainDB, to_string(blockNum),
+                     string(body.begin(), body.end()))
+              ? 0
+              : -1;
     LOG_GENERAL(INFO, "Stored TxBlock num = " << blockNum);
   }
   return (ret == 0);
@@ -147,11 +276,12 @@ bool BlockStorage::PutTxBlock(const TxBlockHeader& blockHeader,
   const auto status = PutBlock(blockHeader.GetBlockNum(), body, BlockType::Tx);
   if (status) {
     unique_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
-    m_txBlockHashToNumDB->Insert(blockHeader.GetMyHash(),
-                                 std::to_string(blockHeader.GetBlockNum()));
-    m_txBlockchainAuxDB->Insert(
-        leveldb::Slice(MAX_TX_BLOCK_NUM_KEY),
-        leveldb::Slice(std::to_string(blockHeader.GetBlockNum())));
+    const auto& hash = blockHeader.GetMyHash();
+    StageWrite(m_txBlockHashToNumDB,
+               string(reinterpret_cast<const char*>(hash.data()), hash.size),
+               std::to_string(blockHeader.GetBlockNum()));
+    StageWrite(m_txBlockchainAuxDB, MAX_TX_BLOCK_NUM_KEY,
+               std::to_string(blockHeader.GetBlockNum()));
   }
   return status;
 }
@@ -169,9 +299,16 @@ bool BlockStorage::PutTxBody(const uint64_t& epochNum, const dev::h256& key,
     return false;
   }
 
+  // Cached on commit so recent bodies are never read back from disk
+  TxBodySharedPtr cached;
+  if (m_txBodyCache.Enabled()) {
+    cached = make_shared<TransactionWithReceipt>(body, 0);
+  }
+
   const zbytes& keyBytes = key.asBytes();
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
+  lock_guard<mutex> w(GetBodyWriteShard(m_txBodyWriteShards, epochNum));
 
   if (!m_txEpochDB) {
     LOG_GENERAL(
@@ -180,21 +317,30 @@ bool BlockStorage::PutTxBody(const uint64_t& epochNum, const dev::h256& key,
     return false;
   }
 
+  const string keyString(keyBytes.begin(), keyBytes.end());
+
   // Store txn hash and epoch inside txEpochs DB
-  if (m_txEpochDB->Insert(keyBytes, epoch) != 0) {
+  if (!StageWrite(m_txEpochDB, keyString, string(epoch.begin(), epoch.end()))) {
     LOG_GENERAL(WARNING, "TxBody epoch insertion failed. epoch="
                              << epochNum << " key=" << key);
     return false;
   }
 
   // Store txn hash and body inside txBodies DB
-  if (GetTxBodyDB(epochNum)->Insert(keyBytes, body) != 0) {
+  const bool stored =
+      m_txBodySegments
+          ? m_txBodySegments->Put(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB,
+                                  keyBytes, dev::zbytesConstRef(&body))
+          : StageWrite(GetTxBodyDB(epochNum), keyString,
+                       string(body.begin(), body.end()));
+  if (!stored) {
     LOG_GENERAL(WARNING, "TxBody insertion failed. epoch=" << epochNum
                                                            << " key=" << key);
     m_txEpochDB->DeleteKey(key);
     return false;
   }
 
+  m_txBodyCache.Put(key, cached);
   return true;
 }
 
@@ -223,35 +369,58 @@ bool BlockStorage::PutMicroBlock(const BlockHash& blockHash,
   span.SetAttribute("block.type", "MicroBlock");
   span.SetAttribute("block.hash", blockHash.hex());
 
-  lock_guard<mutex> g(m_mutexMicroBlock);
+  MicroBlockSharedPtr cached;
+  if (m_microBlockCache.Enabled()) {
+    cached = make_shared<MicroBlock>();
+    if (!cached->Deserialize(body, 0)) {
+      cached.reset();
+    }
+  }
+
+  shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
+  lock_guard<mutex> w(GetBodyWriteShard(m_microBlockWriteShards, epochNum));
+
+  const string keyString(key.begin(), key.end());
 
   // Store hash and key inside microBlockKeys DB
-  if (m_microBlockKeyDB->Insert(blockHash, key) != 0) {
+  if (!StageWrite(m_microBlockKeyDB, blockHash.hex(), keyString)) {
     LOG_GENERAL(WARNING, "Microblock key insertion failed. epoch="
                              << epochNum << " shard=" << shardID);
     return false;
   }
 
   // Store key and body inside microBlocks DB
-  if (GetMicroBlockDB(epochNum)->Insert(key, body) != 0) {
+  const bool stored =
+      m_microBlockSegments
+          ? m_microBlockSegments->Put(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB,
+                                      key, dev::zbytesConstRef(&body))
+          : StageWrite(GetMicroBlockDB(epochNum), keyString,
+                       string(body.begin(), body.end()));
+  if (!stored) {
     LOG_GENERAL(WARNING, "Microblock body insertion failed. epoch="
                              << epochNum << " shard=" << shardID);
     m_microBlockKeyDB->DeleteKey(blockHash);
     return false;
   }
 
+  m_microBlockCache.Put(blockHash, cached);
   return true;
 }
 
 bool BlockStorage::GetMicroBlock(const BlockHash& blockHash,
                                  MicroBlockSharedPtr& microblock) {
+  microblock = m_microBlockCache.Get(blockHash);
+  if (microblock) {
+    return true;
+  }
+
   string blockString;
 
   {
-    lock_guard<mutex> g(m_mutexMicroBlock);
+    shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
 
     // Get key from microBlockKeys DB
-    const string& keyString = m_microBlockKeyDB->Lookup(blockHash);
+    const string& keyString = LookupStaged(m_microBlockKeyDB, blockHash.hex());
     if (keyString.empty()) {
       return false;
     }
@@ -265,7 +434,16 @@ bool BlockStorage::GetMicroBlock(const BlockHash& blockHash,
     }
 
     // Get body from microBlock DB
-    blockString = GetMicroBlockDB(epochNum)->Lookup(keyBytes);
+    SegmentStore::View segmentBlock;
+    if (m_microBlockSegments &&
+        m_microBlockSegments->Get(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB,
+                                  keyBytes, segmentBlock)) {
+      microblock = make_shared<MicroBlock>();
+      microblock->Deserialize(segmentBlock.value.toBytes(), 0);
+      m_microBlockCache.Put(blockHash, microblock);
+      return true;
+    }
+    blockString = LookupStaged(GetMicroBlockDB(epochNum), keyString);
   }
 
   if (blockString.empty()) {
@@ -273,6 +451,7 @@ bool BlockStorage::GetMicroBlock(const BlockHash& blockHash,
   }
   microblock = make_shared<MicroBlock>();
   microblock->Deserialize(zbytes(blockString.begin(), blockString.end()), 0);
+  m_microBlockCache.Put(blockHash, microblock);
 
   return true;
 }
@@ -289,8 +468,17 @@ bool BlockStorage::GetMicroBlock(const uint64_t& epochNum,
   string blockString;
 
   {
-    lock_guard<mutex> g(m_mutexMicroBlock);
-    blockString = GetMicroBlockDB(epochNum)->Lookup(key);
+    shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
+    SegmentStore::View segmentBlock;
+    if (m_microBlockSegments &&
+        m_microBlockSegments->Get(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB,
+                                  key, segmentBlock)) {
+      microblock = make_shared<MicroBlock>();
+      microblock->Deserialize(segmentBlock.value.toBytes(), 0);
+      return true;
+    }
+    blockString =
+        LookupStaged(GetMicroBlockDB(epochNum), string(key.begin(), key.end()));
   }
 
   if (blockString.empty()) {
@@ -303,9 +491,9 @@ bool BlockStorage::GetMicroBlock(const uint64_t& epochNum,
 }
 
 bool BlockStorage::CheckMicroBlock(const BlockHash& blockHash) {
-  lock_guard<mutex> g(m_mutexMicroBlock);
+  shared_lock<shared_timed_mutex> g(m_mutexMicroBlock);
   // Get key from microBlockKeys DB
-  string keyString = m_microBlockKeyDB->Lookup(blockHash);
+  string keyString = LookupStaged(m_microBlockKeyDB, blockHash.hex());
   if (keyString.empty()) {
     return false;
   }
@@ -316,7 +504,12 @@ bool BlockStorage::CheckMicroBlock(const BlockHash& blockHash) {
     LOG_GENERAL(WARNING, "Messenger::GetMicroBlockKey failed.");
     return false;
   }
-  return GetMicroBlockDB(epochNum)->Exists(keyBytes);
+  if (m_microBlockSegments &&
+      m_microBlockSegments->Exists(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB,
+                                   keyBytes)) {
+    return true;
+  }
+  return !LookupStaged(GetMicroBlockDB(epochNum), keyString).empty();
 }
 
 bool BlockStorage::GetRangeMicroBlocks(const uint64_t lowEpochNum,
@@ -387,21 +580,31 @@ bool BlockStorage::GetVCBlock(const BlockHash& blockhash,
 }
 
 bool BlockStorage::ReleaseDB() {
+  FlushBlockWrites();
   {
-    lock_guard<mutex> g(m_mutexTxBody);
+    unique_lock<shared_timed_mutex> g(m_mutexTxBody);
     for (auto& txBodyDB : m_txBodyDBs) {
       txBodyDB.reset();
     }
     m_txBodyDBs.clear();
     m_txEpochDB.reset();
+    // Kept so the write-behind thread never sees it change, just unmapped
+    if (m_txBodySegments) {
+      m_txBodySegments->Close();
+    }
+    m_txBodyCache.Clear();
   }
   {
-    lock_guard<mutex> g(m_mutexMicroBlock);
+    unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
     for (auto& microBlockDB : m_microBlockDBs) {
       microBlockDB.reset();
     }
     m_microBlockDBs.clear();
     m_microBlockKeyDB.reset();
+    if (m_microBlockSegments) {
+      m_microBlockSegments->Close();
+    }
+    m_microBlockCache.Clear();
   }
   {
     unique_lock<shared_timed_mutex> g(m_mutexVCBlock);
@@ -475,7 +678,7 @@ bool BlockStorage::GetTxBlock(const uint64_t& blockNum,
   string blockString;
   {
     shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
-    blockString = m_txBlockchainDB->Lookup(blockNum);
+    blockString = LookupStaged(m_txBlockchainDB, to_string(blockNum));
   }
   if (blockString.empty()) {
     return false;
@@ -493,7 +696,8 @@ bool BlockStorage::GetTxBlock(const BlockHash& blockhash,
   std::string blockNumStr;
   {
     shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
-    blockNumStr = m_txBlockHashToNumDB->Lookup(keyBytes);
+    blockNumStr = LookupStaged(m_txBlockHashToNumDB,
+                               string(keyBytes.begin(), keyBytes.end()));
   }
 
   if (blockNumStr.empty()) {
@@ -513,6 +717,9 @@ bool BlockStorage::GetLatestTxBlock(TxBlockSharedPtr& block) {
 
   LOG_GENERAL(INFO, "Retrieving latest Tx block...");
 
+  // Iteration only sees what is on disk
+  FlushBlockWrites();
+
   {
     shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
     std::unique_ptr<leveldb::Iterator> it{
@@ -530,9 +737,14 @@ bool BlockStorage::GetLatestTxBlock(TxBlockSharedPtr& block) {
 }
 
 bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
+  body = m_txBodyCache.Get(key);
+  if (body) {
+    return true;
+  }
+
   const zbytes& keyBytes = key.asBytes();
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_txEpochDB) {
     LOG_GENERAL(
@@ -541,7 +753,8 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
     return false;
   }
 
-  string epochString = m_txEpochDB->Lookup(keyBytes);
+  const string keyString(keyBytes.begin(), keyBytes.end());
+  string epochString = LookupStaged(m_txEpochDB, keyString);
   if (epochString.empty()) {
     return false;
   }
@@ -553,13 +766,25 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
     return false;
   }
 
-  string bodyString = GetTxBodyDB(epochNum)->Lookup(keyBytes);
+  SegmentStore::View segmentBody;
+  if (m_txBodySegments &&
+      m_txBodySegments->Get(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB, keyBytes,
+                            segmentBody)) {
+    body = TxBodySharedPtr(
+        new TransactionWithReceipt(segmentBody.value.toBytes(), 0));
+    m_txBodyCache.Put(key, body);
+    return true;
+  }
+
+  // Bodies stored before the segment store was enabled stay in LevelDB
+  string bodyString = LookupStaged(GetTxBodyDB(epochNum), keyString);
 
   if (bodyString.empty()) {
     return false;
   }
   body = TxBodySharedPtr(new TransactionWithReceipt(
       zbytes(bodyString.begin(), bodyString.end()), 0));
+  m_txBodyCache.Put(key, body);
 
   return true;
 }
@@ -567,7 +792,7 @@ bool BlockStorage::GetTxBody(const dev::h256& key, TxBodySharedPtr& body) {
 bool BlockStorage::CheckTxBody(const dev::h256& key) {
   const zbytes& keyBytes = key.asBytes();
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_txEpochDB) {
     LOG_GENERAL(
@@ -576,7 +801,8 @@ bool BlockStorage::CheckTxBody(const dev::h256& key) {
     return false;
   }
 
-  string epochString = m_txEpochDB->Lookup(keyBytes);
+  const string keyString(keyBytes.begin(), keyBytes.end());
+  string epochString = LookupStaged(m_txEpochDB, keyString);
   if (epochString.empty()) {
     return false;
   }
@@ -588,7 +814,12 @@ bool BlockStorage::CheckTxBody(const dev::h256& key) {
     return false;
   }
 
-  return GetTxBodyDB(epochNum)->Exists(keyBytes);
+  if (m_txBodySegments &&
+      m_txBodySegments->Exists(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB,
+                               keyBytes)) {
+    return true;
+  }
+  return !LookupStaged(GetTxBodyDB(epochNum), keyString).empty();
 }
 
 ZilliqaMessage::TxTraceStoredDisk GetTxTraceInfoStruct(
@@ -707,7 +938,7 @@ bool BlockStorage::PutTxTrace(const dev::h256& key, const std::string& trace) {
   // result.ByteSizeLong());
   const zbytes& keyBytes = key.asBytes();
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_txTraceDB) {
     LOG_GENERAL(
@@ -729,7 +960,7 @@ bool BlockStorage::PutTxTrace(const dev::h256& key, const std::string& trace) {
 bool BlockStorage::GetTxTrace(const dev::h256& key, std::string& trace) {
   const zbytes& keyBytes = key.asBytes();
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_txTraceDB) {
     LOG_GENERAL(
@@ -753,12 +984,15 @@ bool BlockStorage::GetTxTrace(const dev::h256& key, std::string& trace) {
 
 bool BlockStorage::DeleteTxBlock(const uint64_t& blocknum) {
   LOG_GENERAL(INFO, "Delete TxBlock Num: " << blocknum);
+  // A staged write would bring the block back once committed
+  FlushBlockWrites();
   unique_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
   int ret = m_txBlockchainDB->DeleteKey(blocknum);
   return (ret == 0);
 }
 
 bool BlockStorage::DeleteStateDelta(const uint64_t& finalBlockNum) {
+  FlushBlockWrites();
   unique_lock<shared_timed_mutex> g(m_mutexStateDelta);
 
   int ret = m_stateDeltaDB->DeleteKey(finalBlockNum);
@@ -901,6 +1135,9 @@ bool BlockStorage::GetAllExtSeedPubKeys(unordered_set<PubKey>& pubKeys) {
 bool BlockStorage::GetAllTxBlocks(std::deque<TxBlockSharedPtr>& blocks) {
   LOG_MARKER();
 
+  // Iteration only sees what is on disk
+  FlushBlockWrites();
+
   shared_lock<shared_timed_mutex> g(m_mutexTxBlockchain);
 
   std::unique_ptr<leveldb::Iterator> it{
@@ -996,18 +1233,28 @@ bool BlockStorage::GetAllBlockLink(std::list<BlockLink>& blocklinks) {
 
 bool BlockStorage::PutMetadata(MetaType type, const zbytes& data) {
   LOG_MARKER();
+  // Metadata tells recovery what is stored, so the blocks go to disk first
+  if (!ReportBlockWrites()) {
+    return false;
+  }
   unique_lock<shared_timed_mutex> g(m_mutexMetadata);
   int ret = m_metadataDB->Insert(std::to_string((int)type), data);
   return (ret == 0);
 }
 
 bool BlockStorage::PutStateRoot(const zbytes& data) {
+  if (!ReportBlockWrites()) {
+    return false;
+  }
   unique_lock<shared_timed_mutex> g(m_mutexStateRoot);
   int ret = m_stateRootDB->Insert(std::to_string((int)STATEROOT), data);
   return (ret == 0);
 }
 
 bool BlockStorage::PutLatestEpochStatesUpdated(const uint64_t& epochNum) {
+  if (!ReportBlockWrites()) {
+    return false;
+  }
   unique_lock<shared_timed_mutex> g(m_mutexStateRoot);
   int ret =
       m_stateRootDB->Insert(LATEST_EPOCH_STATES_UPDATED, to_string(epochNum));
@@ -1250,7 +1497,8 @@ bool BlockStorage::PutStateDelta(const uint64_t& finalBlockNum,
 
   unique_lock<shared_timed_mutex> g(m_mutexStateDelta);
 
-  if (0 != m_stateDeltaDB->Insert(finalBlockNum, stateDelta)) {
+  if (!StageWrite(m_stateDeltaDB, to_string(finalBlockNum),
+                  string(stateDelta.begin(), stateDelta.end()))) {
     LOG_PAYLOAD(WARNING,
                 "Failed to store state delta of final block " << finalBlockNum,
                 stateDelta, Logger::MAX_BYTES_TO_DISPLAY);
@@ -1270,7 +1518,10 @@ bool BlockStorage::GetStateDelta(const uint64_t& finalBlockNum,
   string dataStr;
   {
     shared_lock<shared_timed_mutex> g(m_mutexStateDelta);
-    dataStr = m_stateDeltaDB->Lookup(finalBlockNum, found);
+    found = FindStaged(m_stateDeltaDB, to_string(finalBlockNum), dataStr);
+    if (!found) {
+      dataStr = m_stateDeltaDB->Lookup(finalBlockNum, found);
+    }
   }
   if (found) {
     stateDelta = zbytes(dataStr.begin(), dataStr.end());
@@ -1679,6 +1930,7 @@ dev::h256 BlockStorage::GetContractCreator(const dev::h160 address) {
 
 bool BlockStorage::ResetDB(DBTYPE type) {
   LOG_MARKER();
+  FlushBlockWrites();
   bool ret = false;
   switch (type) {
     case META: {
@@ -1708,19 +1960,27 @@ bool BlockStorage::ResetDB(DBTYPE type) {
     }
 
     case TX_BODY: {
-      lock_guard<mutex> g(m_mutexTxBody);
+      unique_lock<shared_timed_mutex> g(m_mutexTxBody);
       ret = m_txEpochDB->ResetDB();
       for (auto& txBodyDB : m_txBodyDBs) {
         ret &= txBodyDB->ResetDB();
       }
+      if (m_txBodySegments) {
+        ret &= m_txBodySegments->Reset();
+      }
+      m_txBodyCache.Clear();
       break;
     }
     case MICROBLOCK: {
-      lock_guard<mutex> g(m_mutexMicroBlock);
+      unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
       ret = m_microBlockKeyDB->ResetDB();
       for (auto& microBlockDB : m_microBlockDBs) {
         ret &= microBlockDB->ResetDB();
       }
+      if (m_microBlockSegments) {
+        ret &= m_microBlockSegments->Reset();
+      }
+      m_microBlockCache.Clear();
       break;
     }
     case DS_COMMITTEE: {
@@ -1789,6 +2049,11 @@ bool BlockStorage::ResetDB(DBTYPE type) {
       ret = m_extSeedPubKeysDB->ResetDB();
       break;
     }
+    case EVENT_LOG: {
+      unique_lock<shared_timed_mutex> g(m_mutexEventLog);
+      ret = m_eventLogDB->ResetDB();
+      break;
+    }
   }
   if (!ret) {
     LOG_GENERAL(INFO, "FAIL: Reset DB " << type << " failed");
@@ -1797,6 +2062,7 @@ bool BlockStorage::ResetDB(DBTYPE type) {
 }
 
 bool BlockStorage::RefreshDB(DBTYPE type) {
+  FlushBlockWrites();
   bool ret = false;
   switch (type) {
     case META: {
@@ -1825,19 +2091,27 @@ bool BlockStorage::RefreshDB(DBTYPE type) {
       break;
     }
     case TX_BODY: {
-      lock_guard<mutex> g(m_mutexTxBody);
+      unique_lock<shared_timed_mutex> g(m_mutexTxBody);
       ret = m_txEpochDB->RefreshDB();
       for (auto& txBodyDB : m_txBodyDBs) {
         ret &= txBodyDB->RefreshDB();
       }
+      if (m_txBodySegments) {
+        m_txBodySegments->Close();
+      }
+      m_txBodyCache.Clear();
       break;
     }
     case MICROBLOCK: {
-      lock_guard<mutex> g(m_mutexMicroBlock);
+      unique_lock<shared_timed_mutex> g(m_mutexMicroBlock);
       ret = m_microBlockKeyDB->RefreshDB();
       for (auto& microBlockDB : m_microBlockDBs) {
         ret &= microBlockDB->RefreshDB();
       }
+      if (m_microBlockSegments) {
+        m_microBlockSegments->Close();
+      }
+      m_microBlockCache.Clear();
       break;
     }
     case DS_COMMITTEE: {
@@ -1906,6 +2180,11 @@ bool BlockStorage::RefreshDB(DBTYPE type) {
       ret = m_extSeedPubKeysDB->RefreshDB();
       break;
     }
+    case EVENT_LOG: {
+      unique_lock<shared_timed_mutex> g(m_mutexEventLog);
+      ret = m_eventLogDB->RefreshDB();
+      break;
+    }
   }
   if (!ret) {
     LOG_GENERAL(INFO, "FAIL: Refresh DB " << type << " failed");
@@ -1951,7 +2230,8 @@ bool BlockStorage::ResetAll() {
            PROCESSED_TEMP,
            MINER_INFO_DSCOMM,
            MINER_INFO_SHARDS,
-           EXTSEED_PUBKEYS};
+           EXTSEED_PUBKEYS,
+           EVENT_LOG};
   }
 
   auto result = true;
@@ -2002,7 +2282,8 @@ bool BlockStorage::RefreshAll() {
            PROCESSED_TEMP,
            MINER_INFO_DSCOMM,
            MINER_INFO_SHARDS,
-           EXTSEED_PUBKEYS};
+           EXTSEED_PUBKEYS,
+           EVENT_LOG};
   }
 
   auto result = true;
@@ -2017,8 +2298,21 @@ bool BlockStorage::RefreshAll() {
   return result;
 }
 
+mutex& BlockStorage::GetBodyWriteShard(
+    array<mutex, NUM_BODY_WRITE_SHARDS>& shards, const uint64_t& epochNum) {
+  return shards[(epochNum / NUM_EPOCHS_PER_PERSISTENT_DB) % shards.size()];
+}
+
 shared_ptr<LevelDB> BlockStorage::GetMicroBlockDB(const uint64_t& epochNum) {
   const unsigned int dbindex = epochNum / NUM_EPOCHS_PER_PERSISTENT_DB;
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexBodyDBs);
+    if (dbindex < m_microBlockDBs.size()) {
+      return m_microBlockDBs[dbindex];
+    }
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexBodyDBs);
   while (m_microBlockDBs.size() <= dbindex) {
     m_microBlockDBs.emplace_back(std::make_shared<LevelDB>(
         string("microBlocks_") + to_string(m_microBlockDBs.size())));
@@ -2028,6 +2322,14 @@ shared_ptr<LevelDB> BlockStorage::GetMicroBlockDB(const uint64_t& epochNum) {
 
 shared_ptr<LevelDB> BlockStorage::GetTxBodyDB(const uint64_t& epochNum) {
   const unsigned int dbindex = epochNum / NUM_EPOCHS_PER_PERSISTENT_DB;
+  {
+    shared_lock<shared_timed_mutex> g(m_mutexBodyDBs);
+    if (dbindex < m_txBodyDBs.size()) {
+      return m_txBodyDBs[dbindex];
+    }
+  }
+
+  unique_lock<shared_timed_mutex> g(m_mutexBodyDBs);
   while (m_txBodyDBs.size() <= dbindex) {
     m_txBodyDBs.emplace_back(std::make_shared<LevelDB>(
         string("txBodies_") + to_string(m_txBodyDBs.size())));
@@ -2035,6 +2337,171 @@ shared_ptr<LevelDB> BlockStorage::GetTxBodyDB(const uint64_t& epochNum) {
   return m_txBodyDBs.at(dbindex);
 }
 
+bool BlockStorage::StageWrite(const shared_ptr<LevelDB>& db, const string& key,
+                              const string& value) {
+  // Empty values are meaningful to some readers but skipped by BatchInsert
+  if (!BLOCKSTORAGE_WRITE_BEHIND || value.empty()) {
+    return db->Insert(leveldb::Slice(key), leveldb::Slice(value)) == 0;
+  }
+
+  bool commit = false;
+  {
+    lock_guard<mutex> g(m_mutexStagedWrites);
+    if (!m_stagedWrites) {
+      m_stagedWrites = make_shared<StagedWrites>();
+    }
+
+    auto& dbs = m_stagedWrites->dbs;
+    auto it = find_if(dbs.begin(), dbs.end(),
+                      [&db](const auto& entry) { return entry.first == db; });
+    if (it == dbs.end()) {
+      it = dbs.emplace(dbs.end(), db, unordered_map<string, string>{});
+    }
+    if (it->second.insert_or_assign(key, value).second) {
+      ++m_stagedWrites->count;
+    }
+    commit = m_stagedWrites->count >= BLOCKSTORAGE_WRITE_BEHIND_MAX_PENDING;
+  }
+
+  if (commit) {
+    CommitBlockWrites();
+  }
+  return true;
+}
+
+bool BlockStorage::FindStaged(const shared_ptr<LevelDB>& db, const string& key,
+                              string& value) const {
+  if (!BLOCKSTORAGE_WRITE_BEHIND) {
+    return false;
+  }
+
+  const auto find = [&db, &key, &value](const StagedWrites& writes) {
+    for (const auto& entry : writes.dbs) {
+      if (entry.first != db) {
+        continue;
+      }
+      const auto it = entry.second.find(key);
+      if (it != entry.second.end()) {
+        value = it->second;
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // Newest writes first
+  lock_guard<mutex> g(m_mutexStagedWrites);
+  if (m_stagedWrites && find(*m_stagedWrites)) {
+    return true;
+  }
+  for (auto it = m_committingWrites.rbegin(); it != m_committingWrites.rend();
+       ++it) {
+    if (find(**it)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+string BlockStorage::LookupStaged(const shared_ptr<LevelDB>& db,
+                                  const string& key) const {
+  string value;
+  if (FindStaged(db, key, value)) {
+    return value;
+  }
+  return db->Lookup(key);
+}
+
+void BlockStorage::CommitBlockWrites() {
+  {
+    lock_guard<mutex> g(m_mutexStagedWrites);
+    if (m_stagedWrites) {
+      m_committingWrites.emplace_back(std::move(m_stagedWrites));
+      m_stagedWrites.reset();
+      if (!m_writeBehindThread.joinable()) {
+        m_writeBehindThread = thread([this] { WriteBehindThread(); });
+      }
+      m_cvStagedWrites.notify_all();
+      return;
+    }
+  }
+
+  // Nothing for the writer thread, which is always the case without
+  // write-behind, so the segment appends are synced here
+  if (!FlushSegments()) {
+    lock_guard<mutex> g(m_mutexStagedWrites);
+    m_writeBehindFailed = true;
+  }
+}
+
+bool BlockStorage::FlushSegments() {
+  bool ok = true;
+  for (const auto& segments : {m_txBodySegments, m_microBlockSegments}) {
+    if (segments && !segments->Flush()) {
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+unique_lock<mutex> BlockStorage::WaitForBlockWrites() {
+  CommitBlockWrites();
+
+  unique_lock<mutex> g(m_mutexStagedWrites);
+  m_cvStagedWrites.wait(g, [this] { return m_committingWrites.empty(); });
+  return g;
+}
+
+bool BlockStorage::FlushBlockWrites() {
+  const auto g = WaitForBlockWrites();
+  return !m_writeBehindFailed;
+}
+
+bool BlockStorage::ReportBlockWrites() {
+  const auto g = WaitForBlockWrites();
+  if (!m_writeBehindFailed) {
+    return true;
+  }
+
+  LOG_GENERAL(WARNING, "Staged block writes failed");
+  m_writeBehindFailed = false;
+  return false;
+}
+
+void BlockStorage::WriteBehindThread() {
+  unique_lock<mutex> g(m_mutexStagedWrites);
+  while (true) {
+    m_cvStagedWrites.wait(g, [this] {
+      return m_stopWriteBehind || !m_committingWrites.empty();
+    });
+    if (m_committingWrites.empty()) {
+      return;
+    }
+
+    // Stays visible to readers until it is on disk
+    const auto writes = m_committingWrites.front();
+    g.unlock();
+
+    bool ok = true;
+    for (const auto& [db, batch] : writes->dbs) {
+      if (!db->BatchInsert(batch, true)) {
+        LOG_GENERAL(WARNING, "Committing " << batch.size() << " writes to "
+                                           << db->GetDBName() << " failed");
+        ok = false;
+      }
+    }
+    // Segment appends aren't staged, but become durable with the block
+    if (!FlushSegments()) {
+      ok = false;
+    }
+
+    g.lock();
+    m_writeBehindFailed = m_writeBehindFailed || !ok;
+    m_committingWrites.pop_front();
+    m_cvStagedWrites.notify_all();
+  }
+}
+
 void BlockStorage::BuildHashToNumberMappingForTxBlocks() {
   LOG_MARKER();
 
@@ -2102,7 +2569,7 @@ bool BlockStorage::PutOtterTrace(const dev::h256& key,
 
   const zbytes& keyBytes = key.asBytes();
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_otterTraceDB) {
     LOG_GENERAL(
@@ -2112,7 +2579,8 @@ bool BlockStorage::PutOtterTrace(const dev::h256& key,
   }
 
   // Store txn hash and epoch inside txEpochs DB
-  if (m_otterTraceDB->Insert(key, toWrite.SerializeAsString()) != 0) {
+  if (!StageWrite(m_otterTraceDB, string(keyBytes.begin(), keyBytes.end()),
+                  toWrite.SerializeAsString())) {
     LOG_GENERAL(WARNING, "Tx trace insertion failed. "
                              << " key=" << key);
     return false;
@@ -2124,7 +2592,7 @@ bool BlockStorage::PutOtterTrace(const dev::h256& key,
 bool BlockStorage::GetOtterTrace(const dev::h256& key, std::string& trace) {
   const zbytes& keyBytes = key.asBytes();
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_otterTraceDB) {
     LOG_GENERAL(
@@ -2133,7 +2601,8 @@ bool BlockStorage::GetOtterTrace(const dev::h256& key, std::string& trace) {
     return false;
   }
 
-  trace = m_otterTraceDB->Lookup(keyBytes);
+  trace =
+      LookupStaged(m_otterTraceDB, string(keyBytes.begin(), keyBytes.end()));
 
   if (trace.empty()) {
     return false;
@@ -2161,7 +2630,8 @@ bool BlockStorage::PutOtterTxAddressMapping(
     return false;
   }
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  // Exclusive, unlike the other writers, as the mappings are read-modify-write
+  unique_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   // for each address, add to the tx hashes and block number that touched them
   for (auto address : addresses) {
@@ -2187,7 +2657,7 @@ bool BlockStorage::PutOtterTxAddressMapping(
     ZilliqaMessage::OtterscanTraceAddressMapping ret;
     ZilliqaMessage::OtterscanTraceAddressMapping_TxHashInfo internal;
 
-    auto res = m_otterTxAddressMappingDB->Lookup(address);
+    auto res = LookupStaged(m_otterTxAddressMappingDB, address);
 
     if (!res.empty()) {
       ret.ParseFromString(res);
@@ -2198,10 +2668,7 @@ bool BlockStorage::PutOtterTxAddressMapping(
     internal.set_blocknum(blocknum);
     ret.mutable_hashes()->Add(std::move(internal));
 
-    zbytes ser(ret.ByteSizeLong());
-    ret.SerializeToArray(ser.data(), ser.size());
-
-    m_otterTxAddressMappingDB->Insert(address, ser);
+    StageWrite(m_otterTxAddressMappingDB, address, ret.SerializeAsString());
   }
 
   return true;
@@ -2211,7 +2678,7 @@ std::vector<std::string> BlockStorage::GetOtterTxAddressMapping(
     std::string address, unsigned long blockNumber, unsigned long pageSize,
     bool before, bool& wasMore) {
   std::vector<std::string> addresses;
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_otterTxAddressMappingDB) {
     LOG_GENERAL(
@@ -2233,7 +2700,7 @@ std::vector<std::string> BlockStorage::GetOtterTxAddressMapping(
     return {};
   }
 
-  std::string ret = m_otterTxAddressMappingDB->Lookup(address);
+  std::string ret = LookupStaged(m_otterTxAddressMappingDB, address);
 
   if (ret.empty()) {
     return {};
@@ -2323,20 +2790,17 @@ bool BlockStorage::PutOtterAddressNonceLookup(const dev::h256& txId,
   // Create lookup key as concatenation of address and nonce
   std::string key = address + std::to_string(nonce);
 
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   ZilliqaMessage::OtterscanAddressNonceLookup insert;
   insert.set_hash("0x" + txId.hex());
 
-  zbytes ser(insert.ByteSizeLong());
-  insert.SerializeToArray(ser.data(), ser.size());
-
-  return m_otterAddressNonceLookup->Insert(key, ser) == 0;
+  return StageWrite(m_otterAddressNonceLookup, key, insert.SerializeAsString());
 }
 
 std::string BlockStorage::GetOtterAddressNonceLookup(std::string address,
                                                      uint64_t nonce) {
-  lock_guard<mutex> g(m_mutexTxBody);
+  shared_lock<shared_timed_mutex> g(m_mutexTxBody);
 
   if (!m_otterAddressNonceLookup) {
     LOG_GENERAL(
@@ -2358,10 +2822,160 @@ std::string BlockStorage::GetOtterAddressNonceLookup(std::string address,
   }
 
   std::string key = address + std::to_string(nonce);
-  std::string ret = m_otterAddressNonceLookup->Lookup(key);
+  std::string ret = LookupStaged(m_otterAddressNonceLookup, key);
 
   ZilliqaMessage::OtterscanAddressNonceLookup txnId;
   txnId.ParseFromString(ret);
 
   return txnId.hash();
 }
+
+bool BlockStorage::PutEventLogs(const uint64_t& epochNum,
+                                const std::vector<EventLogRecord>& records) {
+  if (!m_eventLogDB) {
+    LOG_GENERAL(
+        WARNING,
+        "Attempt to access non initialized DB! Are you in lookup mode? ");
+    return false;
+  }
+
+  if (records.empty()) {
+    return true;
+  }
+
+  const string epochKey = EventLogEpochKey(epochNum);
+  string bloom(EVENT_LOG_BLOOM_BITS / 8, '\0');
+  dev::RLPStream rlp(records.size());
+  unordered_map<string, string> batch;
+
+  for (const auto& record : records) {
+    rlp.appendList(5);
+    rlp << record.address;
+    rlp.appendVector(record.topics);
+    rlp << record.txnIndex << record.logIndex << record.response;
+
+    stringstream suffix;
+    suffix << epochKey << setw(10) << setfill('0') << record.txnIndex
+           << setw(10) << setfill('0') << record.logIndex;
+    for (const auto& term : EventLogTerms(record)) {
+      EventLogBloomAdd(bloom, term);
+      batch.emplace("i" + term + "/" + suffix.str(), string());
+    }
+  }
+
+  const zbytes& logs = rlp.out();
+  batch["l" + epochKey] = string(logs.begin(), logs.end());
+  batch["b" + epochKey] = bloom;
+
+  unique_lock<shared_timed_mutex> g(m_mutexEventLog);
+  return m_eventLogDB->BatchInsert(batch);
+}
+
+bool BlockStorage::GetEventLogs(
+    const uint64_t& fromEpoch, const uint64_t& toEpoch,
+    const std::vector<std::string>& addresses,
+    const std::vector<std::vector<std::string>>& topics, size_t maxResults,
+    std::vector<EventLogRecord>& records) {
+  records.clear();
+
+  if (!m_eventLogDB) {
+    LOG_GENERAL(
+        WARNING,
+        "Attempt to access non initialized DB! Are you in lookup mode? ");
+    return false;
+  }
+
+  if (fromEpoch > toEpoch) {
+    return true;
+  }
+
+  // Epochs having logs are found via the most selective criterion available:
+  // the address terms, else the terms of the first constrained topic position,
+  // else every stored epoch in range
+  vector<string> terms;
+  for (const auto& address : addresses) {
+    terms.emplace_back(EventLogAddressTerm(address));
+  }
+  for (size_t i = 0; terms.empty() && i < topics.size() &&
+                     i < EVENT_LOG_MAX_TOPICS;
+       ++i) {
+    if (topics[i].empty()) {
+      continue;
+    }
+    for (const auto& topic : topics[i]) {
+      terms.emplace_back(EventLogTopicTerm(i, topic));
+    }
+    terms.emplace_back(EventLogNoTopicTerm(i));
+  }
+
+  const string fromKey = EventLogEpochKey(fromEpoch);
+  const string toKey = EventLogEpochKey(toEpoch);
+
+  shared_lock<shared_timed_mutex> g(m_mutexEventLog);
+
+  std::unique_ptr<leveldb::Iterator> it{
+      m_eventLogDB->GetDB()->NewIterator(leveldb::ReadOptions())};
+
+  set<string> epochs;
+  const vector<string> prefixes =
+      terms.empty() ? vector<string>{"b"} : terms;
+  for (const auto& term : prefixes) {
+    const string prefix = terms.empty() ? term : "i" + term + "/";
+    for (it->Seek(prefix + fromKey); it->Valid(); it->Next()) {
+      const string key = it->key().ToString();
+      if (key.compare(0, prefix.size(), prefix) != 0 ||
+          key.size() < prefix.size() + 20) {
+        break;
+      }
+      string epochKey = key.substr(prefix.size(), 20);
+      if (epochKey > toKey) {
+        break;
+      }
+      epochs.emplace(std::move(epochKey));
+    }
+  }
+
+  for (const auto& epochKey : epochs) {
+    const string bloom = m_eventLogDB->Lookup("b" + epochKey);
+    if (!EventLogTermsMatch(addresses, topics, [&](const string& term) {
+          return EventLogBloomContains(bloom, term);
+        })) {
+      continue;
+    }
+
+    const string logs = m_eventLogDB->Lookup("l" + epochKey);
+    if (logs.empty()) {
+      continue;
+    }
+
+    try {
+      for (const auto& item : dev::RLP(logs)) {
+        EventLogRecord record;
+        record.address = item[0].toString();
+        record.topics = item[1].toVector<std::string>();
+        record.txnIndex = item[2].toInt<uint32_t>();
+        record.logIndex = item[3].toInt<uint32_t>();
+
+        const auto recordTerms = EventLogTerms(record);
+        if (!EventLogTermsMatch(addresses, topics, [&](const string& term) {
+              return find(recordTerms.begin(), recordTerms.end(), term) !=
+                     recordTerms.end();
+            })) {
+          continue;
+        }
+
+        if (records.size() >= maxResults) {
+          return false;
+        }
+        record.response = item[4].toString();
+        records.emplace_back(std::move(record));
+      }
+    } catch (const std::exception& e) {
+      LOG_GENERAL(WARNING, "Corrupted event logs of epoch "
+                               << epochKey << ": " << e.what());
+      return false;
+    }
+  }
+
+  return true;
+}
@@ -18,21 +18,30 @@
 #ifndef ZILLIQA_SRC_LIBPERSISTENCE_BLOCKSTORAGE_H_
 #define ZILLIQA_SRC_LIBPERSISTENCE_BLOCKSTORAGE_H_
 
+#include <array>
+#include <condition_variable>
+#include <deque>
 #include <list>
 #include <mutex>
 #include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <Schnorr.h>
+#include "common/Constants.h"
 #include "libBlockchain/Block.h"
 #include "libData/AccountData/Address.h"
 #include "libData/MiningData/MinerInfo.h"
+#include "libPersistence/BlockCache.h"
 
 typedef std::tuple<uint32_t, uint64_t, uint64_t, BlockType, BlockHash>
     BlockLink;
 
 class TransactionWithReceipt;
 class LevelDB;
+class SegmentStore;
 
 typedef std::shared_ptr<DSBlock> DSBlockSharedPtr;
 typedef std::shared_ptr<TxBlock> TxBlockSharedPtr;
@@ -41,6 +50,15 @@ typedef std::shared_ptr<BlockLink> BlockLinkSharedPtr;
 typedef std::shared_ptr<MicroBlock> MicroBlockSharedPtr;
 typedef std::shared_ptr<TransactionWithReceipt> TxBodySharedPtr;
 
+/// A finalized event log as stored in the event log index
+struct EventLogRecord {
+  std::string address;
+  std::vector<std::string> topics;
+  uint32_t txnIndex = 0;
+  uint32_t logIndex = 0;
+  std::string response;
+};
+
 struct DiagnosticDataNodes {
   DequeOfShardMembers shards;
   DequeOfNode dsCommittee;
@@ -93,6 +111,15 @@ class BlockStorage : boost::noncopyable {
   std::vector<std::shared_ptr<LevelDB>> m_microBlockDBs;
   std::shared_ptr<LevelDB> m_microBlockOrigDB;
   std::shared_ptr<LevelDB> m_microBlockKeyDB;
+  /// hold tx bodies and microblocks in place of their LevelDBs when
+  /// BLOCKSTORAGE_SEGMENT_STORE is set
+  std::shared_ptr<SegmentStore> m_txBodySegments;
+  std::shared_ptr<SegmentStore> m_microBlockSegments;
+  /// recently committed or read tx bodies and microblocks, by hash
+  BlockCache<TransactionWithReceipt> m_txBodyCache{
+      "txBody", BLOCKSTORAGE_TXBODY_CACHE_SIZE};
+  BlockCache<MicroBlock> m_microBlockCache{"microBlock",
+                                           BLOCKSTORAGE_MICROBLOCK_CACHE_SIZE};
   std::shared_ptr<LevelDB> m_dsCommitteeDB;
   std::shared_ptr<LevelDB> m_VCBlockDB;
   std::shared_ptr<LevelDB> m_blockLinkDB;
@@ -113,12 +140,14 @@ class BlockStorage : boost::noncopyable {
   std::shared_ptr<LevelDB> m_extSeedPubKeysDB;
   /// stores the hash of the transaction which created a contract
   std::shared_ptr<LevelDB> m_contractCreatorDB;
+  /// stores finalized event logs and their address/topic index
+  std::shared_ptr<LevelDB> m_eventLogDB;
 
   BlockStorage(const std::string& path = "", bool diagnostic = false)
       : m_diagnosticDBNodesCounter(0), m_diagnosticDBCoinbaseCounter(0) {
     Initialize(path, diagnostic);
   };
-  ~BlockStorage() = default;
+  ~BlockStorage();
   bool PutBlock(const uint64_t& blockNum, const zbytes& body,
                 const BlockType& blockType);
 
@@ -142,7 +171,8 @@ class BlockStorage : boost::noncopyable {
     MINER_INFO_SHARDS,
     EXTSEED_PUBKEYS,
     TX_BLOCK_HASH_TO_NUM,
-    TX_BLOCK_AUX
+    TX_BLOCK_AUX,
+    EVENT_LOG
   };
 
   /// Returns the singleton BlockStorage instance.
@@ -356,6 +386,34 @@ class BlockStorage : boost::noncopyable {
   /// Get a contract creation transaction hash
   dev::h256 GetContractCreator(const dev::h160 address);
 
+  /// Adds the event logs of a finalized epoch to the event log index
+  bool PutEventLogs(const uint64_t& epochNum,
+                    const std::vector<EventLogRecord>& records);
+
+  /// Retrieves, in chain order, the event logs of epochs [fromEpoch, toEpoch]
+  /// emitted by one of the addresses and matching the per-position topic
+  /// variants (empty means any). Returns false if there are more than
+  /// maxResults of them.
+  bool GetEventLogs(const uint64_t& fromEpoch, const uint64_t& toEpoch,
+                    const std::vector<std::string>& addresses,
+                    const std::vector<std::vector<std::string>>& topics,
+                    size_t maxResults, std::vector<EventLogRecord>& records);
+
+  /// With BLOCKSTORAGE_WRITE_BEHIND, tx bodies, microblocks, tx blocks, state
+  /// deltas and otterscan data are staged in memory, where reads already see
+  /// them, until the block they belong to is committed.
+
+  /// Hands the staged writes over to the writer thread, which commits them as
+  /// one synced WriteBatch per db and then syncs the segment stores. Syncs
+  /// the segment stores right away if nothing is staged. Call once a block
+  /// is fully stored.
+  void CommitBlockWrites();
+
+  /// Durability barrier: commits the staged writes and waits until every
+  /// write handed over so far is on disk. Returns false if any of them failed
+  /// since the failure was last reported through ReportBlockWrites.
+  bool FlushBlockWrites();
+
   /// Clean a DB
   bool ResetDB(DBTYPE type);
 
@@ -374,27 +432,78 @@ class BlockStorage : boost::noncopyable {
   mutable std::shared_timed_mutex m_mutexMetadata;
   mutable std::shared_timed_mutex m_mutexDsBlockchain;
   mutable std::shared_timed_mutex m_mutexTxBlockchain;
-  mutable std::mutex m_mutexMicroBlock;
+  mutable std::shared_timed_mutex m_mutexMicroBlock;
   mutable std::shared_timed_mutex m_mutexDsCommittee;
   mutable std::shared_timed_mutex m_mutexVCBlock;
   mutable std::shared_timed_mutex m_mutexBlockLink;
   mutable std::shared_timed_mutex m_mutexShardStructure;
   mutable std::shared_timed_mutex m_mutexStateDelta;
   mutable std::shared_timed_mutex m_mutexTempState;
-  mutable std::mutex m_mutexTxBody;
+  mutable std::shared_timed_mutex m_mutexTxBody;
   mutable std::shared_timed_mutex m_mutexStateRoot;
   mutable std::shared_timed_mutex m_mutexProcessTx;
   mutable std::shared_timed_mutex m_mutexMinerInfoDSComm;
   mutable std::shared_timed_mutex m_mutexMinerInfoShards;
   mutable std::shared_timed_mutex m_mutexExtSeedPubKeys;
   mutable std::mutex m_contractCreatorMutex;
+  mutable std::shared_timed_mutex m_mutexEventLog;
 
   unsigned int m_diagnosticDBNodesCounter;
   unsigned int m_diagnosticDBCoinbaseCounter;
 
+  /// Readers and writers of tx bodies and microblocks hold m_mutexTxBody or
+  /// m_mutexMicroBlock shared, resetting or releasing the dbs holds it
+  /// exclusively. Writers are exclusive only among writers to the same body
+  /// db, through the write shard of its index.
+  static constexpr size_t NUM_BODY_WRITE_SHARDS = 16;
+  std::array<std::mutex, NUM_BODY_WRITE_SHARDS> m_txBodyWriteShards;
+  std::array<std::mutex, NUM_BODY_WRITE_SHARDS> m_microBlockWriteShards;
+  /// Guards growing m_txBodyDBs and m_microBlockDBs under a shared lock
+  mutable std::shared_timed_mutex m_mutexBodyDBs;
+
+  std::mutex& GetBodyWriteShard(
+      std::array<std::mutex, NUM_BODY_WRITE_SHARDS>& shards,
+      const uint64_t& epochNum);
   std::shared_ptr<LevelDB> GetMicroBlockDB(const uint64_t& epochNum);
   std::shared_ptr<LevelDB> GetTxBodyDB(const uint64_t& epochNum);
   void BuildHashToNumberMappingForTxBlocks();
+
+  /// Writes of one or more blocks, in first write order per db
+  struct StagedWrites {
+    std::vector<std::pair<std::shared_ptr<LevelDB>,
+                          std::unordered_map<std::string, std::string>>>
+        dbs;
+    size_t count = 0;
+  };
+
+  /// Stages a write, or inserts it right away without write-behind
+  bool StageWrite(const std::shared_ptr<LevelDB>& db, const std::string& key,
+                  const std::string& value);
+  /// Looks a key up in the writes that aren't on disk yet
+  bool FindStaged(const std::shared_ptr<LevelDB>& db, const std::string& key,
+                  std::string& value) const;
+  /// Looks a key up in the writes that aren't on disk yet, then in the db
+  std::string LookupStaged(const std::shared_ptr<LevelDB>& db,
+                           const std::string& key) const;
+  /// Commits the staged writes and returns once all of them are written,
+  /// holding m_mutexStagedWrites
+  std::unique_lock<std::mutex> WaitForBlockWrites();
+  /// Syncs the appends to the tx body and microblock segment stores
+  bool FlushSegments();
+  /// FlushBlockWrites for writes that must not land before the blocks, such
+  /// as metadata. Logs and clears a failure it returns false for.
+  bool ReportBlockWrites();
+  void WriteBehindThread();
+
+  mutable std::mutex m_mutexStagedWrites;
+  std::condition_variable m_cvStagedWrites;
+  std::shared_ptr<StagedWrites> m_stagedWrites;
+  /// Committed in order by m_writeBehindThread, the front one being written
+  std::deque<std::shared_ptr<StagedWrites>> m_committingWrites;
+  /// Set by a failed commit or segment sync until ReportBlockWrites returns it
+  bool m_writeBehindFailed = false;
+  bool m_stopWriteBehind = false;
+  std::thread m_writeBehindThread;
 };
 
 #endif  // ZILLIQA_SRC_LIBPERSISTENCE_BLOCKSTORAGE_H_
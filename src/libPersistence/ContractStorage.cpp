@@ -155,6 +155,110 @@ bool ContractStorage::FetchStateValue(const dev::h160& addr,
 
   lock_guard<mutex> g(m_stateDataMutex);
 
+  return DoFetchStateValue(addr, query, dst, d_offset, foundVal, getType,
+                           type);
+}
+
+bool ContractStorage::FetchStateValues(const dev::h160& addr,
+                                       const vector<zbytes>& srcs,
+                                       vector<zbytes>& dsts,
+                                       vector<bool>& foundVals) {
+  if (LOG_SC) {
+    LOG_MARKER();
+  }
+
+  dsts.assign(srcs.size(), {});
+  foundVals.assign(srcs.size(), false);
+
+  lock_guard<mutex> g(m_stateDataMutex);
+
+  for (size_t i = 0; i < srcs.size(); ++i) {
+    ProtoScillaQuery query;
+    query.ParseFromArray(srcs[i].data(), srcs[i].size());
+    bool found = false;
+    if (!DoFetchStateValue(addr, query, dsts[i], 0, found, false,
+                           type_placeholder)) {
+      return false;
+    }
+    foundVals[i] = found;
+  }
+
+  return true;
+}
+
+uint64_t ContractStorage::PrefetchStateValues(const dev::h160& addr,
+                                              const zbytes& src) {
+  ProtoScillaQuery query;
+  query.ParseFromArray(src.data(), src.size());
+  if (!query.IsInitialized() || IsReservedVName(query.name())) {
+    LOG_GENERAL(WARNING, "Invalid prefetch query");
+    return 0;
+  }
+
+  string prefix = addr.hex() + SCILLA_INDEX_SEPARATOR + query.name() +
+                  SCILLA_INDEX_SEPARATOR;
+  for (const auto& index : query.indices()) {
+    prefix += index + SCILLA_INDEX_SEPARATOR;
+  }
+
+  lock_guard<mutex> g(m_stateDataMutex);
+
+  if (m_prefetchedPrefixes.find(prefix) != m_prefetchedPrefixes.end()) {
+    return 0;
+  }
+
+  if (m_prefetchedStateData.size() >= SCILLA_STATE_PREFETCH_MAX_ENTRIES) {
+    m_prefetchedStateData.clear();
+    m_prefetchedPrefixes.clear();
+  }
+
+  std::unique_ptr<leveldb::Iterator> it(
+      m_stateDataDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+
+  uint64_t count = 0;
+  for (it->Seek({prefix});
+       it->Valid() && it->key().ToString().compare(0, prefix.size(), prefix) ==
+                          0;
+       it->Next()) {
+    if (m_prefetchedStateData.size() >= SCILLA_STATE_PREFETCH_MAX_ENTRIES) {
+      // Partially read, so the prefix can't vouch for missing keys
+      return count;
+    }
+    m_prefetchedStateData[it->key().ToString()] =
+        zbytes(it->value().data(), it->value().data() + it->value().size());
+    ++count;
+  }
+
+  m_prefetchedPrefixes.emplace(std::move(prefix));
+  return count;
+}
+
+bool ContractStorage::LookupStateDB(const string& key, zbytes& value) {
+  const auto cached = m_prefetchedStateData.find(key);
+  if (cached != m_prefetchedStateData.end()) {
+    value = cached->second;
+    return !value.empty();
+  }
+
+  // A covering prefix sorts right before the key. With nested prefixes the
+  // nearest one may not cover it, which only costs a db lookup.
+  auto prefix = m_prefetchedPrefixes.upper_bound(key);
+  if (prefix != m_prefetchedPrefixes.begin()) {
+    --prefix;
+    if (key.compare(0, prefix->size(), *prefix) == 0) {
+      return false;
+    }
+  }
+
+  value = DataConversion::StringToCharArray(m_stateDataDB.Lookup(key));
+  return !value.empty();
+}
+
+bool ContractStorage::DoFetchStateValue(const dev::h160& addr,
+                                        const ProtoScillaQuery& query,
+                                        zbytes& dst, unsigned int d_offset,
+                                        bool& foundVal, bool getType,
+                                        string& type) {
   foundVal = true;
 
   if (d_offset > dst.size()) {
@@ -250,15 +354,13 @@ bool ContractStorage::FetchStateValue(const dev::h160& addr,
       }
     }
     if (!found) {
-      if (m_stateDataDB.Exists(key)) {
-        if (query.ignoreval()) {
-          return true;
-        }
-        bval = DataConversion::StringToCharArray(m_stateDataDB.Lookup(key));
-      } else {
+      if (!LookupStateDB(key, bval)) {
         foundVal = false;
         return true;
       }
+      if (query.ignoreval()) {
+        return true;
+      }
     }
 
     value.set_bval(bval.data(), bval.size());
@@ -1305,6 +1407,9 @@ bool ContractStorage::CommitStateDB(const uint64_t& dsBlockNum) {
 
     m_stateDataMap.clear();
     m_indexToBeDeleted.clear();
+
+    m_prefetchedStateData.clear();
+    m_prefetchedPrefixes.clear();
   }
 
   InitTempState();
@@ -1383,6 +1488,9 @@ void ContractStorage::Reset() {
     m_stateDataMap.clear();
     m_indexToBeDeleted.clear();
 
+    m_prefetchedStateData.clear();
+    m_prefetchedPrefixes.clear();
+
     m_stateTrie.init();
     m_trieDB.ResetDB();
   }
@@ -1400,6 +1508,8 @@ bool ContractStorage::RefreshAll() {
   }
   if (ret) {
     lock_guard<mutex> g(m_stateDataMutex);
+    m_prefetchedStateData.clear();
+    m_prefetchedPrefixes.clear();
     ret = m_stateDataDB.RefreshDB();
     ret = ret && m_trieDB.RefreshDB();
   }
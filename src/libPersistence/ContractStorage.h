@@ -20,6 +20,7 @@
 
 #include <json/json.h>
 #include <mutex>
+#include <unordered_map>
 
 #include "common/Constants.h"
 #include "depends/libDatabase/LevelDB.h"
@@ -65,6 +66,20 @@ class ContractStorage : boost::noncopyable {
   mutable std::mutex m_initDataMutex;
   mutable std::mutex m_stateDataMutex;
 
+  // Committed state read ahead from m_stateDataDB by PrefetchStateValues, and
+  // the key prefixes whose entries are all present in it
+  std::unordered_map<std::string, zbytes> m_prefetchedStateData;
+  std::set<std::string> m_prefetchedPrefixes;
+
+  /// Requires m_stateDataMutex
+  bool DoFetchStateValue(const dev::h160& addr, const ProtoScillaQuery& query,
+                         zbytes& dst, unsigned int d_offset, bool& foundVal,
+                         bool getType, std::string& type);
+
+  /// Looks a key up in m_stateDataDB, going through the prefetched state
+  /// first. Requires m_stateDataMutex
+  bool LookupStateDB(const std::string& key, zbytes& value);
+
   void DeleteByPrefix(const std::string& prefix);
 
   void DeleteByIndex(const std::string& index);
@@ -129,6 +144,16 @@ class ContractStorage : boost::noncopyable {
                        bool getType = false,
                        std::string& type = type_placeholder);
 
+  /// Fetches several state values of one contract under a single lock.
+  /// Each entry of srcs is a serialized ProtoScillaQuery.
+  bool FetchStateValues(const dev::h160& addr, const std::vector<zbytes>& srcs,
+                        std::vector<zbytes>& dsts, std::vector<bool>& foundVals);
+
+  /// Reads every committed entry under the map named by the query into
+  /// memory, so following FetchStateValue calls on the map skip the db.
+  /// Returns the number of entries read.
+  uint64_t PrefetchStateValues(const dev::h160& addr, const zbytes& src);
+
   bool FetchExternalStateValue(
       const dev::h160& caller, const dev::h160& target, const zbytes& src,
       unsigned int s_offset, zbytes& dst, unsigned int d_offset, bool& foundVal,
@@ -0,0 +1,618 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "SegmentStore.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "common/Constants.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace {
+
+constexpr uint64_t DATA_MAGIC = 0x5a494c5345474454;   // ZILSEGDT
+constexpr uint64_t INDEX_MAGIC = 0x5a494c5345474958;  // ZILSEGIX
+constexpr uint64_t INITIAL_INDEX_CAPACITY = 1 << 12;
+// Granularity at which index changes are written back
+constexpr uint64_t INDEX_PAGE_SIZE = 4096;
+
+// Starts the data file, records follow it
+struct DataHeader {
+  uint64_t magic;
+  // Records never straddle a chunk, so each chunk can be mapped on its own
+  uint64_t chunkSize;
+};
+
+// Precedes the key and value bytes of every record, a zero key length pads
+// out the rest of the chunk
+struct RecordHeader {
+  uint32_t keyLength;
+  uint32_t valueLength;
+};
+
+struct IndexHeader {
+  uint64_t magic;
+  // Number of slots, always a power of two
+  uint64_t capacity;
+  uint64_t count;
+  // Data bytes whose records are all in the index
+  uint64_t indexedSize;
+};
+
+struct IndexSlot {
+  uint64_t keyHash;
+  // Record offset plus one, zero marks an empty slot
+  uint64_t offset;
+};
+
+size_t IndexBytes(uint64_t capacity) {
+  return sizeof(IndexHeader) + capacity * sizeof(IndexSlot);
+}
+
+IndexSlot* Slots(IndexHeader* index) {
+  return reinterpret_cast<IndexSlot*>(index + 1);
+}
+
+// Returns an empty index, as 64 bit words to keep it aligned
+vector<uint64_t> MakeIndex(uint64_t capacity) {
+  vector<uint64_t> data(IndexBytes(capacity) / sizeof(uint64_t), 0);
+  *reinterpret_cast<IndexHeader*>(data.data()) = {INDEX_MAGIC, capacity, 0,
+                                                  sizeof(DataHeader)};
+  return data;
+}
+
+// FNV-1a, as the index outlives any one build of std::hash
+uint64_t HashKey(const zbytes& key) {
+  uint64_t hash = 0xcbf29ce484222325;
+  for (const auto b : key) {
+    hash ^= b;
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+// Returns the slot the offset went into
+uint64_t Place(IndexHeader* index, uint64_t hash, uint64_t offset) {
+  const uint64_t mask = index->capacity - 1;
+  auto* slots = Slots(index);
+  uint64_t i = hash & mask;
+  while (slots[i].offset != 0) {
+    i = (i + 1) & mask;
+  }
+  slots[i] = {hash, offset + 1};
+  index->count++;
+  return i;
+}
+
+// Checks that every slot points to a record header within the indexed data
+bool Validate(IndexHeader* index) {
+  const auto* slots = Slots(index);
+  uint64_t count = 0;
+  for (uint64_t i = 0; i < index->capacity; i++) {
+    if (slots[i].offset == 0) {
+      continue;
+    }
+    if (slots[i].offset - 1 < sizeof(DataHeader) ||
+        slots[i].offset - 1 + sizeof(RecordHeader) > index->indexedSize) {
+      return false;
+    }
+    count++;
+  }
+  return count == index->count;
+}
+
+bool WriteFully(int fd, const void* data, size_t size, uint64_t offset) {
+  auto* p = static_cast<const char*>(data);
+  while (size > 0) {
+    const auto written = pwrite(fd, p, size, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    p += written;
+    size -= written;
+    offset += written;
+  }
+  return true;
+}
+
+bool ReadFully(int fd, void* data, size_t size, uint64_t offset) {
+  auto* p = static_cast<char*>(data);
+  while (size > 0) {
+    const auto read = pread(fd, p, size, offset);
+    if (read <= 0) {
+      if (read < 0 && errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    p += read;
+    size -= read;
+    offset += read;
+  }
+  return true;
+}
+
+}  // namespace
+
+struct SegmentStore::Segment {
+  ~Segment();
+
+  bool Open(const string& dataPath, const string& indexPath);
+  bool Find(const zbytes& key, uint64_t hash, View& value);
+  bool Append(const zbytes& key, uint64_t hash, dev::zbytesConstRef value);
+  bool Sync();
+
+  void UseIndex(vector<uint64_t> data);
+  bool LoadIndex();
+  /// Writes the whole index aside and renames it over the index file.
+  bool RewriteIndex();
+  void Touch(uint64_t indexOffset);
+  void Insert(uint64_t hash, uint64_t offset);
+  void GrowIndex();
+  /// Indexes records appended after the last indexed one and truncates a
+  /// record torn by a crash.
+  bool Recover(uint64_t fileSize);
+  /// Returns the mapped record at offset, sharing ownership of its chunk.
+  shared_ptr<const zbyte> Map(uint64_t offset);
+
+  string m_dataPath;
+  string m_indexPath;
+  int m_dataFd = -1;
+  uint64_t m_chunkSize = 0;
+  uint64_t m_dataSize = 0;
+  int m_indexFd = -1;
+  // The index is kept in private memory and only written back by Sync once
+  // the data it points into is synced, so a crash can't leave an index on
+  // disk that points past the synced data
+  vector<uint64_t> m_indexData;
+  IndexHeader* m_index = nullptr;
+  // Pages of the index changed since the last Sync
+  set<uint64_t> m_dirtyPages;
+  // Set when the index file has to be replaced as a whole
+  bool m_rewriteIndex = false;
+
+  // Chunks are mapped on first read, possibly by concurrent readers, and
+  // unmapped once the segment and every view into them are gone
+  mutex m_mutexChunks;
+  vector<shared_ptr<const zbyte>> m_chunks;
+};
+
+SegmentStore::Segment::~Segment() {
+  if (m_indexFd >= 0) {
+    close(m_indexFd);
+  }
+  if (m_dataFd >= 0) {
+    close(m_dataFd);
+  }
+}
+
+bool SegmentStore::Segment::Open(const string& dataPath,
+                                 const string& indexPath) {
+  m_dataPath = dataPath;
+  m_indexPath = indexPath;
+
+  m_dataFd = open(dataPath.c_str(), O_RDWR | O_CREAT, 0644);
+  struct stat st {};
+  if (m_dataFd < 0 || fstat(m_dataFd, &st) != 0) {
+    LOG_GENERAL(WARNING, "Failed to open " << dataPath << ": "
+                                           << strerror(errno));
+    return false;
+  }
+
+  uint64_t fileSize = st.st_size;
+  DataHeader header{};
+  if (fileSize < sizeof(header)) {
+    header = {DATA_MAGIC, uint64_t{BLOCKSTORAGE_SEGMENT_CHUNK_MB} << 20};
+    if (!WriteFully(m_dataFd, &header, sizeof(header), 0)) {
+      LOG_GENERAL(WARNING, "Failed to write " << dataPath);
+      return false;
+    }
+    fileSize = sizeof(header);
+  } else if (!ReadFully(m_dataFd, &header, sizeof(header), 0) ||
+             header.magic != DATA_MAGIC || header.chunkSize == 0 ||
+             header.chunkSize % sysconf(_SC_PAGESIZE) != 0) {
+    LOG_GENERAL(WARNING, dataPath << " is not a segment data file");
+    return false;
+  }
+  m_chunkSize = header.chunkSize;
+
+  // An index that is missing, damaged or ahead of its data is rebuilt
+  if (!LoadIndex() || m_index->indexedSize > fileSize) {
+    LOG_GENERAL(INFO, "Rebuilding segment index " << indexPath);
+    UseIndex(MakeIndex(INITIAL_INDEX_CAPACITY));
+    m_rewriteIndex = true;
+  }
+
+  return Recover(fileSize);
+}
+
+void SegmentStore::Segment::UseIndex(vector<uint64_t> data) {
+  m_indexData = std::move(data);
+  m_index = reinterpret_cast<IndexHeader*>(m_indexData.data());
+  m_dirtyPages.clear();
+}
+
+bool SegmentStore::Segment::LoadIndex() {
+  const int fd = open(m_indexPath.c_str(), O_RDWR);
+  if (fd < 0) {
+    return false;
+  }
+
+  IndexHeader header{};
+  struct stat st {};
+  vector<uint64_t> data;
+  bool valid = fstat(fd, &st) == 0 &&
+               ReadFully(fd, &header, sizeof(header), 0) &&
+               header.magic == INDEX_MAGIC && header.capacity != 0 &&
+               (header.capacity & (header.capacity - 1)) == 0 &&
+               static_cast<uint64_t>(st.st_size) == IndexBytes(header.capacity);
+  if (valid) {
+    data.resize(IndexBytes(header.capacity) / sizeof(uint64_t));
+    valid = ReadFully(fd, data.data(), IndexBytes(header.capacity), 0) &&
+            Validate(reinterpret_cast<IndexHeader*>(data.data()));
+  }
+  if (!valid) {
+    close(fd);
+    return false;
+  }
+
+  m_indexFd = fd;
+  UseIndex(std::move(data));
+  return true;
+}
+
+bool SegmentStore::Segment::RewriteIndex() {
+  // Built aside and renamed over, so a crash leaves one index or the other
+  const string tmpPath = m_indexPath + ".tmp";
+  const int fd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 ||
+      !WriteFully(fd, m_indexData.data(), IndexBytes(m_index->capacity), 0) ||
+      fdatasync(fd) != 0 || rename(tmpPath.c_str(), m_indexPath.c_str()) != 0) {
+    LOG_GENERAL(WARNING, "Failed to replace " << m_indexPath << ": "
+                                              << strerror(errno));
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+
+  if (m_indexFd >= 0) {
+    close(m_indexFd);
+  }
+  m_indexFd = fd;
+  m_rewriteIndex = false;
+  m_dirtyPages.clear();
+  return true;
+}
+
+void SegmentStore::Segment::Touch(uint64_t indexOffset) {
+  if (!m_rewriteIndex) {
+    m_dirtyPages.insert(indexOffset / INDEX_PAGE_SIZE);
+  }
+}
+
+bool SegmentStore::Segment::Recover(uint64_t fileSize) {
+  uint64_t offset = m_index->indexedSize;
+  while (offset < fileSize) {
+    const uint64_t chunkEnd = (offset / m_chunkSize + 1) * m_chunkSize;
+
+    RecordHeader record{};
+    if (chunkEnd - offset >= sizeof(record)) {
+      if (offset + sizeof(record) > fileSize) {
+        break;
+      }
+      if (!ReadFully(m_dataFd, &record, sizeof(record), offset)) {
+        LOG_GENERAL(WARNING, "Failed to read " << m_dataPath);
+        return false;
+      }
+    }
+    if (record.keyLength == 0) {
+      offset = chunkEnd;
+      continue;
+    }
+
+    const uint64_t end =
+        offset + sizeof(record) + record.keyLength + record.valueLength;
+    if (end > chunkEnd || end > fileSize) {
+      break;
+    }
+
+    zbytes key(record.keyLength);
+    if (!ReadFully(m_dataFd, key.data(), key.size(),
+                   offset + sizeof(record))) {
+      LOG_GENERAL(WARNING, "Failed to read " << m_dataPath);
+      return false;
+    }
+    Insert(HashKey(key), offset);
+    offset = end;
+  }
+
+  if (offset < fileSize) {
+    LOG_GENERAL(WARNING, "Dropping torn record at " << offset << " of "
+                                                    << m_dataPath);
+    if (ftruncate(m_dataFd, offset) != 0) {
+      LOG_GENERAL(WARNING, "Failed to truncate " << m_dataPath);
+      return false;
+    }
+    fileSize = offset;
+  }
+
+  m_dataSize = fileSize;
+  m_index->indexedSize = m_dataSize;
+  Touch(0);
+  return true;
+}
+
+void SegmentStore::Segment::Insert(uint64_t hash, uint64_t offset) {
+  // Keeps probe sequences short
+  if ((m_index->count + 1) * 4 > m_index->capacity * 3) {
+    GrowIndex();
+  }
+  const uint64_t slot = Place(m_index, hash, offset);
+  Touch(0);
+  Touch(sizeof(IndexHeader) + slot * sizeof(IndexSlot));
+}
+
+void SegmentStore::Segment::GrowIndex() {
+  auto data = MakeIndex(m_index->capacity * 2);
+  auto* index = reinterpret_cast<IndexHeader*>(data.data());
+  const auto* slots = Slots(m_index);
+  for (uint64_t i = 0; i < m_index->capacity; i++) {
+    if (slots[i].offset != 0) {
+      Place(index, slots[i].keyHash, slots[i].offset - 1);
+    }
+  }
+  index->indexedSize = m_index->indexedSize;
+
+  UseIndex(std::move(data));
+  m_rewriteIndex = true;
+}
+
+shared_ptr<const zbyte> SegmentStore::Segment::Map(uint64_t offset) {
+  const uint64_t chunk = offset / m_chunkSize;
+
+  lock_guard<mutex> g(m_mutexChunks);
+  if (m_chunks.size() <= chunk) {
+    m_chunks.resize(chunk + 1);
+  }
+  if (!m_chunks[chunk]) {
+    // Appends past the current end of file show up through the shared
+    // mapping, so a chunk is mapped once
+    void* map = mmap(nullptr, m_chunkSize, PROT_READ, MAP_SHARED, m_dataFd,
+                     chunk * m_chunkSize);
+    if (map == MAP_FAILED) {
+      LOG_GENERAL(WARNING, "Failed to map " << m_dataPath << ": "
+                                            << strerror(errno));
+      return nullptr;
+    }
+    madvise(map, m_chunkSize, MADV_RANDOM);
+    const uint64_t size = m_chunkSize;
+    m_chunks[chunk] = shared_ptr<const zbyte>(
+        static_cast<const zbyte*>(map),
+        [size](const zbyte* p) { munmap(const_cast<zbyte*>(p), size); });
+  }
+  // Points at the record but owns the whole chunk
+  return shared_ptr<const zbyte>(m_chunks[chunk],
+                                 m_chunks[chunk].get() + offset % m_chunkSize);
+}
+
+bool SegmentStore::Segment::Find(const zbytes& key, uint64_t hash,
+                                 View& value) {
+  const uint64_t mask = m_index->capacity - 1;
+  const auto* slots = Slots(m_index);
+  for (uint64_t i = hash & mask; slots[i].offset != 0; i = (i + 1) & mask) {
+    if (slots[i].keyHash != hash) {
+      continue;
+    }
+
+    auto record = Map(slots[i].offset - 1);
+    if (!record) {
+      return false;
+    }
+    RecordHeader header{};
+    memcpy(&header, record.get(), sizeof(header));
+    if (header.keyLength == key.size() &&
+        memcmp(record.get() + sizeof(header), key.data(), key.size()) == 0) {
+      value.value = dev::zbytesConstRef(
+          record.get() + sizeof(header) + header.keyLength, header.valueLength);
+      value.chunk = std::move(record);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SegmentStore::Segment::Append(const zbytes& key, uint64_t hash,
+                                   dev::zbytesConstRef value) {
+  const RecordHeader header{static_cast<uint32_t>(key.size()),
+                            static_cast<uint32_t>(value.size())};
+  const uint64_t recordSize = sizeof(header) + key.size() + value.size();
+  if (recordSize > m_chunkSize) {
+    LOG_GENERAL(WARNING, "Record of " << recordSize
+                                      << " bytes exceeds segment chunk size "
+                                      << m_chunkSize);
+    return false;
+  }
+
+  uint64_t offset = m_dataSize;
+  if (offset / m_chunkSize != (offset + recordSize - 1) / m_chunkSize) {
+    offset = (offset / m_chunkSize + 1) * m_chunkSize;
+  }
+
+  zbytes record(recordSize);
+  memcpy(record.data(), &header, sizeof(header));
+  memcpy(record.data() + sizeof(header), key.data(), key.size());
+  memcpy(record.data() + sizeof(header) + key.size(), value.data(),
+         value.size());
+  if (!WriteFully(m_dataFd, record.data(), record.size(), offset)) {
+    LOG_GENERAL(WARNING, "Failed to append to " << m_dataPath << ": "
+                                                << strerror(errno));
+    return false;
+  }
+
+  m_dataSize = offset + recordSize;
+  Insert(hash, offset);
+  m_index->indexedSize = m_dataSize;
+  return true;
+}
+
+bool SegmentStore::Segment::Sync() {
+  // Data first, so the index written back never points past synced data
+  if (fdatasync(m_dataFd) != 0) {
+    return false;
+  }
+  if (m_rewriteIndex) {
+    return RewriteIndex();
+  }
+  if (m_dirtyPages.empty()) {
+    return true;
+  }
+
+  const uint64_t size = IndexBytes(m_index->capacity);
+  const auto* bytes = reinterpret_cast<const char*>(m_indexData.data());
+  for (const auto page : m_dirtyPages) {
+    const uint64_t offset = page * INDEX_PAGE_SIZE;
+    if (!WriteFully(m_indexFd, bytes + offset,
+                    min(INDEX_PAGE_SIZE, size - offset), offset)) {
+      return false;
+    }
+  }
+  if (fdatasync(m_indexFd) != 0) {
+    return false;
+  }
+  m_dirtyPages.clear();
+  return true;
+}
+
+SegmentStore::SegmentStore(const string& name, const string& path)
+    : m_dir((path.empty() ? STORAGE_PATH + PERSISTENCE_PATH : path) + "/" +
+            name) {
+  std::filesystem::create_directories(m_dir);
+}
+
+SegmentStore::~SegmentStore() = default;
+
+SegmentStore::Segment* SegmentStore::OpenSegment(uint64_t segment) {
+  auto it = m_segments.find(segment);
+  if (it != m_segments.end()) {
+    return it->second.get();
+  }
+
+  const string base = m_dir + "/" + to_string(segment);
+  auto opened = make_unique<Segment>();
+  if (!opened->Open(base + ".dat", base + ".idx")) {
+    return nullptr;
+  }
+  return m_segments.emplace(segment, std::move(opened)).first->second.get();
+}
+
+bool SegmentStore::Put(uint64_t segment, const zbytes& key,
+                       dev::zbytesConstRef value) {
+  if (key.empty()) {
+    LOG_GENERAL(WARNING, "Empty keys are not supported");
+    return false;
+  }
+
+  unique_lock<shared_mutex> g(m_mutex);
+  auto* opened = OpenSegment(segment);
+  if (opened == nullptr) {
+    return false;
+  }
+
+  const uint64_t hash = HashKey(key);
+  View existing;
+  if (opened->Find(key, hash, existing)) {
+    return true;
+  }
+  return opened->Append(key, hash, value);
+}
+
+bool SegmentStore::Get(uint64_t segment, const zbytes& key, View& value) {
+  const uint64_t hash = HashKey(key);
+  {
+    shared_lock<shared_mutex> g(m_mutex);
+    auto it = m_segments.find(segment);
+    if (it != m_segments.end()) {
+      return it->second->Find(key, hash, value);
+    }
+  }
+
+  // Lookups into segments never written shouldn't create them
+  if (!std::filesystem::exists(m_dir + "/" + to_string(segment) + ".dat")) {
+    return false;
+  }
+
+  unique_lock<shared_mutex> g(m_mutex);
+  auto* opened = OpenSegment(segment);
+  return opened != nullptr && opened->Find(key, hash, value);
+}
+
+bool SegmentStore::Exists(uint64_t segment, const zbytes& key) {
+  View value;
+  return Get(segment, key, value);
+}
+
+bool SegmentStore::Flush() {
+  shared_lock<shared_mutex> g(m_mutex);
+  lock_guard<mutex> f(m_mutexFlush);
+  bool ret = true;
+  for (auto& [index, segment] : m_segments) {
+    if (!segment->Sync()) {
+      LOG_GENERAL(WARNING, "Failed to sync " << segment->m_dataPath << ": "
+                                             << strerror(errno));
+      ret = false;
+    }
+  }
+  return ret;
+}
+
+void SegmentStore::Close() {
+  unique_lock<shared_mutex> g(m_mutex);
+  m_segments.clear();
+}
+
+bool SegmentStore::Reset() {
+  unique_lock<shared_mutex> g(m_mutex);
+  m_segments.clear();
+
+  std::error_code ec;
+  std::filesystem::remove_all(m_dir, ec);
+  if (!ec) {
+    std::filesystem::create_directories(m_dir, ec);
+  }
+  if (ec) {
+    LOG_GENERAL(WARNING, "Failed to reset " << m_dir << ": " << ec.message());
+    return false;
+  }
+  return true;
+}
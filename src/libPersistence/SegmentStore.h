@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBPERSISTENCE_SEGMENTSTORE_H_
+#define ZILLIQA_SRC_LIBPERSISTENCE_SEGMENTSTORE_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include "common/BaseType.h"
+#include "depends/common/Common.h"
+
+/// Append-only storage for values that never change once written, such as
+/// tx bodies and microblocks. Each segment pairs a data file of records with
+/// an open addressing index from key hash to record offset, so there is
+/// nothing to compact and reads are views straight into the mapped data.
+class SegmentStore : boost::noncopyable {
+ public:
+  /// Keeps its segments under path/name, path defaulting to the
+  /// persistence directory.
+  explicit SegmentStore(const std::string& name, const std::string& path = "");
+  ~SegmentStore();
+
+  /// Appends the value to the segment, keeping any value already stored for
+  /// the key since stored values are immutable.
+  bool Put(uint64_t segment, const zbytes& key, dev::zbytesConstRef value);
+
+  /// A value in a mapped segment. It holds the mapped chunk, so the value
+  /// stays readable after Close or Reset drop the segment.
+  struct View {
+    std::shared_ptr<const zbyte> chunk;
+    dev::zbytesConstRef value;
+  };
+
+  bool Get(uint64_t segment, const zbytes& key, View& value);
+
+  bool Exists(uint64_t segment, const zbytes& key);
+
+  /// Syncs appended data and then writes back the index of every open
+  /// segment, which is only rebuilt from the data after a crash otherwise.
+  bool Flush();
+
+  /// Unmaps every segment, they are reopened on next access.
+  void Close();
+
+  /// Deletes every segment.
+  bool Reset();
+
+ private:
+  struct Segment;
+
+  /// Opens the segment if needed, callers hold m_mutex exclusively.
+  Segment* OpenSegment(uint64_t segment);
+
+  std::string m_dir;
+  std::shared_mutex m_mutex;
+  /// Serializes Flush, which only holds m_mutex shared
+  std::mutex m_mutexFlush;
+  std::map<uint64_t, std::unique_ptr<Segment>> m_segments;
+};
+
+#endif  // ZILLIQA_SRC_LIBPERSISTENCE_SEGMENTSTORE_H_
@@ -21,16 +21,25 @@
 #include "libUtils/DetachedFunction.h"
 #include "libMetrics/Api.h"
 
+#include <algorithm>
+
 #include <boost/asio.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/process/args.hpp>
 #include <boost/range/iterator_range.hpp>
 
+#include <signal.h>
+
 using namespace std::filesystem;
 
 ScillaClient::~ScillaClient() {
-  for (auto& process : m_child_processes) {
-    process.second.terminate();
+  for (auto& pool : m_pools) {
+    for (auto& worker : pool.second) {
+      std::error_code ec;
+      if (worker->process.valid()) {
+        worker->process.terminate(ec);
+      }
+    }
   }
 }
 
@@ -67,25 +76,50 @@ void ScillaClient::Init() {
   }
 }
 
+std::string ScillaClient::GetSocketPath(uint32_t version, size_t index) {
+  std::string path = SCILLA_SERVER_SOCKET_PATH;
+  if (ENABLE_SCILLA_MULTI_VERSION) {
+    path += "." + std::to_string(version);
+  }
+  // The first worker keeps the socket path used before pooling
+  if (index > 0) {
+    path += ".w" + std::to_string(index);
+  }
+  return path;
+}
+
 bool ScillaClient::isScillaRuning(uint32_t version) {
-  const auto iter = m_child_processes.find(version);
-  if (iter == m_child_processes.end())
+  std::lock_guard<std::mutex> g(m_mutexMain);
+  const auto iter = m_pools.find(version);
+  if (iter == m_pools.end()) {
     return false;
+  }
 
-  return iter->second.running();
+  for (auto& worker : iter->second) {
+    // A lent worker is owned by its caller, only look at its pid
+    if (worker->busy ? worker->pid > 0
+                     : worker->client && IsServerRunning(*worker)) {
+      return true;
+    }
+  }
+  return false;
 }
 
-bool ScillaClient::OpenServer(uint32_t version) {
+bool ScillaClient::OpenServer(Worker& worker) {
   LOG_MARKER();
 
-  auto iter = m_child_processes.find(version);
-  if (iter != m_child_processes.end()) {
-    iter->second.terminate();
-    m_child_processes.erase(iter);
+  {
+    std::lock_guard<std::mutex> g(m_mutexMain);
+    worker.pid = 0;
+  }
+
+  if (worker.process.valid()) {
+    std::error_code ec;
+    worker.process.terminate(ec);
   }
 
   std::string root_w_version;
-  if (!ScillaUtils::PrepareRootPathWVersion(version, root_w_version)) {
+  if (!ScillaUtils::PrepareRootPathWVersion(worker.version, root_w_version)) {
     LOG_GENERAL(WARNING, "ScillaUtils::PrepareRootPathWVersion failed");
     return false;
   }
@@ -98,159 +132,209 @@ bool ScillaClient::OpenServer(uint32_t version) {
     return false;
   }
 
-  const std::vector<std::string> args {
-      "-socket",
-      (ENABLE_SCILLA_MULTI_VERSION ?
-          SCILLA_SERVER_SOCKET_PATH + "." + std::to_string(version) :
-          SCILLA_SERVER_SOCKET_PATH)
-  };
+  const std::vector<std::string> args{"-socket", worker.socketPath};
 
-  boost::process::child child =
-      boost::process::child(server_path.native(), boost::process::args(args));
+  try {
+    worker.process = boost::process::child(server_path.native(),
+                                           boost::process::args(args));
+  } catch (const std::exception& e) {
+    LOG_GENERAL(WARNING, "Failed to spawn " << server_path << ": " << e.what());
+    return false;
+  }
 
-  const pid_t thread_id = child.id();
-  if (thread_id > 0 && child.valid()) {
+  const pid_t thread_id = worker.process.id();
+  if (thread_id > 0 && worker.process.valid()) {
     if (LOG_SC) {
-      LOG_GENERAL(INFO, "Valid child created at " << thread_id);
+      LOG_GENERAL(INFO, "Valid child created at " << thread_id << " for "
+                                                  << worker.socketPath);
     }
   } else {
     LOG_GENERAL(WARNING, "child is not valid " << thread_id);
     return false;
   }
 
-  m_child_processes.insert(std::make_pair(version, std::move(child)));
-
-  std::this_thread::sleep_for(
-      std::chrono::milliseconds(SCILLA_SERVER_PENDING_IN_MS));
-
+  std::lock_guard<std::mutex> g(m_mutexMain);
+  worker.pid = thread_id;
   return true;
 }
 
-void ScillaClient::RestartScillaClient() {
-  LOG_MARKER();
-  if (ENABLE_SCILLA_MULTI_VERSION == true) {
-    for (const auto& entry : m_clients) {
-      CheckClient(entry.first, true);
+size_t ScillaClient::StartWorkers(const std::vector<Worker*>& workers) {
+  std::vector<Worker*> spawned;
+  for (auto* worker : workers) {
+    worker->client.reset();
+    worker->connector.reset();
+    if (OpenServer(*worker)) {
+      spawned.push_back(worker);
+    } else {
+      LOG_GENERAL(WARNING, "OpenServer for version " << worker->version
+                                                     << " worker "
+                                                     << worker->index
+                                                     << " failed");
     }
-  } else {
-    CheckClient(0, true);
   }
-}
-
-bool ScillaClient::CheckClient(uint32_t version, bool enforce) {
-  std::lock_guard<std::mutex> g(m_mutexMain);
 
-  if (m_clients.find(version) != m_clients.end() && !enforce) {
-    return true;
+  if (!spawned.empty()) {
+    // All servers boot in parallel, so wait for them only once
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(SCILLA_SERVER_PENDING_IN_MS));
   }
 
-  if (!OpenServer(version)) {
-    LOG_GENERAL(WARNING, "OpenServer for version " << version << "failed");
-    return false;
+  for (auto* worker : spawned) {
+    worker->connector =
+        std::make_unique<rpc::UnixDomainSocketClient>(worker->socketPath);
+    worker->client = std::make_unique<jsonrpc::Client>(
+        *worker->connector, jsonrpc::JSONRPC_CLIENT_V2);
   }
 
-  m_connectors[version] = std::make_unique<rpc::UnixDomainSocketClient>(
-      SCILLA_SERVER_SOCKET_PATH +
-      (ENABLE_SCILLA_MULTI_VERSION ? ("." + std::to_string(version)) : ""));
-
-  m_clients[version] = std::make_unique<jsonrpc::Client>(
-      *m_connectors.at(version), jsonrpc::JSONRPC_CLIENT_V2);
+  std::lock_guard<std::mutex> g(m_mutexMain);
+  for (auto* worker : workers) {
+    worker->restartPending = !worker->client;
+    worker->busy = false;
+  }
+  m_cvWorkerFree.notify_all();
 
-  return true;
+  return spawned.size();
 }
 
-bool ScillaClient::CallChecker(uint32_t version, const Json::Value& _json,
-                               std::string& result, uint32_t counter) {
-  if (counter == 0) {
-    return false;
-  }
-
-  if (!ENABLE_SCILLA_MULTI_VERSION) {
-    version = 0;
+void ScillaClient::RestartScillaClient() {
+  LOG_MARKER();
+  std::vector<uint32_t> versions;
+  {
+    std::lock_guard<std::mutex> g(m_mutexMain);
+    for (const auto& entry : m_pools) {
+      versions.push_back(entry.first);
+    }
   }
 
-  if (!CheckClient(version)) {
-    LOG_GENERAL(WARNING, "CheckClient failed");
-    return false;
+  if (ENABLE_SCILLA_MULTI_VERSION == true) {
+    for (const auto& version : versions) {
+      CheckClient(version, true);
+    }
+  } else {
+    CheckClient(0, true);
   }
+}
 
-  try {
+bool ScillaClient::CheckClient(uint32_t version, bool enforce) {
+  std::vector<Worker*> toStart;
+  {
     std::lock_guard<std::mutex> g(m_mutexMain);
-    result = m_clients.at(version)->CallMethod("check", _json).asString();
-  } catch (jsonrpc::JsonRpcException& e) {
-    LOG_GENERAL(WARNING, "CallChecker failed: " << e.what());
-    if (std::string(e.what()).find(SCILLA_SERVER_SOCKET_PATH) !=
-        std::string::npos) {
-      if (!CheckClient(version, true)) {
-        LOG_GENERAL(WARNING, "CheckClient for version " << version << "failed");
-        return CallChecker(version, _json, result, counter - 1);
+
+    auto iter = m_pools.find(version);
+    if (iter != m_pools.end() && !enforce) {
+      return true;
+    }
+
+    if (iter == m_pools.end()) {
+      const size_t poolSize = std::max(SCILLA_SERVER_POOL_SIZE, 1u);
+      iter = m_pools.emplace(version, WorkerPool{}).first;
+      for (size_t i = 0; i < poolSize; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->version = version;
+        worker->index = i;
+        worker->socketPath = GetSocketPath(version, i);
+        worker->busy = true;
+        toStart.push_back(worker.get());
+        iter->second.emplace_back(std::move(worker));
       }
     } else {
-      if (e.GetCode() == jsonrpc::Errors::ERROR_RPC_JSON_PARSE_ERROR ||
-          e.GetCode() == jsonrpc::Errors::ERROR_CLIENT_CONNECTOR){
-        LOG_GENERAL(WARNING, "Looks like connection problem");
-        if (!isScillaRuning(version)) {
-          LOG_GENERAL(WARNING, "Scilla is not running");
-          CheckClient(version,true);
+      for (auto& worker : iter->second) {
+        if (worker->busy) {
+          // Kill the process under its current caller so the call fails fast,
+          // the next caller to acquire the worker restarts it
+          worker->restartPending = true;
+          if (worker->pid > 0) {
+            ::kill(worker->pid, SIGKILL);
+          }
+        } else {
+          worker->busy = true;
+          toStart.push_back(worker.get());
         }
-        return CallChecker(version, _json, result, counter - 1);
       }
-      result = e.what();
     }
+  }
 
+  if (toStart.empty()) {
+    return true;
+  }
+
+  const auto started = StartWorkers(toStart);
+  if (started == 0) {
+    LOG_GENERAL(WARNING, "No scilla-server could be started for version "
+                             << version);
     return false;
   }
 
+  if (started < toStart.size()) {
+    LOG_GENERAL(WARNING, "Started " << started << " of " << toStart.size()
+                                    << " scilla-server(s) for version "
+                                    << version);
+  }
   return true;
 }
 
-bool ScillaClient::CallRunner(uint32_t version, const Json::Value& _json,
-                              std::string& result, uint32_t counter) {
-  if (counter == 0) {
-    return false;
-  }
+bool ScillaClient::IsServerRunning(Worker& worker) {
+  std::error_code ec;
+  return worker.process.running(ec);
+}
 
-  if (!ENABLE_SCILLA_MULTI_VERSION) {
-    version = 0;
-  }
+ScillaClient::Worker* ScillaClient::AcquireWorker(uint32_t version) {
+  for (uint32_t attempt = 0; attempt < std::max(MAXRETRYCONN, 1u); ++attempt) {
+    Worker* acquired = nullptr;
+    bool restart = false;
+    {
+      std::unique_lock<std::mutex> lk(m_mutexMain);
+      while (acquired == nullptr) {
+        const auto iter = m_pools.find(version);
+        if (iter == m_pools.end()) {
+          return nullptr;
+        }
 
-  if (!CheckClient(version)) {
-    LOG_GENERAL(WARNING, "CheckClient failed");
-    return false;
-  }
+        for (auto& worker : iter->second) {
+          if (!worker->busy) {
+            acquired = worker.get();
+            break;
+          }
+        }
 
-  try {
-    std::lock_guard<std::mutex> g(m_mutexMain);
-    result = m_clients.at(version)->CallMethod("run", _json).asString();
-  } catch (jsonrpc::JsonRpcException& e) {
-    LOG_GENERAL(WARNING, "CallRunner failed: " << e.what());
-    if (std::string(e.what()).find(SCILLA_SERVER_SOCKET_PATH) !=
-        std::string::npos) {
-      if (!CheckClient(version, true)) {
-        LOG_GENERAL(WARNING, "CheckClient for version " << version << "failed");
-        return CallRunner(version, _json, result, counter - 1);
-      }
-    } else {
-      if (e.GetCode() == jsonrpc::Errors::ERROR_RPC_JSON_PARSE_ERROR ||
-          e.GetCode() == jsonrpc::Errors::ERROR_CLIENT_CONNECTOR){
-        LOG_GENERAL(WARNING, "Looks like connection problem");
-        if (!isScillaRuning(version)) {
-          LOG_GENERAL(WARNING, "Scilla is not running");
-          CheckClient(version,true);
+        if (acquired == nullptr) {
+          m_cvWorkerFree.wait(lk);
         }
-        return CallChecker(version, _json, result, counter - 1);
       }
-      result = e.what();
+
+      acquired->busy = true;
+      // Health check before lending the worker out
+      restart = acquired->restartPending || !acquired->client ||
+                !IsServerRunning(*acquired);
     }
 
-    return false;
+    if (!restart) {
+      return acquired;
+    }
+
+    LOG_GENERAL(WARNING, "scilla-server at " << acquired->socketPath
+                                             << " is not healthy, restarting");
+    if (StartWorkers({acquired}) == 0) {
+      return nullptr;
+    }
   }
 
-  return true;
+  LOG_GENERAL(WARNING, "No healthy scilla-server for version " << version);
+  return nullptr;
 }
 
-bool ScillaClient::CallDisambiguate(uint32_t version, const Json::Value& _json,
-                                    std::string& result, uint32_t counter) {
+void ScillaClient::ReleaseWorker(Worker& worker, bool restart) {
+  std::lock_guard<std::mutex> g(m_mutexMain);
+  if (restart) {
+    worker.restartPending = true;
+  }
+  worker.busy = false;
+  m_cvWorkerFree.notify_all();
+}
+
+bool ScillaClient::CallMethod(const std::string& method, uint32_t version,
+                              const Json::Value& _json, std::string& result,
+                              uint32_t counter) {
   if (counter == 0) {
     return false;
   }
@@ -264,33 +348,44 @@ bool ScillaClient::CallDisambiguate(uint32_t version, const Json::Value& _json,
     return false;
   }
 
+  WorkerLease worker(*this, AcquireWorker(version));
+  if (!worker) {
+    LOG_GENERAL(WARNING, "No scilla-server available for version " << version);
+    return false;
+  }
+
   try {
-    std::lock_guard<std::mutex> g(m_mutexMain);
-    result =
-        m_clients.at(version)->CallMethod("disambiguate", _json).asString();
+    result = worker->client->CallMethod(method, _json).asString();
   } catch (jsonrpc::JsonRpcException& e) {
-    LOG_GENERAL(WARNING, "CallDisambiguate failed: " << e.what());
+    LOG_GENERAL(WARNING, "Call to " << method << " on " << worker->socketPath
+                                    << " failed: " << e.what());
     if (std::string(e.what()).find(SCILLA_SERVER_SOCKET_PATH) !=
-        std::string::npos) {
-      if (!CheckClient(version, true)) {
-        LOG_GENERAL(WARNING, "CheckClient for version " << version << "failed");
-        return CallDisambiguate(version, _json, result, counter - 1);
-      }
-    } else {
-      if (e.GetCode() == jsonrpc::Errors::ERROR_RPC_JSON_PARSE_ERROR ||
-          e.GetCode() == jsonrpc::Errors::ERROR_CLIENT_CONNECTOR){
-        LOG_GENERAL(WARNING, "Looks like connection problem");
-        if (!isScillaRuning(version)) {
-          LOG_GENERAL(WARNING, "Scilla is not running");
-          CheckClient(version,true);
-        }
-        return CallChecker(version, _json, result, counter - 1);
-      }
-      result = e.what();
+            std::string::npos ||
+        e.GetCode() == jsonrpc::Errors::ERROR_RPC_JSON_PARSE_ERROR ||
+        e.GetCode() == jsonrpc::Errors::ERROR_CLIENT_CONNECTOR) {
+      LOG_GENERAL(WARNING, "Looks like connection problem");
+      worker.Release(true);
+      return CallMethod(method, version, _json, result, counter - 1);
     }
 
+    result = e.what();
     return false;
   }
 
   return true;
 }
+
+bool ScillaClient::CallChecker(uint32_t version, const Json::Value& _json,
+                               std::string& result, uint32_t counter) {
+  return CallMethod("check", version, _json, result, counter);
+}
+
+bool ScillaClient::CallRunner(uint32_t version, const Json::Value& _json,
+                              std::string& result, uint32_t counter) {
+  return CallMethod("run", version, _json, result, counter);
+}
+
+bool ScillaClient::CallDisambiguate(uint32_t version, const Json::Value& _json,
+                                    std::string& result, uint32_t counter) {
+  return CallMethod("disambiguate", version, _json, result, counter);
+}
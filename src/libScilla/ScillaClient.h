@@ -19,24 +19,86 @@
 #define ZILLIQA_SRC_LIBSCILLA_SCILLACLIENT_H_
 
 #include <boost/process/child.hpp>
+#include <condition_variable>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "common/Constants.h"
 #include "libScilla/UnixDomainSocketClient.h"
 
+/// Pool of scilla-server processes per scilla version. Each worker owns its
+/// own process and socket, so up to SCILLA_SERVER_POOL_SIZE checker/runner
+/// calls per version can be served concurrently. A worker is lent to one
+/// caller at a time, checked for liveness before being lent out and restarted
+/// whenever it dies or a connection to it fails.
 class ScillaClient {
-  std::map<uint32_t, std::unique_ptr<jsonrpc::Client>> m_clients;
-  std::map<uint32_t, std::unique_ptr<rpc::UnixDomainSocketClient>> m_connectors;
-  std::map<uint32_t, boost::process::child> m_child_processes;
+ protected:
+  struct Worker {
+    uint32_t version{};
+    size_t index{};
+    std::string socketPath;
+    boost::process::child process;
+    pid_t pid{0};
+    std::unique_ptr<rpc::UnixDomainSocketClient> connector;
+    std::unique_ptr<jsonrpc::Client> client;
+    bool busy{false};
+    bool restartPending{false};
+  };
+
+  ScillaClient() = default;
+  virtual ~ScillaClient();
+
+  static std::string GetSocketPath(uint32_t version, size_t index);
+
+  virtual bool OpenServer(Worker& worker);
+  /// Called with m_mutexMain held
+  virtual bool IsServerRunning(Worker& worker);
+
+ private:
+  /// Hands an acquired worker back to its pool when going out of scope,
+  /// whichever way the call using it ends
+  class WorkerLease {
+   public:
+    WorkerLease(ScillaClient& owner, Worker* worker)
+        : m_owner(owner), m_worker(worker) {}
+    WorkerLease(const WorkerLease&) = delete;
+    WorkerLease& operator=(const WorkerLease&) = delete;
+    ~WorkerLease() { Release(false); }
+
+    explicit operator bool() const { return m_worker != nullptr; }
+    Worker* operator->() const { return m_worker; }
+
+    void Release(bool restart) {
+      if (m_worker != nullptr) {
+        m_owner.ReleaseWorker(*m_worker, restart);
+        m_worker = nullptr;
+      }
+    }
+
+   private:
+    ScillaClient& m_owner;
+    Worker* m_worker;
+  };
+
+  using WorkerPool = std::vector<std::unique_ptr<Worker>>;
+
+  std::map<uint32_t, WorkerPool> m_pools;
 
   std::mutex m_mutexMain;
+  std::condition_variable m_cvWorkerFree;
 
-  ScillaClient() = default;
-  ~ScillaClient();
+  size_t StartWorkers(const std::vector<Worker*>& workers);
+
+  /// Waits for a free worker of the version, restarting unhealthy ones up to
+  /// MAXRETRYCONN times before giving up
+  Worker* AcquireWorker(uint32_t version);
+  void ReleaseWorker(Worker& worker, bool restart);
 
-  bool OpenServer(uint32_t version);
+  bool CallMethod(const std::string& method, uint32_t version,
+                  const Json::Value& _json, std::string& result,
+                  uint32_t counter);
 
  public:
   static ScillaClient& GetInstance() {
@@ -44,6 +106,9 @@ class ScillaClient {
     return scillaclient;
   }
 
+  /// Makes sure the worker pool for the version is running. With enforce set,
+  /// every worker is restarted; busy ones are killed and restarted once their
+  /// caller hands them back.
   bool CheckClient(uint32_t version, bool enforce = false);
 
   void RestartScillaClient();
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ScillaFileStage.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "common/Constants.h"
+#include "libCrypto/Sha2.h"
+#include "libUtils/DataConversion.h"
+#include "libUtils/Logger.h"
+
+namespace {
+
+std::string ContentHash(const std::string& content) {
+  SHA256Calculator sha2;
+  sha2.Update(content);
+  return DataConversion::Uint8VecToHexStrRet(sha2.Finalize());
+}
+
+/// Writes through a temporary file, so a reader never sees a partial file
+bool WriteFileAtomically(const std::string& path, const std::string& content) {
+  const std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream os(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!os) {
+      return false;
+    }
+    os.write(content.data(), content.size());
+    if (!os) {
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    LOG_GENERAL(WARNING, "Cannot stage " << path << ": " << ec.message());
+    std::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+ScillaFileStage::ScillaFileStage() {
+  // Scoped by pid, several nodes of a local network may share the host
+  std::filesystem::path dir(SCILLA_STAGING_DIR);
+  if (dir.is_relative()) {
+    dir = std::filesystem::current_path() / dir;
+  }
+  dir /= std::to_string(getpid());
+  m_dir = dir.string();
+
+  std::error_code ec;
+  std::filesystem::remove_all(m_dir, ec);
+  std::filesystem::create_directories(m_dir, ec);
+  if (ec) {
+    LOG_GENERAL(WARNING, "Cannot create scilla staging directory "
+                             << m_dir << ": " << ec.message());
+  }
+}
+
+ScillaFileStage::~ScillaFileStage() {
+  std::error_code ec;
+  std::filesystem::remove_all(m_dir, ec);
+}
+
+bool ScillaFileStage::StageContent(const std::string& content,
+                                   const std::string& extension,
+                                   std::string& path) {
+  const std::string name = ContentHash(content) + extension;
+  path = m_dir + '/' + name;
+
+  std::lock_guard<std::mutex> g(m_mutex);
+
+  auto it = m_staged.find(name);
+  if (it != m_staged.end() && std::filesystem::exists(path)) {
+    it->second.lastUse = ++m_useCounter;
+    return true;
+  }
+
+  if (!std::filesystem::exists(m_dir)) {
+    std::error_code ec;
+    std::filesystem::create_directories(m_dir, ec);
+  }
+
+  if (!WriteFileAtomically(path, content)) {
+    m_staged.erase(name);
+    return false;
+  }
+
+  m_staged[name] = {++m_useCounter};
+  if (m_staged.size() > SCILLA_STAGING_MAX_FILES) {
+    EvictLeastRecentlyUsed(name);
+  }
+  return true;
+}
+
+void ScillaFileStage::EvictLeastRecentlyUsed(const std::string& keep) {
+  // Trim to three quarters of the limit so eviction does not run on every
+  // newly staged file
+  const size_t target = SCILLA_STAGING_MAX_FILES * 3 / 4;
+
+  std::vector<std::pair<uint64_t, std::string>> byAge;
+  byAge.reserve(m_staged.size());
+  for (const auto& [name, file] : m_staged) {
+    if (name != keep) {
+      byAge.emplace_back(file.lastUse, name);
+    }
+  }
+  std::sort(byAge.begin(), byAge.end());
+
+  std::error_code ec;
+  for (const auto& [lastUse, name] : byAge) {
+    if (m_staged.size() <= target) {
+      break;
+    }
+    std::filesystem::remove(m_dir + '/' + name, ec);
+    m_staged.erase(name);
+  }
+}
+
+bool ScillaFileStage::StageAt(const std::string& path,
+                              const std::string& content) {
+  const std::string hash = ContentHash(content);
+
+  std::lock_guard<std::mutex> g(m_mutex);
+
+  auto it = m_pathHashes.find(path);
+  if (it != m_pathHashes.end() && it->second == hash &&
+      std::filesystem::exists(path)) {
+    return true;
+  }
+
+  if (!WriteFileAtomically(path, content)) {
+    m_pathHashes.erase(path);
+    return false;
+  }
+  m_pathHashes[path] = hash;
+  return true;
+}
+
+std::string ScillaFileStage::GetScratchPath(const std::string& name) const {
+  return m_dir + '/' + name;
+}
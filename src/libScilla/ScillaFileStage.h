@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBSCILLA_SCILLAFILESTAGE_H_
+#define ZILLIQA_SRC_LIBSCILLA_SCILLAFILESTAGE_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/// Staging area for the files handed to the scilla interpreter. Contract
+/// code and init data are stored under the hash of their content, so a
+/// contract's files are written once and reused by every later invocation.
+class ScillaFileStage {
+  struct StagedFile {
+    uint64_t lastUse;
+  };
+
+  std::string m_dir;
+  std::unordered_map<std::string, StagedFile> m_staged;
+  std::unordered_map<std::string, std::string> m_pathHashes;
+  uint64_t m_useCounter = 0;
+
+  std::mutex m_mutex;
+
+  ScillaFileStage();
+  ~ScillaFileStage();
+
+  void EvictLeastRecentlyUsed(const std::string& keep);
+
+ public:
+  static ScillaFileStage& GetInstance() {
+    static ScillaFileStage stage;
+    return stage;
+  }
+
+  /// Sets path to a staged file with the given content and extension,
+  /// writing it only if no such file is staged yet
+  bool StageContent(const std::string& content, const std::string& extension,
+                    std::string& path);
+
+  /// Writes content to path unless it was the last content staged there
+  bool StageAt(const std::string& path, const std::string& content);
+
+  /// Absolute path of a per-invocation file in the staging directory
+  std::string GetScratchPath(const std::string& name) const;
+};
+
+#endif  // ZILLIQA_SRC_LIBSCILLA_SCILLAFILESTAGE_H_
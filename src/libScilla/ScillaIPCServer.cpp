@@ -22,6 +22,7 @@
 #include "ScillaUtils.h"
 #include "libUtils/GasConv.h"
 
+#include "depends/common/RLP.h"
 #include "libData/AccountStore/AccountStore.h"
 #include "libPersistence/BlockStorage.h"
 #include "libPersistence/ContractStorage.h"
@@ -225,6 +226,18 @@ ScillaIPCServer::ScillaIPCServer(AccountStore *parent,
       Procedure("fetchExternalStateValueB64", PARAMS_BY_NAME, JSON_OBJECT,
                 "addr", JSON_STRING, "query", JSON_STRING, NULL),
       &ScillaIPCServer::fetchExternalStateValueB64I);
+  // Batched variants take and return one base64 encoded RLP list, so many
+  // binary keys and values cross the socket in a single round trip
+  bindAndAddMethod(Procedure("fetchStateValueBatch", PARAMS_BY_NAME,
+                             JSON_OBJECT, "queries", JSON_STRING, NULL),
+                   &ScillaIPCServer::fetchStateValueBatchI);
+  bindAndAddMethod(Procedure("fetchExternalStateValueBatch", PARAMS_BY_NAME,
+                             JSON_OBJECT, "queries", JSON_STRING, NULL),
+                   &ScillaIPCServer::fetchExternalStateValueBatchI);
+  bindAndAddMethod(
+      Procedure("prefetchStateValues", PARAMS_BY_NAME, JSON_OBJECT, "addr",
+                JSON_STRING, "query", JSON_STRING, NULL),
+      &ScillaIPCServer::prefetchStateValuesI);
 
   bindAndAddMethod(Procedure("fetchStateJson", PARAMS_BY_NAME, JSON_OBJECT,
                              "addr", JSON_STRING, "vname", JSON_STRING, NULL),
@@ -310,6 +323,93 @@ void ScillaIPCServer::fetchExternalStateValueB64I(const Json::Value &request,
   response.append(Json::Value(type));
 }
 
+void ScillaIPCServer::fetchStateValueBatchI(const Json::Value &request,
+                                            Json::Value &response) {
+  INC_CALLS(GetCallsCounter());
+
+  // queries: RLP list of serialized ProtoScillaQuery
+  std::vector<zbytes> queries;
+  try {
+    const zbytes encoded = DataConversion::StringToCharArray(
+        base64_decode(request["queries"].asString()));
+    for (const auto &item : dev::RLP(encoded)) {
+      queries.emplace_back(item.toBytes());
+    }
+  } catch (const std::exception &e) {
+    throw JsonRpcException("Invalid batch query: " + std::string(e.what()));
+  }
+
+  std::vector<zbytes> values;
+  std::vector<bool> found;
+  if (!fetchStateValues(queries, values, found)) {
+    throw JsonRpcException("Fetching state values failed");
+  }
+
+  // result: RLP list of [found, value]
+  dev::RLPStream rlp(values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    rlp.appendList(2);
+    rlp << (found[i] ? 1u : 0u) << values[i];
+  }
+
+  // Prepare the result and finish.
+  response.clear();
+  response.append(Json::Value(true));
+  response.append(
+      Json::Value(base64_encode(rlp.out().data(), rlp.out().size())));
+}
+
+void ScillaIPCServer::fetchExternalStateValueBatchI(const Json::Value &request,
+                                                    Json::Value &response) {
+  INC_CALLS(GetCallsCounter());
+
+  // queries: RLP list of [address, serialized ProtoScillaQuery]
+  std::vector<std::pair<std::string, std::string>> queries;
+  try {
+    const zbytes encoded = DataConversion::StringToCharArray(
+        base64_decode(request["queries"].asString()));
+    for (const auto &item : dev::RLP(encoded)) {
+      queries.emplace_back(Address(item[0].toBytes()).hex(),
+                           item[1].toString());
+    }
+  } catch (const std::exception &e) {
+    throw JsonRpcException("Invalid batch query: " + std::string(e.what()));
+  }
+
+  // result: RLP list of [found, value, type]
+  dev::RLPStream rlp(queries.size());
+  for (const auto &query : queries) {
+    std::string value, type;
+    bool found;
+    if (!fetchExternalStateValue(query.first, query.second, value, found,
+                                 type)) {
+      throw JsonRpcException("Fetching external state values failed");
+    }
+    rlp.appendList(3);
+    rlp << (found ? 1u : 0u) << DataConversion::StringToCharArray(value)
+        << type;
+  }
+
+  // Prepare the result and finish.
+  response.clear();
+  response.append(Json::Value(true));
+  response.append(
+      Json::Value(base64_encode(rlp.out().data(), rlp.out().size())));
+}
+
+void ScillaIPCServer::prefetchStateValuesI(const Json::Value &request,
+                                           Json::Value &response) {
+  INC_CALLS(GetCallsCounter());
+
+  const auto count = prefetchStateValues(
+      request["addr"].asString(), base64_decode(request["query"].asString()));
+
+  // Only a hint, nothing to fail on. Report how much was read ahead.
+  response.clear();
+  response.append(Json::Value(true));
+  response.append(Json::Value(Json::UInt64(count)));
+}
+
 void ScillaIPCServer::updateStateValueI(const Json::Value &request,
                                         Json::Value &response) {
   INC_CALLS(GetCallsCounter());
@@ -356,6 +456,26 @@ bool ScillaIPCServer::fetchStateValue(const string &query, string &value,
   return true;
 }
 
+bool ScillaIPCServer::fetchStateValues(const std::vector<zbytes> &queries,
+                                       std::vector<zbytes> &values,
+                                       std::vector<bool> &found) {
+  INC_CALLS(GetCallsCounter());
+
+  return ContractStorage::GetContractStorage().FetchStateValues(
+      m_BCInfo.getCurContrAddr(), queries, values, found);
+}
+
+uint64_t ScillaIPCServer::prefetchStateValues(const std::string &addr,
+                                              const std::string &query) {
+  INC_CALLS(GetCallsCounter());
+
+  // An empty address refers to the contract being executed
+  const Address target = addr.empty() ? m_BCInfo.getCurContrAddr()
+                                      : Address(addr);
+  return ContractStorage::GetContractStorage().PrefetchStateValues(
+      target, DataConversion::StringToCharArray(query));
+}
+
 bool ScillaIPCServer::fetchExternalStateValue(const std::string &addr,
                                               const string &query,
                                               string &value, bool &found,
@@ -19,6 +19,7 @@
 
 #include <jsonrpccpp/server/abstractserver.h>
 
+#include "common/BaseType.h"
 #include "depends/common/FixedHash.h"
 #include "libData/AccountData/Address.h"
 #include "libMetrics/Api.h"
@@ -71,6 +72,12 @@ class ScillaIPCServer : public jsonrpc::AbstractServer<ScillaIPCServer> {
                                         Json::Value& response);
   inline virtual void fetchExternalStateValueB64I(const Json::Value& request,
                                                   Json::Value& response);
+  inline virtual void fetchStateValueBatchI(const Json::Value& request,
+                                            Json::Value& response);
+  inline virtual void fetchExternalStateValueBatchI(const Json::Value& request,
+                                                    Json::Value& response);
+  inline virtual void prefetchStateValuesI(const Json::Value& request,
+                                           Json::Value& response);
   inline virtual void fetchBlockchainInfoI(const Json::Value& request,
                                            Json::Value& response);
   inline virtual void fetchStateJsonI(const Json::Value& request,
@@ -86,6 +93,11 @@ class ScillaIPCServer : public jsonrpc::AbstractServer<ScillaIPCServer> {
                                        const std::string& query,
                                        std::string& value, bool& found,
                                        std::string& type);
+  virtual bool fetchStateValues(const std::vector<zbytes>& queries,
+                                std::vector<zbytes>& values,
+                                std::vector<bool>& found);
+  virtual uint64_t prefetchStateValues(const std::string& addr,
+                                       const std::string& query);
   virtual bool updateStateValue(const std::string& query,
                                 const std::string& value);
   virtual bool fetchBlockchainInfo(const std::string& query_name,
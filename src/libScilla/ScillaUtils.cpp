@@ -17,9 +17,12 @@
 
 #include "ScillaUtils.h"
 
+#include <thread>
 
 #include "common/Constants.h"
 #include "libData/AccountStore/AccountStore.h"
+#include "libScilla/ScillaFileStage.h"
+#include "libUtils/JsonUtils.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/Logger.h"
 
@@ -42,20 +45,31 @@ bool ScillaUtils::PrepareRootPathWVersion(const uint32_t& scilla_version,
   return true;
 }
 
+ScillaFilePaths ScillaUtils::GetDefaultFilePaths(bool is_library) {
+  const string cwd = std::filesystem::current_path().string() + '/';
+  return {cwd + INPUT_CODE +
+              (is_library ? LIBRARY_CODE_EXTENSION : CONTRACT_FILE_EXTENSION),
+          cwd + INIT_JSON, cwd + INPUT_MESSAGE_JSON};
+}
+
 Json::Value ScillaUtils::GetContractCheckerJson(const string& root_w_version,
                                                 bool is_library,
                                                 const uint64_t& available_gas) {
+  return GetContractCheckerJson(GetDefaultFilePaths(is_library),
+                                root_w_version, available_gas);
+}
+
+Json::Value ScillaUtils::GetContractCheckerJson(const ScillaFilePaths& files,
+                                                const string& root_w_version,
+                                                const uint64_t& available_gas) {
   Json::Value ret;
   ret["argv"].append("-init");
-  ret["argv"].append(std::filesystem::current_path().string() + '/' +
-                     INIT_JSON);
+  ret["argv"].append(files.init);
   ret["argv"].append("-libdir");
   ret["argv"].append(root_w_version + '/' + SCILLA_LIB + ":" +
                      std::filesystem::current_path().string() + '/' +
                      EXTLIB_FOLDER);
-  ret["argv"].append(
-      std::filesystem::current_path().string() + '/' + INPUT_CODE +
-      (is_library ? LIBRARY_CODE_EXTENSION : CONTRACT_FILE_EXTENSION));
+  ret["argv"].append(files.code);
   ret["argv"].append("-gaslimit");
   ret["argv"].append(to_string(available_gas));
   ret["argv"].append("-contractinfo");
@@ -67,19 +81,24 @@ Json::Value ScillaUtils::GetCreateContractJson(const string& root_w_version,
                                                bool is_library,
                                                const uint64_t& available_gas,
                                                const uint128_t& balance) {
+  return GetCreateContractJson(GetDefaultFilePaths(is_library), root_w_version,
+                               available_gas, balance);
+}
+
+Json::Value ScillaUtils::GetCreateContractJson(const ScillaFilePaths& files,
+                                               const string& root_w_version,
+                                               const uint64_t& available_gas,
+                                               const uint128_t& balance) {
   Json::Value ret;
   ret["argv"].append("-init");
-  ret["argv"].append(std::filesystem::current_path().string() + '/' +
-                     INIT_JSON);
+  ret["argv"].append(files.init);
   ret["argv"].append("-ipcaddress");
   ret["argv"].append(SCILLA_IPC_SOCKET_PATH);
   ret["argv"].append("-o");
   ret["argv"].append(std::filesystem::current_path().string() + '/' +
                      OUTPUT_JSON);
   ret["argv"].append("-i");
-  ret["argv"].append(
-      std::filesystem::current_path().string() + '/' + INPUT_CODE +
-      (is_library ? LIBRARY_CODE_EXTENSION : CONTRACT_FILE_EXTENSION));
+  ret["argv"].append(files.code);
   ret["argv"].append("-gaslimit");
   ret["argv"].append(to_string(available_gas));
   ret["argv"].append("-balance");
@@ -97,22 +116,26 @@ Json::Value ScillaUtils::GetCallContractJson(const string& root_w_version,
                                              const uint64_t& available_gas,
                                              const uint128_t& balance,
                                              const bool& is_library) {
+  return GetCallContractJson(GetDefaultFilePaths(is_library), root_w_version,
+                             available_gas, balance);
+}
+
+Json::Value ScillaUtils::GetCallContractJson(const ScillaFilePaths& files,
+                                             const string& root_w_version,
+                                             const uint64_t& available_gas,
+                                             const uint128_t& balance) {
   Json::Value ret;
   ret["argv"].append("-init");
-  ret["argv"].append(std::filesystem::current_path().string() + '/' +
-                     INIT_JSON);
+  ret["argv"].append(files.init);
   ret["argv"].append("-ipcaddress");
   ret["argv"].append(SCILLA_IPC_SOCKET_PATH);
   ret["argv"].append("-imessage");
-  ret["argv"].append(std::filesystem::current_path().string() + '/' +
-                     INPUT_MESSAGE_JSON);
+  ret["argv"].append(files.message);
   ret["argv"].append("-o");
   ret["argv"].append(std::filesystem::current_path().string() + '/' +
                      OUTPUT_JSON);
   ret["argv"].append("-i");
-  ret["argv"].append(
-      std::filesystem::current_path().string() + '/' + INPUT_CODE +
-      (is_library ? LIBRARY_CODE_EXTENSION : CONTRACT_FILE_EXTENSION));
+  ret["argv"].append(files.code);
   ret["argv"].append("-gaslimit");
   ret["argv"].append(to_string(available_gas));
   ret["argv"].append("-balance");
@@ -129,18 +152,20 @@ Json::Value ScillaUtils::GetCallContractJson(const string& root_w_version,
 }
 
 Json::Value ScillaUtils::GetDisambiguateJson() {
+  return GetDisambiguateJson(GetDefaultFilePaths(false));
+}
+
+Json::Value ScillaUtils::GetDisambiguateJson(const ScillaFilePaths& files) {
   Json::Value ret;
   ret["argv"].append("-iinit");
-  ret["argv"].append(std::filesystem::current_path().string() + '/' +
-                     INIT_JSON);
+  ret["argv"].append(files.init);
   ret["argv"].append("-ipcaddress");
   ret["argv"].append(SCILLA_IPC_SOCKET_PATH);
   ret["argv"].append("-oinit");
   ret["argv"].append(std::filesystem::current_path().string() + '/' +
                      OUTPUT_JSON);
   ret["argv"].append("-i");
-  ret["argv"].append(std::filesystem::current_path().string() + '/' +
-                     INPUT_CODE + CONTRACT_FILE_EXTENSION);
+  ret["argv"].append(files.code);
 
   return ret;
 }
@@ -215,6 +240,74 @@ bool ScillaUtils::ExportCreateContractFiles(
   return true;
 }
 
+bool ScillaUtils::StageContractFiles(
+    const std::string& code, const std::string& init_data, bool is_library,
+    const std::map<Address, std::pair<std::string, std::string>>&
+        extlibs_exports,
+    ScillaFilePaths& files) {
+  LOG_MARKER();
+
+  if (!(std::filesystem::exists("./" + SCILLA_LOG))) {
+    std::filesystem::create_directories("./" + SCILLA_LOG);
+  }
+  if (!(std::filesystem::exists("./" + SCILLA_FILES))) {
+    std::filesystem::create_directories("./" + SCILLA_FILES);
+  }
+
+  // The output of a previous invocation must not be mistaken for this one's
+  std::error_code ec;
+  std::filesystem::remove(OUTPUT_JSON, ec);
+
+  auto& stage = ScillaFileStage::GetInstance();
+
+  if (LOG_SC) {
+    LOG_GENERAL(INFO, "init data to export: " << init_data);
+  }
+
+  if (!stage.StageContent(
+          code, is_library ? LIBRARY_CODE_EXTENSION : CONTRACT_FILE_EXTENSION,
+          files.code) ||
+      !stage.StageContent(init_data, ".json", files.init)) {
+    LOG_GENERAL(WARNING, "Failed to stage contract files");
+    return false;
+  }
+
+  if (!(std::filesystem::exists(EXTLIB_FOLDER))) {
+    std::filesystem::create_directories(EXTLIB_FOLDER);
+  }
+
+  // Extlibs are looked up by address in the libdir, so they are staged in
+  // place and only rewritten when their content differs
+  for (const auto& extlib_export : extlibs_exports) {
+    const std::string base =
+        EXTLIB_FOLDER + '/' + "0x" + extlib_export.first.hex();
+    if (!stage.StageAt(base + LIBRARY_CODE_EXTENSION,
+                       extlib_export.second.first) ||
+        !stage.StageAt(base + ".json", extlib_export.second.second)) {
+      LOG_GENERAL(WARNING, "Failed to stage extlib " << extlib_export.first);
+      return false;
+    }
+  }
+
+  files.message.clear();
+  return true;
+}
+
+bool ScillaUtils::StageMessageFile(const Json::Value& message,
+                                   ScillaFilePaths& files) {
+  // Scoped per thread, pooled scilla-servers may run calls concurrently
+  files.message = ScillaFileStage::GetInstance().GetScratchPath(
+      std::filesystem::path(INPUT_MESSAGE_JSON).filename().string() + '.' +
+      std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+  try {
+    JSONUtils::GetInstance().writeJsontoFile(files.message, message);
+  } catch (const std::exception& e) {
+    LOG_GENERAL(WARNING, "Exception caught: " << e.what());
+    return false;
+  }
+  return true;
+}
+
 bool ScillaUtils::PopulateExtlibsExports(
     AccountStore& acc_store, uint32_t scilla_version,
     const std::vector<Address>& extlibs,
@@ -28,6 +28,13 @@
 
 class AccountStore;
 
+/// Absolute paths of the input files of one interpreter invocation
+struct ScillaFilePaths {
+  std::string code;
+  std::string init;
+  std::string message;
+};
+
 class ScillaUtils {
   using Address = dev::h160;
 
@@ -35,24 +42,52 @@ class ScillaUtils {
   static bool PrepareRootPathWVersion(const uint32_t& scilla_version,
                                       std::string& root_w_version);
 
+  /// paths of the files written by ExportCreateContractFiles and
+  /// ExportCommonFiles
+  static ScillaFilePaths GetDefaultFilePaths(bool is_library);
+
   /// get the command for invoking the scilla_checker while deploying
   static Json::Value GetContractCheckerJson(const std::string& root_w_version,
                                             bool is_library,
                                             const uint64_t& available_gas);
+  static Json::Value GetContractCheckerJson(const ScillaFilePaths& files,
+                                            const std::string& root_w_version,
+                                            const uint64_t& available_gas);
 
   /// get the command for invoking the scilla_runner while deploying
   static Json::Value GetCreateContractJson(
       const std::string& root_w_version, bool is_library,
       const uint64_t& available_gas,
       const boost::multiprecision::uint128_t& balance);
+  static Json::Value GetCreateContractJson(
+      const ScillaFilePaths& files, const std::string& root_w_version,
+      const uint64_t& available_gas,
+      const boost::multiprecision::uint128_t& balance);
 
   /// get the command for invoking the scilla_runner while calling
   static Json::Value GetCallContractJson(
       const std::string& root_w_version, const uint64_t& available_gas,
       const boost::multiprecision::uint128_t& balance, const bool& is_library);
+  static Json::Value GetCallContractJson(
+      const ScillaFilePaths& files, const std::string& root_w_version,
+      const uint64_t& available_gas,
+      const boost::multiprecision::uint128_t& balance);
 
   /// get the command for invoking disambiguate_state_json while calling
   static Json::Value GetDisambiguateJson();
+  static Json::Value GetDisambiguateJson(const ScillaFilePaths& files);
+
+  /// stage the code, init data and extlibs of a contract in the
+  /// content-addressed ScillaFileStage, rewriting nothing already staged
+  static bool StageContractFiles(
+      const std::string& code, const std::string& init_data, bool is_library,
+      const std::map<Address, std::pair<std::string, std::string>>&
+          extlibs_exports,
+      ScillaFilePaths& files);
+
+  /// stage the message of a contract call next to the staged contract files
+  static bool StageMessageFile(const Json::Value& message,
+                               ScillaFilePaths& files);
 
   /// export files that ExportCreateContractFiles and ExportContractFiles
   /// both needs
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "UnixDomainSocketFramedClient.h"
+
+#include "libUtils/Logger.h"
+
+#include <array>
+#include <boost/asio.hpp>
+#include <boost/endian.hpp>
+
+namespace rpc {
+
+namespace {
+
+// Upper bound on a single frame, guards against a corrupted size prefix
+constexpr uint32_t MAX_FRAME_SIZE = 256 * 1024 * 1024;
+
+}  // namespace
+
+bool UnixDomainSocketFramedClient::Connect() {
+  using boost::asio::local::stream_protocol;
+  try {
+    auto socket = std::make_unique<stream_protocol::socket>(m_ioContext);
+    socket->connect(stream_protocol::endpoint(m_path));
+    m_socket = std::move(socket);
+  } catch (std::exception& e) {
+    if (LOG_SC) {
+      LOG_GENERAL(INFO, "Exception calling connect " << e.what());
+    }
+    return false;
+  }
+  return true;
+}
+
+void UnixDomainSocketFramedClient::Close() {
+  if (m_socket) {
+    boost::system::error_code ec;
+    m_socket->close(ec);
+    m_socket.reset();
+  }
+}
+
+bool UnixDomainSocketFramedClient::Exchange(const std::string& request,
+                                            std::string& response) {
+  if (request.size() > MAX_FRAME_SIZE) {
+    LOG_GENERAL(WARNING, "Request frame too large: " << request.size());
+    return false;
+  }
+
+  try {
+    // The size prefix and the payload go out in one gathered write so the
+    // payload is never copied into a send buffer
+    const uint32_t requestSize =
+        boost::endian::native_to_big(static_cast<uint32_t>(request.size()));
+    const std::array<boost::asio::const_buffer, 2> frame{
+        boost::asio::buffer(&requestSize, sizeof(requestSize)),
+        boost::asio::buffer(request)};
+    boost::asio::write(*m_socket, frame);
+
+    uint32_t responseSize = 0;
+    boost::asio::read(*m_socket,
+                      boost::asio::buffer(&responseSize, sizeof(responseSize)));
+    responseSize = boost::endian::big_to_native(responseSize);
+    if (responseSize > MAX_FRAME_SIZE) {
+      LOG_GENERAL(WARNING, "Response frame too large: " << responseSize);
+      Close();
+      return false;
+    }
+
+    response.resize(responseSize);
+    boost::asio::read(*m_socket,
+                      boost::asio::buffer(response.data(), response.size()));
+  } catch (std::exception& e) {
+    if (LOG_SC) {
+      LOG_GENERAL(INFO, "Exception exchanging frames " << e.what());
+    }
+    Close();
+    return false;
+  }
+  return true;
+}
+
+bool UnixDomainSocketFramedClient::Call(const std::string& request,
+                                        std::string& response) {
+  const bool reused = static_cast<bool>(m_socket);
+  if (!reused && !Connect()) {
+    return false;
+  }
+
+  if (Exchange(request, response)) {
+    return true;
+  }
+
+  // The peer may have dropped an idle connection, retry on a fresh one
+  if (reused && Connect()) {
+    return Exchange(request, response);
+  }
+  return false;
+}
+
+}  // namespace rpc
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZILLIQA_SRC_LIBSCILLA_UNIXDOMAINSOCKETFRAMEDCLIENT_H_
+#define ZILLIQA_SRC_LIBSCILLA_UNIXDOMAINSOCKETFRAMEDCLIENT_H_
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include <memory>
+#include <string>
+
+// Client for a unix domain socket carrying length-prefixed binary frames:
+// a 4-byte big-endian payload size followed by the payload. Unlike the
+// jsonrpc connector, the connection is kept open between calls.
+
+namespace rpc {
+
+class UnixDomainSocketFramedClient {
+ public:
+  explicit UnixDomainSocketFramedClient(const std::string& path)
+      : m_path(path){};
+
+  /// Sends one request frame and waits for the response frame. Reconnects
+  /// once if the kept connection turns out to be broken.
+  bool Call(const std::string& request, std::string& response);
+
+  void Close();
+
+ private:
+  bool Connect();
+  bool Exchange(const std::string& request, std::string& response);
+
+  std::string m_path;
+  boost::asio::io_context m_ioContext;
+  std::unique_ptr<boost::asio::local::stream_protocol::socket> m_socket;
+};
+
+}  // namespace rpc
+
+#endif  // ZILLIQA_SRC_LIBSCILLA_UNIXDOMAINSOCKETFRAMEDCLIENT_H_
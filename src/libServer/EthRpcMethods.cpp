@@ -901,15 +901,14 @@ std::string EthRpcMethods::GetEthEstimateGas(const Json::Value &json,
     gas = min(gas, userGas);
   }
 
-  const auto txBlock = m_sharedMediator.m_txBlockChain.GetLastBlock();
-  const auto dsBlock = m_sharedMediator.m_dsBlockChain.GetLastBlock();
+  const auto txBlock = m_sharedMediator.m_txBlockChain.GetLastBlockPtr();
+  const auto dsBlock = m_sharedMediator.m_dsBlockChain.GetLastBlockPtr();
   // TODO: adapt to any block, not just latest.
   TxnExtras txnExtras{
-      dsBlock.GetHeader().GetGasPrice(),
-      txBlock.GetTimestamp() / 1000000,  // From microseconds to seconds.
-      dsBlock.GetHeader().GetDifficulty()};
-  uint64_t blockNum =
-      m_sharedMediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+      dsBlock->GetHeader().GetGasPrice(),
+      txBlock->GetTimestamp() / 1000000,  // From microseconds to seconds.
+      dsBlock->GetHeader().GetDifficulty()};
+  uint64_t blockNum = txBlock->GetHeader().GetBlockNum();
 
   {
     std::stringstream ss;
@@ -1031,16 +1030,14 @@ string EthRpcMethods::GetEthCallImpl(const Json::Value &_json,
                              "data argument invalid");
     }
 
-    const auto txBlock = m_sharedMediator.m_txBlockChain.GetLastBlock();
-    const auto dsBlock = m_sharedMediator.m_dsBlockChain.GetLastBlock();
+    const auto txBlock = m_sharedMediator.m_txBlockChain.GetLastBlockPtr();
+    const auto dsBlock = m_sharedMediator.m_dsBlockChain.GetLastBlockPtr();
     // TODO: adapt to any block, not just latest.
     TxnExtras txnExtras{
-        dsBlock.GetHeader().GetGasPrice(),
-        txBlock.GetTimestamp() / 1000000,  // From microseconds to seconds.
-        dsBlock.GetHeader().GetDifficulty()};
-    uint64_t blockNum = m_sharedMediator.m_txBlockChain.GetLastBlock()
-                            .GetHeader()
-                            .GetBlockNum();
+        dsBlock->GetHeader().GetGasPrice(),
+        txBlock->GetTimestamp() / 1000000,  // From microseconds to seconds.
+        dsBlock->GetHeader().GetDifficulty()};
+    uint64_t blockNum = txBlock->GetHeader().GetBlockNum();
 
     /*
      * EVM estimate only is currently disabled, as per n-hutton advice.
@@ -1357,12 +1354,12 @@ Json::Value EthRpcMethods::GetEthBlockNumber() {
   INC_CALLS(GetInvocationsCounter());
 
   try {
-    const auto txBlock = m_sharedMediator.m_txBlockChain.GetLastBlock();
+    const auto txBlock = m_sharedMediator.m_txBlockChain.GetLastBlockPtr();
 
-    auto const height = txBlock.GetHeader().GetBlockNum() ==
+    auto const height = txBlock->GetHeader().GetBlockNum() ==
                                 std::numeric_limits<uint64_t>::max()
                             ? 1
-                            : txBlock.GetHeader().GetBlockNum();
+                            : txBlock->GetHeader().GetBlockNum();
 
     std::ostringstream returnVal;
     returnVal << "0x" << std::hex << height << std::dec;
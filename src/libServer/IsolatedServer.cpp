@@ -1068,9 +1068,9 @@ Json::Value IsolatedServer::GetEthBlockNumber() {
   Json::Value ret;
 
   try {
-    const auto txBlock = m_mediator.m_txBlockChain.GetLastBlock();
+    const auto txBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
 
-    auto blockHeight = txBlock.GetHeader().GetBlockNum();
+    auto blockHeight = txBlock->GetHeader().GetBlockNum();
     blockHeight =
         blockHeight == std::numeric_limits<uint64_t>::max() ? 1 : blockHeight;
 
@@ -1160,10 +1160,10 @@ TxBlock IsolatedServer::GenerateTxBlock() {
     m_txnBlockNumMap[m_blocknum].clear();
   }
 
-  auto const prevTxBlock = m_sharedMediator.m_txBlockChain.GetLastBlock();
+  auto const prevTxBlock = m_sharedMediator.m_txBlockChain.GetLastBlockPtr();
 
   auto const prevHash =
-      m_blocknum == 0 ? BlockHash() : prevTxBlock.GetBlockHash();
+      m_blocknum == 0 ? BlockHash() : prevTxBlock->GetBlockHash();
 
   TxBlockHeader txblockheader(0, m_currEpochGas, 0, m_blocknum,
                               TxBlockHashSet(), numtxns, m_key.first, 1,
@@ -395,12 +395,7 @@ bool LookupServer::StartCollectorThread() {
         m_mediator.m_lookup->AddTxnToMemPool(tx);
       }
 
-      std::vector<Transaction> txnsInMemPool;
-      {
-        lock_guard<mutex> g(m_mediator.m_lookup->m_txnMemPoolMutex);
-        txnsInMemPool = m_mediator.m_lookup->GetTransactionsFromMemPool();
-        m_mediator.m_lookup->ClearTxnMemPool();
-      }
+      auto txnsInMemPool = m_mediator.m_lookup->DrainTxnMemPool();
 
       if (std::empty(txnsInMemPool)) {
         LOG_GENERAL(INFO, "Txn pool is empty - nothing to send");
@@ -787,13 +782,13 @@ Json::Value LookupServer::GetLatestDsBlock() {
   }
 
   LOG_MARKER();
-  DSBlock Latest = m_mediator.m_dsBlockChain.GetLastBlock();
+  const auto Latest = m_mediator.m_dsBlockChain.GetLastBlockPtr();
 
   LOG_EPOCH(INFO, m_mediator.m_currentEpochNum,
-            "BlockNum " << Latest.GetHeader().GetBlockNum()
-                        << "  Timestamp:        " << Latest.GetTimestamp());
+            "BlockNum " << Latest->GetHeader().GetBlockNum()
+                        << "  Timestamp:        " << Latest->GetTimestamp());
 
-  return JSONConversion::convertDSblocktoJson(Latest);
+  return JSONConversion::convertDSblocktoJson(*Latest);
 }
 
 Json::Value LookupServer::GetLatestTxBlock() {
@@ -803,13 +798,13 @@ Json::Value LookupServer::GetLatestTxBlock() {
     throw JsonRpcException(RPC_INVALID_REQUEST, "Sent to a non-lookup");
   }
 
-  TxBlock Latest = m_mediator.m_txBlockChain.GetLastBlock();
+  const auto Latest = m_mediator.m_txBlockChain.GetLastBlockPtr();
 
   LOG_GENERAL(DEBUG, "BlockNum "
-                         << Latest.GetHeader().GetBlockNum()
-                         << "  Timestamp:        " << Latest.GetTimestamp());
+                         << Latest->GetHeader().GetBlockNum()
+                         << "  Timestamp:        " << Latest->GetTimestamp());
 
-  return JSONConversion::convertTxBlocktoJson(Latest);
+  return JSONConversion::convertTxBlocktoJson(*Latest);
 }
 
 Json::Value LookupServer::GetBalanceAndNonce(const string& address) {
@@ -1154,7 +1149,7 @@ string LookupServer::GetNumTransactions() {
   if (m_BlockTxPair.first < currBlock) {
     for (uint64_t i = m_BlockTxPair.first + 1; i <= currBlock; i++) {
       m_BlockTxPair.second +=
-          m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+          m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
     }
   }
   m_BlockTxPair.first = currBlock;
@@ -1183,7 +1178,7 @@ size_t LookupServer::GetNumTransactions(uint64_t blockNum) {
   size_t i, res = 0;
 
   for (i = blockNum + 1; i <= currBlockNum; i++) {
-    res += m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+    res += m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
   }
 
   return res;
@@ -1386,7 +1381,8 @@ Json::Value LookupServer::DSBlockListing(unsigned int page) {
   if (m_DSBlockCache.second.size() == 0) {
     try {
       // add the hash of genesis block
-      DSBlockHeader dshead = m_mediator.m_dsBlockChain.GetBlock(0).GetHeader();
+      DSBlockHeader dshead =
+          m_mediator.m_dsBlockChain.GetBlockPtr(0)->GetHeader();
       SHA256Calculator sha2;
       zbytes vec;
       dshead.Serialize(vec, 0);
@@ -1406,15 +1402,13 @@ Json::Value LookupServer::DSBlockListing(unsigned int page) {
 
   if (currBlockNum > m_DSBlockCache.first) {
     for (uint64_t i = m_DSBlockCache.first + 1; i < currBlockNum; i++) {
+      const auto block = m_mediator.m_dsBlockChain.GetBlockPtr(i + 1);
       m_DSBlockCache.second.insert_new(m_DSBlockCache.second.size(),
-                                       m_mediator.m_dsBlockChain.GetBlock(i + 1)
-                                           .GetHeader()
-                                           .GetPrevHash()
-                                           .hex());
+                                       block->GetHeader().GetPrevHash().hex());
     }
     // for the latest block
     DSBlockHeader dshead =
-        m_mediator.m_dsBlockChain.GetBlock(currBlockNum).GetHeader();
+        m_mediator.m_dsBlockChain.GetBlockPtr(currBlockNum)->GetHeader();
     SHA256Calculator sha2;
     zbytes vec;
     dshead.Serialize(vec, 0);
@@ -1449,10 +1443,11 @@ Json::Value LookupServer::DSBlockListing(unsigned int page) {
     for (uint64_t i = offset;
          i < zil::paging::PAGE_SIZE + offset && i <= currBlockNum; i++) {
       tmpJson.clear();
-      tmpJson["Hash"] = m_mediator.m_dsBlockChain.GetBlock(currBlockNum - i + 1)
-                            .GetHeader()
-                            .GetPrevHash()
-                            .hex();
+      tmpJson["Hash"] =
+          m_mediator.m_dsBlockChain.GetBlockPtr(currBlockNum - i + 1)
+              ->GetHeader()
+              .GetPrevHash()
+              .hex();
       tmpJson["BlockNum"] = uint(currBlockNum - i);
       _json["data"].append(tmpJson);
     }
@@ -1485,7 +1480,8 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
   if (m_TxBlockCache.second.size() == 0) {
     try {
       // add the hash of genesis block
-      TxBlockHeader txhead = m_mediator.m_txBlockChain.GetBlock(0).GetHeader();
+      TxBlockHeader txhead =
+          m_mediator.m_txBlockChain.GetBlockPtr(0)->GetHeader();
       SHA256Calculator sha2;
       zbytes vec;
       txhead.Serialize(vec, 0);
@@ -1505,15 +1501,13 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
 
   if (currBlockNum > m_TxBlockCache.first) {
     for (uint64_t i = m_TxBlockCache.first + 1; i < currBlockNum; i++) {
+      const auto block = m_mediator.m_txBlockChain.GetBlockPtr(i + 1);
       m_TxBlockCache.second.insert_new(m_TxBlockCache.second.size(),
-                                       m_mediator.m_txBlockChain.GetBlock(i + 1)
-                                           .GetHeader()
-                                           .GetPrevHash()
-                                           .hex());
+                                       block->GetHeader().GetPrevHash().hex());
     }
     // for the latest block
     TxBlockHeader txhead =
-        m_mediator.m_txBlockChain.GetBlock(currBlockNum).GetHeader();
+        m_mediator.m_txBlockChain.GetBlockPtr(currBlockNum)->GetHeader();
     SHA256Calculator sha2;
     zbytes vec;
     txhead.Serialize(vec, 0);
@@ -1549,10 +1543,11 @@ Json::Value LookupServer::TxBlockListing(unsigned int page) {
     for (uint64_t i = offset;
          i < zil::paging::PAGE_SIZE + offset && i <= currBlockNum; i++) {
       tmpJson.clear();
-      tmpJson["Hash"] = m_mediator.m_txBlockChain.GetBlock(currBlockNum - i + 1)
-                            .GetHeader()
-                            .GetPrevHash()
-                            .hex();
+      tmpJson["Hash"] =
+          m_mediator.m_txBlockChain.GetBlockPtr(currBlockNum - i + 1)
+              ->GetHeader()
+              .GetPrevHash()
+              .hex();
       tmpJson["BlockNum"] = uint(currBlockNum - i);
       _json["data"].append(tmpJson);
     }
@@ -1679,12 +1674,12 @@ string LookupServer::GetNumTxnsDSEpoch() {
 
     if (latestTxBlockNum > m_TxBlockCountSumPair.first) {
       // Case where the DS Epoch is same
-      if (m_mediator.m_txBlockChain.GetBlock(m_TxBlockCountSumPair.first)
-              .GetHeader()
+      if (m_mediator.m_txBlockChain.GetBlockPtr(m_TxBlockCountSumPair.first)
+              ->GetHeader()
               .GetDSBlockNum() == latestDSBlockNum) {
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
         }
       }
       // Case if DS Epoch Changed
@@ -1692,13 +1687,13 @@ string LookupServer::GetNumTxnsDSEpoch() {
         m_TxBlockCountSumPair.second = 0;
 
         for (auto i = latestTxBlockNum; i > m_TxBlockCountSumPair.first; i--) {
-          if (m_mediator.m_txBlockChain.GetBlock(i)
-                  .GetHeader()
+          if (m_mediator.m_txBlockChain.GetBlockPtr(i)
+                  ->GetHeader()
                   .GetDSBlockNum() < latestDSBlockNum) {
             break;
           }
           m_TxBlockCountSumPair.second +=
-              m_mediator.m_txBlockChain.GetBlock(i).GetHeader().GetNumTxs();
+              m_mediator.m_txBlockChain.GetBlockPtr(i)->GetHeader().GetNumTxs();
         }
       }
 
@@ -1733,9 +1728,9 @@ Json::Value LookupServer::GetTransactionsForTxBlock(const string& txBlockNum,
     throw JsonRpcException(RPC_INVALID_PARAMETER, e.what());
   }
 
-  auto const& txBlock = m_mediator.m_txBlockChain.GetBlock(txNum);
+  const auto txBlock = m_mediator.m_txBlockChain.GetBlockPtr(txNum);
 
-  return GetTransactionsForTxBlock(txBlock, pageNum);
+  return GetTransactionsForTxBlock(*txBlock, pageNum);
 }
 
 Json::Value LookupServer::GetTxnBodiesForTxBlock(const string& txBlockNum,
@@ -1762,10 +1757,10 @@ Json::Value LookupServer::GetTxnBodiesForTxBlock(const string& txBlockNum,
 
   uint32_t numTransactions = 0;
   try {
-    auto const& txBlock = m_mediator.m_txBlockChain.GetBlock(txNum);
-    numTransactions = txBlock.GetHeader().GetNumTxs();
+    const auto txBlock = m_mediator.m_txBlockChain.GetBlockPtr(txNum);
+    numTransactions = txBlock->GetHeader().GetNumTxs();
 
-    auto const& hashes = GetTransactionsForTxBlock(txBlock, pageNum);
+    auto const& hashes = GetTransactionsForTxBlock(*txBlock, pageNum);
 
     if (pageNumber != "") {
       if (hashes["Transactions"].empty()) {
@@ -2026,10 +2021,10 @@ Json::Value LookupServer::GetMinerInfo(const std::string& blockNum) {
   }
 
   try {
-    const DSBlock& latest = m_mediator.m_dsBlockChain.GetLastBlock();
+    const auto latest = m_mediator.m_dsBlockChain.GetLastBlockPtr();
     const uint64_t requestedDSBlockNum = stoull(blockNum);
 
-    if (latest.GetHeader().GetBlockNum() < requestedDSBlockNum) {
+    if (latest->GetHeader().GetBlockNum() < requestedDSBlockNum) {
       throw JsonRpcException(RPC_MISC_ERROR, "Requested data not found");
     }
 
@@ -2216,8 +2211,8 @@ Json::Value LookupServer::GetStateProof(const string& address,
                   (earliestTrieDSEpoch)*NUM_FINAL_BLOCK_PER_POW));
     }
 
-    rootHash = m_mediator.m_txBlockChain.GetBlock(requestedTxBlockNum)
-                   .GetHeader()
+    rootHash = m_mediator.m_txBlockChain.GetBlockPtr(requestedTxBlockNum)
+                   ->GetHeader()
                    .GetStateRootHash();
   }
 
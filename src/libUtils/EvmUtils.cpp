@@ -50,11 +50,8 @@ std::string Base64Decode(const std::string& in) {
   out.resize(b::decode(out.data(), in.data(), in.size()).first);
   return out;
 }
-}  // namespace
-
-Json::Value EvmUtils::GetEvmCallJson(const evm::EvmArgs& args) {
-  Json::Value arr_ret(Json::arrayValue);
 
+void LogEvmArgs(const evm::EvmArgs& args) {
   if (LOG_SC) {
     LOG_GENERAL(WARNING, "============> Calling the EVM:");
     LOG_GENERAL(WARNING, "Address: " << ProtoToAddress(args.address()));
@@ -69,6 +66,13 @@ Json::Value EvmUtils::GetEvmCallJson(const evm::EvmArgs& args) {
     LOG_GENERAL(WARNING, "Extras: \n" << args.extras().DebugString());
     LOG_GENERAL(WARNING, "Tx trace enabled: " << args.tx_trace_enabled());
   }
+}
+}  // namespace
+
+Json::Value EvmUtils::GetEvmCallJson(const evm::EvmArgs& args) {
+  Json::Value arr_ret(Json::arrayValue);
+
+  LogEvmArgs(args);
 
   std::string output;
   args.SerializeToString(&output);
@@ -77,6 +81,12 @@ Json::Value EvmUtils::GetEvmCallJson(const evm::EvmArgs& args) {
   return arr_ret;
 }
 
+bool EvmUtils::GetEvmCallFrame(const evm::EvmArgs& args, std::string& frame) {
+  LogEvmArgs(args);
+
+  return args.SerializeToString(&frame);
+}
+
 evm::EvmResult& EvmUtils::GetEvmResultFromJson(const Json::Value& json,
                                                evm::EvmResult& result) {
   std::string data = Base64Decode(json.asString());
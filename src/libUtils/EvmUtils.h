@@ -33,6 +33,9 @@ class EvmUtils {
   /// get the command for invoking the evm_runner while calling
   static Json::Value GetEvmCallJson(const evm::EvmArgs& args);
 
+  /// get the raw payload of a framed call to the evm_runner
+  static bool GetEvmCallFrame(const evm::EvmArgs& args, std::string& frame);
+
   static evm::EvmResult& GetEvmResultFromJson(const Json::Value& json,
                                               evm::EvmResult& result);
   static std::string GetEvmResultJsonFromTextProto(
@@ -18,126 +18,263 @@
 #ifndef ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
 #define ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <functional>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <string>
 #include <thread>
-
-/**
- *  Set to 1 to use vector instead of queue for jobs container to improve
- *  memory locality however changes job order from FIFO to LIFO.
- */
-#define CONTIGUOUS_JOBS_MEMORY 0
-#if CONTIGUOUS_JOBS_MEMORY
+#include <type_traits>
+#include <utility>
 #include <vector>
-#else
-#include <queue>
-#endif
+
+#include "libMetrics/Api.h"
+#include "libUtils/Logger.h"
 
 namespace zil {
 namespace local {
 
 class ThreadPoolVariables {
-  int jobs = 0;
+  struct PoolDepth {
+    std::string name;
+    const std::atomic<int64_t>* queued;
+    const std::atomic<int>* jobsLeft;
+  };
 
- public:
-  std::unique_ptr<Z_I64GAUGE> temp;
+  std::mutex m_mutex;
+  std::map<const void*, PoolDepth> m_pools;
 
-  void SetJobs(int job) {
+ public:
+  std::unique_ptr<Z_I64GAUGE> depth;
+  std::unique_ptr<Z_DBLHIST> waitTime;
+  std::unique_ptr<Z_DBLHIST> runTime;
+
+  void Register(const void* pool, const std::string& name,
+                const std::atomic<int64_t>& queued,
+                const std::atomic<int>& jobsLeft) {
+    std::lock_guard<std::mutex> g(m_mutex);
     Init();
-    jobs = job;
+    m_pools[pool] = {name, &queued, &jobsLeft};
   }
 
+  void Unregister(const void* pool) {
+    std::lock_guard<std::mutex> g(m_mutex);
+    m_pools.erase(pool);
+  }
 
   void Init() {
-    if (!temp) {
-      temp = std::make_unique<Z_I64GAUGE>(Z_FL::BLOCKS, "threadpool.gauge",
-                                          "Threadpool", "calls", true);
-
-      temp->SetCallback([this](auto&& result) {
-        result.Set(jobs, {{"counter", "Jobs"}});
+    if (!depth) {
+      depth = std::make_unique<Z_I64GAUGE>(Z_FL::THREAD_POOL,
+                                           "threadpool.gauge", "Threadpool",
+                                           "calls", true);
+
+      depth->SetCallback([this](auto&& result) {
+        std::lock_guard<std::mutex> g(m_mutex);
+        for (const auto& entry : m_pools) {
+          const auto& pool = entry.second;
+          result.Set(pool.queued->load(),
+                     {{"pool", pool.name.c_str()}, {"counter", "Queued"}});
+          result.Set(pool.jobsLeft->load(),
+                     {{"pool", pool.name.c_str()}, {"counter", "Jobs"}});
+        }
       });
+
+      static const std::vector<double> latencyBoundaries{
+          0, 0.1, 0.25, 0.5, 1, 2, 5, 10, 25, 50, 100, 250, 500, 1000};
+      waitTime = std::make_unique<Z_DBLHIST>(
+          Z_FL::THREAD_POOL, "threadpool.wait", latencyBoundaries,
+          "time jobs spend queued", "ms");
+      runTime = std::make_unique<Z_DBLHIST>(Z_FL::THREAD_POOL,
+                                            "threadpool.run", latencyBoundaries,
+                                            "time jobs spend running", "ms");
     }
   }
 };
 
-static ThreadPoolVariables tpool_variables{};
+inline ThreadPoolVariables& GetThreadPoolVariables() {
+  static ThreadPoolVariables tpool_variables{};
+  return tpool_variables;
+}
 
 }  // namespace local
 }  // namespace zil
 
 /**
- * Simple thread pool that creates `threadCount` threads upon its creation, and
- * pulls from a queue to get new jobs. This class requires a number of C++11
- * features be present in your compiler.
+ * Move-only callable holding small functors (such as a lambda capturing a
+ * pointer and a shared_ptr) inline, so that queueing a job does not allocate.
+ * Larger functors are moved to the heap.
+ */
+class PoolJob {
+ public:
+  static constexpr size_t INLINE_SIZE = 64;
+
+  PoolJob() = default;
+
+  template <typename F, typename = std::enable_if_t<
+                            !std::is_same_v<std::decay_t<F>, PoolJob>>>
+  PoolJob(F&& f) {  // NOLINT(google-explicit-constructor)
+    using Fn = std::decay_t<F>;
+    if constexpr (IsInline<Fn>()) {
+      new (&m_storage) Fn(std::forward<F>(f));
+      m_ops = &InlineOps<Fn>::ops;
+    } else {
+      *reinterpret_cast<Fn**>(&m_storage) = new Fn(std::forward<F>(f));
+      m_ops = &HeapOps<Fn>::ops;
+    }
+  }
+
+  PoolJob(PoolJob&& other) noexcept { MoveFrom(other); }
+
+  PoolJob& operator=(PoolJob&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  PoolJob(const PoolJob&) = delete;
+  PoolJob& operator=(const PoolJob&) = delete;
+
+  ~PoolJob() { Reset(); }
+
+  void operator()() { m_ops->invoke(&m_storage); }
+
+  explicit operator bool() const { return m_ops != nullptr; }
+
+ private:
+  struct Ops {
+    void (*invoke)(void*);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void*);
+  };
+
+  template <typename Fn>
+  static constexpr bool IsInline() {
+    return sizeof(Fn) <= INLINE_SIZE &&
+           alignof(Fn) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<Fn>;
+  }
+
+  template <typename Fn>
+  struct InlineOps {
+    static void Invoke(void* s) { (*static_cast<Fn*>(s))(); }
+    static void Move(void* dst, void* src) {
+      new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+      static_cast<Fn*>(src)->~Fn();
+    }
+    static void Destroy(void* s) { static_cast<Fn*>(s)->~Fn(); }
+    static constexpr Ops ops{&Invoke, &Move, &Destroy};
+  };
+
+  template <typename Fn>
+  struct HeapOps {
+    static void Invoke(void* s) { (**static_cast<Fn**>(s))(); }
+    static void Move(void* dst, void* src) {
+      *static_cast<Fn**>(dst) = *static_cast<Fn**>(src);
+    }
+    static void Destroy(void* s) { delete *static_cast<Fn**>(s); }
+    static constexpr Ops ops{&Invoke, &Move, &Destroy};
+  };
+
+  void MoveFrom(PoolJob& other) {
+    if (other.m_ops != nullptr) {
+      other.m_ops->move(&m_storage, &other.m_storage);
+      m_ops = other.m_ops;
+      other.m_ops = nullptr;
+    }
+  }
+
+  void Reset() {
+    if (m_ops != nullptr) {
+      m_ops->destroy(&m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+  const Ops* m_ops{nullptr};
+};
+
+/**
+ * Thread pool that creates `threadCount` threads upon its creation. Every
+ * worker owns a deque of jobs guarded by its own mutex; jobs added from
+ * outside the pool are spread round-robin over the workers, jobs added by a
+ * worker go to its own deque, and idle workers steal from the others. Queue
+ * depth and job wait/run times are reported through libMetrics.
  */
 class ThreadPool {
  public:
-  typedef std::function<void()> Job;
+  typedef PoolJob Job;
 
   /// Constructor.
-#if CONTIGUOUS_JOBS_MEMORY
-  explicit ThreadPool(const unsigned int threadCount,
-                      const std::string& poolName,
-                      const unsigned int jobsReserveCount = 0)
-#else
   explicit ThreadPool(const unsigned int threadCount,
                       const std::string& poolName)
-#endif
-      : _jobsLeft(0),
-        _bailout(false),
-        _poolName(poolName),
-        _jobAvailableVar(),
-        _jobsLeftMutex(),
-        _queueMutex() {
-    _threads.reserve(threadCount);
+      : _poolName(poolName),
+        _metricsAttr{{"pool", _poolName.c_str()}},
+        _metricsEnabled(METRICS_ENABLED(THREAD_POOL)) {
+    _queues.reserve(threadCount);
     for (unsigned int index = 0; index < threadCount; ++index) {
-      _threads.push_back(std::thread([this] { this->Task(); }));
+      _queues.push_back(std::make_unique<WorkerQueue>());
     }
 
-#if CONTIGUOUS_JOBS_MEMORY
-    if (jobsReserveCount > 0) {
-      _queue.reserve(jobsReserveCount);
+    zil::local::GetThreadPoolVariables().Register(this, _poolName, _queued,
+                                                  _jobsLeft);
+
+    _threads.reserve(threadCount);
+    for (unsigned int index = 0; index < threadCount; ++index) {
+      _threads.push_back(std::thread([this, index] { this->Task(index); }));
     }
-#endif
   }
 
   /// Destructor (JoinAll on deconstruction).
-  ~ThreadPool() { JoinAll(); }
+  ~ThreadPool() {
+    JoinAll();
+    zil::local::GetThreadPoolVariables().Unregister(this);
+  }
 
-  /// Adds a new job to the pool. If there are no jobs in the queue, a thread is
-  /// woken up to take the job. If all threads are busy, the job is added to the
-  /// end of the queue.
+  /// Adds a new job to the pool. The job goes to the calling worker's own
+  /// deque if called from within the pool, otherwise to the next worker in
+  /// turn. A sleeping thread, if any, is woken up to take it.
   void AddJob(Job&& job) {
-    std::lock(_queueMutex, _jobsLeftMutex);
-    std::lock_guard<std::mutex> lg1(_queueMutex, std::adopt_lock);
-    std::lock_guard<std::mutex> lg2(_jobsLeftMutex, std::adopt_lock);
-
-#if CONTIGUOUS_JOBS_MEMORY
-    _queue.push_back(std::move(job));
-#else
-    _queue.push(std::move(job));
-#endif
+    if (_queues.empty()) {
+      return;
+    }
+
+    const size_t index = (t_pool == this)
+                             ? t_index
+                             : _nextQueue.fetch_add(1, std::memory_order_relaxed) %
+                                   _queues.size();
+
     ++_jobsLeft;
-    _jobAvailableVar.notify_one();
+    {
+      WorkerQueue& queue = *_queues[index];
+      std::lock_guard<std::mutex> g(queue.mutex);
+      queue.jobs.push_back({std::move(job), Clock::now()});
+    }
+    ++_queued;
 
-    if (0 == _jobsLeft % 100) {
-      LOG_GENERAL(INFO, "PoolName: " << _poolName << " JobLeft: " << _jobsLeft);
+    // Only touch the sleep mutex if someone may be waiting on it
+    if (_sleeping.load() > 0) {
+      std::lock_guard<std::mutex> g(_sleepMutex);
+      _jobAvailableVar.notify_one();
     }
-    zil::local::tpool_variables.SetJobs(_jobsLeft);
   }
 
   /// Joins with all threads. Blocks until all threads have completed. The queue
   /// may be filled after this call, but the threads will be done. After
   /// invoking JoinAll, the pool can no longer be used.
   void JoinAll() {
-    // scoped lock
     {
-      std::lock_guard<std::mutex> lock(_queueMutex);
-      if (_bailout) {
+      std::lock_guard<std::mutex> lock(_sleepMutex);
+      if (_bailout.exchange(true)) {
         return;
       }
-      _bailout = true;
     }
 
     // note that we're done, and wake up any thread that's
@@ -161,71 +298,115 @@ class ThreadPool {
   /// anything else you might want to do
   std::vector<std::thread>& GetThreads() { return _threads; }
 
-  /// Returns the number of jobs in the queue
-  int GetJobsLeft() {
-    std::lock_guard<std::mutex> lock(_jobsLeftMutex);
-    return _jobsLeft;
-  }
+  /// Returns the number of jobs queued or running
+  int GetJobsLeft() { return _jobsLeft.load(); }
 
  private:
-  /**
-   *  Take the next job in the queue and run it.
-   *  Notify the main thread that a job has completed.
-   */
-  void Task() {
-    while (true) {
-      Job job;
-
-      // scoped lock
-      {
-        std::unique_lock<std::mutex> lock(_queueMutex);
-
-        if (_bailout) {
-          return;
-        }
-
-        // Wait for a job if we don't have any.
-        _jobAvailableVar.wait(lock,
-                              [this] { return !_queue.empty() || _bailout; });
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    Job job;
+    Clock::time_point queuedAt;
+  };
+
+  // Padded to a cache line so that workers do not contend on their neighbours
+  struct alignas(64) WorkerQueue {
+    std::mutex mutex;
+    std::deque<Entry> jobs;
+  };
+
+  /// Takes the oldest job of the worker's own deque
+  bool PopLocal(size_t index, Entry& entry) {
+    WorkerQueue& queue = *_queues[index];
+    std::lock_guard<std::mutex> g(queue.mutex);
+    if (queue.jobs.empty()) {
+      return false;
+    }
+    entry = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+    return true;
+  }
 
-        if (_bailout) {
-          return;
-        }
+  /// Takes the newest job of another worker's deque, skipping busy ones
+  bool Steal(size_t index, Entry& entry) {
+    for (size_t i = 1; i < _queues.size(); ++i) {
+      WorkerQueue& queue = *_queues[(index + i) % _queues.size()];
+      std::unique_lock<std::mutex> g(queue.mutex, std::try_to_lock);
+      if (!g.owns_lock() || queue.jobs.empty()) {
+        continue;
+      }
+      entry = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+      return true;
+    }
+    return false;
+  }
 
-        // Get job from the queue
-#if CONTIGUOUS_JOBS_MEMORY
-        job = _queue.back();
-        _queue.pop_back();
-#else
-        job = _queue.front();
-        _queue.pop();
-#endif
+  /**
+   *  Take the next job of this worker, or steal one, and run it.
+   *  Sleep while no job is queued anywhere in the pool.
+   */
+  void Task(size_t index) {
+    t_pool = this;
+    t_index = index;
+
+    while (!_bailout) {
+      Entry entry;
+      if (PopLocal(index, entry) || Steal(index, entry)) {
+        --_queued;
+        Run(entry);
+        continue;
       }
 
-      job();
+      std::unique_lock<std::mutex> lock(_sleepMutex);
+      ++_sleeping;
+      _jobAvailableVar.wait(
+          lock, [this] { return _queued.load() > 0 || _bailout.load(); });
+      --_sleeping;
+    }
+  }
 
-      // scoped lock
-      {
-        std::lock_guard<std::mutex> lock(_jobsLeftMutex);
-        --_jobsLeft;
-      }
+  void Run(Entry& entry) {
+    if (!_metricsEnabled) {
+      entry.job();
+      --_jobsLeft;
+      return;
     }
+
+    const auto startedAt = Clock::now();
+    entry.job();
+    const auto finishedAt = Clock::now();
+    --_jobsLeft;
+
+    auto& variables = zil::local::GetThreadPoolVariables();
+    variables.waitTime->Record(
+        std::chrono::duration<double, std::milli>(startedAt - entry.queuedAt)
+            .count(),
+        _metricsAttr);
+    variables.runTime->Record(
+        std::chrono::duration<double, std::milli>(finishedAt - startedAt)
+            .count(),
+        _metricsAttr);
   }
 
+  static inline thread_local ThreadPool* t_pool = nullptr;
+  static inline thread_local size_t t_index = 0;
+
+  std::vector<std::unique_ptr<WorkerQueue>> _queues;
   std::vector<std::thread> _threads;
-#if CONTIGUOUS_JOBS_MEMORY
-  std::vector<Job> _queue;
-#else
-  std::queue<Job> _queue;
-#endif
-
-  int _jobsLeft;
-  bool _bailout;
+
+  std::atomic<int> _jobsLeft{0};
+  std::atomic<int64_t> _queued{0};
+  std::atomic<int> _sleeping{0};
+  std::atomic<size_t> _nextQueue{0};
+  std::atomic<bool> _bailout{false};
+
   std::string _poolName;
+  const zil::metrics::METRIC_ATTRIBUTE _metricsAttr;
+  const bool _metricsEnabled;
+
   std::condition_variable _jobAvailableVar;
-  std::mutex _jobsLeftMutex;
-  std::mutex _queueMutex;
+  std::mutex _sleepMutex;
 };
 
-#undef CONTIGUOUS_JOBS_MEMORY
 #endif  // ZILLIQA_SRC_LIBUTILS_THREADPOOL_H_
@@ -93,13 +93,13 @@ bool Validator::CheckCreatedTransaction(const Transaction& tx,
 
   receipt.SetEpochNum(m_mediator.m_currentEpochNum);
 
-  const auto txBlock = m_mediator.m_txBlockChain.GetLastBlock();
-  const auto dsBlock = m_mediator.m_dsBlockChain.GetLastBlock();
+  const auto txBlock = m_mediator.m_txBlockChain.GetLastBlockPtr();
+  const auto dsBlock = m_mediator.m_dsBlockChain.GetLastBlockPtr();
 
   TxnExtras txnExtras{
-      dsBlock.GetHeader().GetGasPrice(),
-      txBlock.GetTimestamp() / 1000000,  // From microseconds to seconds.
-      dsBlock.GetHeader().GetDifficulty()};
+      dsBlock->GetHeader().GetGasPrice(),
+      txBlock->GetTimestamp() / 1000000,  // From microseconds to seconds.
+      dsBlock->GetHeader().GetDifficulty()};
 
   return AccountStore::GetInstance().UpdateAccountsTemp(
       m_mediator.m_currentEpochNum, m_mediator.m_node->getNumShards(),
@@ -16,6 +16,10 @@
  */
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 
 #include <boost/asio/signal_set.hpp>
 
@@ -30,6 +34,7 @@
 #include "libMetrics/Api.h"
 #include "libNetwork/Guard.h"
 #include "libNetwork/P2P.h"
+#include "libPersistence/BlockStorage.h"
 #include "libRemoteStorageDB/RemoteStorageDB.h"
 #include "libServer/APIServer.h"
 #include "libServer/DedicatedWebsocketServer.h"
@@ -37,6 +42,7 @@
 #include "libServer/LocalAPIServer.h"
 #include "libUpdater/DaemonListener.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/JsonUtils.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SetThreadName.h"
 #include "libUtils/UpgradeManager.h"
@@ -57,6 +63,97 @@ Z_DBLMETRIC &GetMsgDispatchErrorCounter() {
 }
 #endif
 
+/// Serves eth_getLogs for epochs evicted from the filters API cache out of
+/// the event log DB of the lookup node. Logs are written by a dedicated
+/// thread, as they arrive with the filters cache lock held.
+class BlockStorageEventLogIndex : public evmproj::filters::EventLogIndex {
+ public:
+  BlockStorageEventLogIndex() : m_writer([this] { WriteLoop(); }) {}
+
+  ~BlockStorageEventLogIndex() override {
+    {
+      std::lock_guard<std::mutex> g(m_mutex);
+      m_stop = true;
+    }
+    m_condition.notify_one();
+    m_writer.join();
+  }
+
+  void PutEpochLogs(uint64_t epoch, std::vector<Log> logs) override {
+    {
+      std::lock_guard<std::mutex> g(m_mutex);
+      m_pending.emplace_back(epoch, std::move(logs));
+    }
+    m_condition.notify_one();
+  }
+
+  bool GetLogs(uint64_t from, uint64_t to,
+               const std::vector<std::string> &addresses,
+               const std::vector<std::vector<std::string>> &topics,
+               std::vector<Log> &logs, std::string &error) override {
+    std::vector<EventLogRecord> records;
+    if (!BlockStorage::GetBlockStorage().GetEventLogs(
+            from, to, addresses, topics, EVENT_LOG_INDEX_MAX_RESULTS,
+            records)) {
+      error = "Query returned more than " +
+              std::to_string(EVENT_LOG_INDEX_MAX_RESULTS) + " results";
+      return false;
+    }
+
+    logs.resize(records.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+      logs[i].address = std::move(records[i].address);
+      logs[i].topics = std::move(records[i].topics);
+      logs[i].txnIndex = records[i].txnIndex;
+      logs[i].logIndex = records[i].logIndex;
+      JSONUtils::GetInstance().convertStrtoJson(records[i].response,
+                                                logs[i].response);
+    }
+    return true;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::pair<uint64_t, std::vector<Log>>> m_pending;
+  bool m_stop = false;
+  std::thread m_writer;
+
+  /// Stores queued epochs in order, draining the queue before stopping
+  void WriteLoop() {
+    utility::SetThreadName("EventLogWriter");
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_condition.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+      if (m_pending.empty()) {
+        break;
+      }
+
+      auto [epoch, logs] = std::move(m_pending.front());
+      m_pending.pop_front();
+      lock.unlock();
+      Write(epoch, logs);
+      lock.lock();
+    }
+  }
+
+  static void Write(uint64_t epoch, const std::vector<Log> &logs) {
+    std::vector<EventLogRecord> records(logs.size());
+    for (size_t i = 0; i < logs.size(); ++i) {
+      records[i].address = logs[i].address;
+      records[i].topics = logs[i].topics;
+      records[i].txnIndex = logs[i].txnIndex;
+      records[i].logIndex = logs[i].logIndex;
+      records[i].response =
+          JSONUtils::GetInstance().convertJsontoStr(logs[i].response);
+    }
+    if (!BlockStorage::GetBlockStorage().PutEventLogs(epoch, records)) {
+      LOG_GENERAL(WARNING, "Failed to index event logs of epoch " << epoch);
+    }
+  }
+};
+
 #define MATCH_CASE(CASE) \
   case CASE:             \
     return #CASE;
@@ -140,6 +237,61 @@ void Zilliqa::LogSelfNodeInfo(const PairOfKey &key, const Peer &peer) {
                                      << peer.m_listenPortHost);
 }
 
+Zilliqa::MsgLane Zilliqa::GetMsgLane(const zbytes &msg) {
+  if (msg.size() < MessageOffset::BODY) {
+    return LANE_DEFAULT;
+  }
+
+  const unsigned char ins_byte = msg.at(MessageOffset::INST);
+
+  switch (msg.at(MessageOffset::TYPE)) {
+    case MessageType::CONSENSUSUSER:
+      return LANE_CONSENSUS;
+    case MessageType::DIRECTORY:
+      switch (ins_byte) {
+        case DSInstructionType::SETPRIMARY:
+        case DSInstructionType::DSBLOCKCONSENSUS:
+        case DSInstructionType::FINALBLOCKCONSENSUS:
+        case DSInstructionType::VIEWCHANGECONSENSUS:
+          return LANE_CONSENSUS;
+        case DSInstructionType::MICROBLOCKSUBMISSION:
+        case DSInstructionType::VCPUSHLATESTDSTXBLOCK:
+          return LANE_BLOCK;
+        case DSInstructionType::GETDSLEADERTXNPOOL:
+          return LANE_SYNC;
+        default:
+          return LANE_DEFAULT;
+      }
+    case MessageType::NODE:
+      switch (ins_byte) {
+        case NodeInstructionType::MICROBLOCKCONSENSUS:
+          return LANE_CONSENSUS;
+        case NodeInstructionType::DSBLOCK:
+        case NodeInstructionType::FINALBLOCK:
+        case NodeInstructionType::MBNFORWARDTRANSACTION:
+        case NodeInstructionType::VCBLOCK:
+        case NodeInstructionType::VCFINALBLOCK:
+          return LANE_BLOCK;
+        case NodeInstructionType::SUBMITTRANSACTION:
+        case NodeInstructionType::FORWARDTXNPACKET:
+        case NodeInstructionType::PENDINGTXN:
+          return LANE_TRANSACTION;
+        default:
+          return LANE_DEFAULT;
+      }
+    case MessageType::LOOKUP:
+      switch (ins_byte) {
+        case LookupInstructionType::FORWARDTXN:
+        case LookupInstructionType::SETTXNFROMLOOKUP:
+          return LANE_TRANSACTION;
+        default:
+          return LANE_SYNC;
+      }
+    default:
+      return LANE_DEFAULT;
+  }
+}
+
 void Zilliqa::ProcessMessage(Zilliqa::Msg &message) {
   if (message->msg.size() >= MessageOffset::BODY) {
     const unsigned char msg_type = message->msg.at(MessageOffset::TYPE);
@@ -219,21 +371,18 @@ Zilliqa::Zilliqa(const PairOfKey &key, const Peer &peer,
     : m_mediator(key, peer),
       m_ds(m_mediator),
       m_lookup(m_mediator, syncType, multiplierSyncMode, std::move(extSeedKey)),
-      m_n(m_mediator, syncType, toRetrieveHistory, nodeIdentity),
-      m_msgQueue(MSGQUEUE_SIZE) {
+      m_n(m_mediator, syncType, toRetrieveHistory, nodeIdentity) {
   LOG_MARKER();
 
-  // Launch the thread that reads messages from the queue
-  auto funcCheckMsgQueue = [this]() mutable -> void {
-    Msg message;
-    size_t queueSize;
-    while (m_msgQueue.pop(message, queueSize)) {
-      m_queuePool.AddJob([this, m = std::move(message)]() mutable -> void {
-        ProcessMessage(m);
-      });
-    }
-  };
-  DetachedFunction(1, funcCheckMsgQueue);
+  m_lanes[LANE_CONSENSUS] =
+      make_unique<DispatchLane>("Consensus", CONSENSUS_MSG_THREADS);
+  m_lanes[LANE_BLOCK] = make_unique<DispatchLane>("Block", BLOCK_MSG_THREADS);
+  m_lanes[LANE_TRANSACTION] = make_unique<DispatchLane>(
+      "Transaction", TXN_MSG_THREADS, TXN_MSGQUEUE_SIZE);
+  m_lanes[LANE_SYNC] = make_unique<DispatchLane>("Sync", SYNC_MSG_THREADS,
+                                                 SYNC_MSGQUEUE_SIZE);
+  m_lanes[LANE_DEFAULT] =
+      make_unique<DispatchLane>("Default", MAXRECVMESSAGE, MSGQUEUE_SIZE);
 
   m_validator = make_shared<Validator>(m_mediator);
 
@@ -511,6 +660,11 @@ Zilliqa::Zilliqa(const PairOfKey &key, const Peer &peer,
                 }
                 return Json::Value{};
               });
+
+          if (ENABLE_EVENT_LOG_INDEX) {
+            m_mediator.m_filtersAPICache->SetEventLogIndex(
+                std::make_shared<BlockStorageEventLogIndex>());
+          }
         }
       }
 
@@ -617,20 +771,36 @@ Zilliqa::Zilliqa(const PairOfKey &key, const Peer &peer,
 
   m_msgQueueSize.SetCallback([this](auto &&result) {
     if (m_msgQueueSize.Enabled()) {
-      result.Set(m_msgQueue.size(), {{"counter", "QueueSize"}});
+      for (const auto &lane : m_lanes) {
+        result.Set(lane->m_pool.GetJobsLeft(),
+                   {{"counter", "QueueSize"}, {"lane", lane->m_name}});
+      }
     }
   });
 }
 
 Zilliqa::~Zilliqa() {
-  m_msgQueue.stop();
+  m_stopDispatch = true;
   m_mediator.m_websocketServer->Stop();
 }
 
 void Zilliqa::Dispatch(Zilliqa::Msg message) {
-  // Queue message
-  size_t queueSz{};
-  if (!m_msgQueue.bounded_push(std::move(message), queueSz)) {
-    LOG_GENERAL(WARNING, "Input MsgQueue is full: " << queueSz);
+  if (m_stopDispatch) {
+    return;
   }
+
+  // Queue message on its lane; a full lane only drops its own traffic
+  auto &lane = *m_lanes[GetMsgLane(message->msg)];
+  const size_t pending = lane.m_pool.GetJobsLeft();
+  if (lane.m_maxPending > 0 && pending >= lane.m_maxPending) {
+    LOG_GENERAL(WARNING, "Input MsgQueue for lane " << lane.m_name
+                                                    << " is full: " << pending);
+    return;
+  }
+
+  lane.m_pool.AddJob([this, m = std::move(message)]() mutable -> void {
+    if (!m_stopDispatch) {
+      ProcessMessage(m);
+    }
+  });
 }
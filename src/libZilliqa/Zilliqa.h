@@ -18,6 +18,8 @@
 #ifndef ZILLIQA_SRC_LIBZILLIQA_ZILLIQA_H_
 #define ZILLIQA_SRC_LIBZILLIQA_ZILLIQA_H_
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -31,7 +33,6 @@
 #include "libServer/LookupServer.h"
 #include "libServer/StakingServer.h"
 #include "libServer/StatusServer.h"
-#include "libUtils/Queue.h"
 #include "libUtils/ThreadPool.h"
 
 /// Main Zilliqa class.
@@ -39,7 +40,43 @@ class Zilliqa {
  public:
   using Msg = std::shared_ptr<zil::p2p::Message>;
 
+  /// Dispatch lanes, each with its own queue and worker budget so that
+  /// consensus and block messages never wait behind bulk traffic. Only the
+  /// transaction, sync and default lanes are bounded; consensus and block
+  /// messages come in bursts sized by the committee and are never dropped.
+  enum MsgLane : unsigned int {
+    LANE_CONSENSUS = 0,
+    LANE_BLOCK,
+    LANE_TRANSACTION,
+    LANE_SYNC,
+    LANE_DEFAULT,
+    LANE_COUNT
+  };
+
+  /// Returns the lane a raw message is dispatched on, judged on its type and
+  /// instruction bytes.
+  static MsgLane GetMsgLane(const zbytes& msg);
+
  private:
+  struct DispatchLane {
+    const char* m_name;
+    /// Pending messages past which new ones are dropped, 0 for never
+    const size_t m_maxPending;
+    ThreadPool m_pool;
+
+    /// A lane that never drops, for messages the protocol cannot lose
+    DispatchLane(const char* name, unsigned int threads)
+        : m_name(name),
+          m_maxPending(0),
+          m_pool(threads, std::string("MsgLane_") + name) {}
+
+    /// A lane that sheds its own traffic once queueSize messages wait
+    DispatchLane(const char* name, unsigned int threads, size_t queueSize)
+        : m_name(name),
+          m_maxPending(threads + queueSize),
+          m_pool(threads, std::string("MsgLane_") + name) {}
+  };
+
   Mediator m_mediator;
   DirectoryService m_ds;
   Lookup m_lookup;
@@ -48,7 +85,8 @@ class Zilliqa {
   // ConsensusUser m_cu; // Note: This is just a test class to demo Consensus
   // usage
 
-  utility::Queue<Msg> m_msgQueue;
+  std::array<std::unique_ptr<DispatchLane>, LANE_COUNT> m_lanes;
+  std::atomic<bool> m_stopDispatch{false};
 
   std::shared_ptr<LookupServer> m_lookupServer;
   std::shared_ptr<StakingServer> m_stakingServer;
@@ -60,7 +98,6 @@ class Zilliqa {
   Z_I64GAUGE m_msgQueueSize{zil::metrics::FilterClass::MSG_DISPATCH,
                             "msg.dispatch.queue_size",
                             "Incoming P2P message queue size", "bytes", true};
-  ThreadPool m_queuePool{MAXRECVMESSAGE, "QueuePool"};
 
   void ProcessMessage(Msg& message);
 
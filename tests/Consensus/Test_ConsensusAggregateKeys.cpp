@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#include "common/Messages.h"
+#include "libConsensus/ConsensusLeader.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE consensusaggregatekeystest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const unsigned int COMMITTEE_SIZE = 50;
+
+class TestLeader : public ConsensusLeader {
+ public:
+  using ConsensusLeader::ConsensusLeader;
+  using ConsensusCommon::AggregateKeys;
+};
+
+PubKey AggregatePresent(const DequeOfNode& committee,
+                        const vector<bool>& peerMap) {
+  vector<PubKey> keys;
+  for (unsigned int i = 0; i < peerMap.size(); i++) {
+    if (peerMap.at(i)) {
+      keys.emplace_back(committee.at(i).first);
+    }
+  }
+  return *MultiSig::AggregatePubKeys(keys);
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(consensusaggregatekeystest)
+
+BOOST_AUTO_TEST_CASE(aggregate_keys_match_direct_aggregation) {
+  LOG_MARKER();
+
+  vector<PairOfKey> keys;
+  DequeOfNode committee;
+  for (unsigned int i = 0; i < COMMITTEE_SIZE; i++) {
+    keys.emplace_back(TestUtils::GenerateRandomKeyPair());
+    committee.emplace_back(keys.back().second, TestUtils::GenerateRandomPeer());
+  }
+
+  TestLeader leader(1, 1, zbytes(BLOCK_HASH_SIZE, 1), 0, keys.front().first,
+                    committee, MessageType::DIRECTORY,
+                    DSInstructionType::DSBLOCKCONSENSUS, nullptr, nullptr,
+                    true);
+
+  // Everyone, a few absentees (subtracted from the whole committee's key),
+  // and a minority (aggregated directly)
+  const vector<bool> everyone(COMMITTEE_SIZE, true);
+  vector<bool> fewAbsent(COMMITTEE_SIZE, true);
+  fewAbsent.at(3) = fewAbsent.at(17) = fewAbsent.at(42) = false;
+  vector<bool> minority(COMMITTEE_SIZE, false);
+  minority.at(0) = minority.at(1) = minority.at(25) = true;
+
+  for (const auto& peerMap : {everyone, fewAbsent, minority}) {
+    const PubKey expected = AggregatePresent(committee, peerMap);
+    BOOST_CHECK(leader.AggregateKeys(peerMap) == expected);
+    // Served from the cache the second time
+    BOOST_CHECK(leader.AggregateKeys(peerMap) == expected);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "common/Constants.h"
+#include "common/Messages.h"
+#include "libConsensus/ConsensusLeader.h"
+#include "libMessage/Messenger.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE consensusleaderverifytest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const unsigned int COMMITTEE_SIZE = 600;
+const uint32_t TEST_CONSENSUS_ID = 1;
+const uint64_t TEST_BLOCK_NUMBER = 1;
+const uint16_t LEADER_ID = 0;
+
+// ConsensusCommon::ConsensusMessageType::COMMIT, which is not public
+const uint8_t CONSENSUS_COMMIT = 0x01;
+
+struct Committee {
+  vector<PairOfKey> keys;
+  DequeOfNode nodes;
+
+  Committee() {
+    for (unsigned int i = 0; i < COMMITTEE_SIZE; i++) {
+      keys.emplace_back(TestUtils::GenerateRandomKeyPair());
+      nodes.emplace_back(keys.back().second, TestUtils::GenerateRandomPeer());
+    }
+  }
+};
+
+// A commit from each backup as the DS leader receives it, the consensus
+// message type at MessageOffset::BODY
+vector<zbytes> GenerateCommits(const Committee& committee,
+                               const zbytes& blockHash) {
+  vector<zbytes> commits;
+  for (uint16_t backupID = 0; backupID < COMMITTEE_SIZE; backupID++) {
+    if (backupID == LEADER_ID) {
+      continue;
+    }
+
+    vector<CommitInfo> commitInfo;
+    for (unsigned int i = 0; i < DS_NUM_CONSENSUS_SUBSETS; i++) {
+      CommitInfo ci;
+      ci.commit = CommitPoint(CommitSecret());
+      ci.hash = CommitPointHash(ci.commit);
+      commitInfo.emplace_back(ci);
+    }
+
+    zbytes commit = {MessageType::DIRECTORY,
+                     DSInstructionType::DSBLOCKCONSENSUS, CONSENSUS_COMMIT};
+    BOOST_REQUIRE(Messenger::SetConsensusCommit(
+        commit, MessageOffset::BODY + 1, TEST_CONSENSUS_ID, TEST_BLOCK_NUMBER,
+        blockHash, backupID, commitInfo, committee.keys.at(backupID)));
+    commits.emplace_back(std::move(commit));
+  }
+  return commits;
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(consensusleaderverifytest)
+
+BOOST_AUTO_TEST_CASE(commit_verification_scales_with_threads) {
+  LOG_MARKER();
+
+  const Committee committee;
+  const zbytes blockHash(BLOCK_HASH_SIZE, 1);
+  ConsensusLeader leader(TEST_CONSENSUS_ID, TEST_BLOCK_NUMBER, blockHash,
+                         LEADER_ID, committee.keys.at(LEADER_ID).first,
+                         committee.nodes,
+                         MessageType::DIRECTORY,
+                         DSInstructionType::DSBLOCKCONSENSUS, nullptr, nullptr,
+                         true);
+
+  const auto commits = GenerateCommits(committee, blockHash);
+
+  // Verifies every commit from several threads, as the message dispatch
+  // threads do ahead of the consensus lock
+  atomic<unsigned int> failures{0};
+  TestUtils::BenchmarkThreads(
+      "commit verification from a committee of " +
+          to_string(COMMITTEE_SIZE),
+      commits.size(),
+      [&leader, &committee, &commits, &failures](uint64_t first,
+                                                 uint64_t stride) {
+        for (size_t i = first; i < commits.size(); i += stride) {
+          // Commits skip the leader's own ID
+          const auto& from = committee.nodes.at(i + 1).second;
+          if (!leader.PreVerifyMessage(commits.at(i), MessageOffset::BODY,
+                                       from)) {
+            failures++;
+          }
+        }
+      });
+  BOOST_CHECK_EQUAL(failures, 0);
+
+  // A commit relayed from another backup's address is rejected up front
+  BOOST_CHECK(!leader.PreVerifyMessage(commits.front(), MessageOffset::BODY,
+                                       committee.nodes.at(2).second));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -25,6 +25,7 @@
 #include "libData/AccountData/Address.h"
 #include "libData/AccountStore/AccountStore.h"
 #include "libData/AccountStore/AccountStoreSC.h"
+#include "libPersistence/ContractStorage.h"
 #include "libTestUtils/TestUtils.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SysCommand.h"
@@ -142,4 +143,117 @@ BOOST_AUTO_TEST_CASE(rwtest) {
   LOG_GENERAL(INFO, "acct2: " << acct2->GetBalance());
 }
 
+BOOST_AUTO_TEST_CASE(speculative_transfers_match_serial) {
+  ENABLE_SCILLA = false;
+  AccountStore::GetInstance().Init();
+
+  const uint64_t epoch = 7;
+  const uint64_t gasLimit = NORMAL_TRAN_GAS * 2;
+  const uint128_t gasDeposit = gasLimit * PRECISION_MIN_VALUE;
+
+  // Senders alternate between enough and too little balance, recipients
+  // between existing and new accounts, amounts between zero and non-zero
+  std::vector<Transaction> txns;
+  for (unsigned int i = 0; i < 100; i++) {
+    PairOfKey sender = Schnorr::GenKeyPair();
+    const uint128_t amount = (i % 3 == 0) ? 0 : 10 + i;
+    const uint128_t balance =
+        (i % 5 == 0) ? amount : gasDeposit + amount + 1000;
+    AccountStore::GetInstance().AddAccount(
+        Account::GetAddressFromPublicKey(sender.second), {balance, 0});
+
+    Address toAddr =
+        Account::GetAddressFromPublicKey(Schnorr::GenKeyPair().second);
+    if (i % 2 == 0) {
+      AccountStore::GetInstance().AddAccount(toAddr, {500, 0});
+    }
+
+    txns.emplace_back(DataConversion::Pack(CHAIN_ID, 1), 1, toAddr, sender,
+                      amount, PRECISION_MIN_VALUE, gasLimit);
+  }
+  AccountStore::GetInstance().UpdateStateTrieAll();
+
+  std::vector<std::string> serialReceipts;
+  AccountStore::GetInstance().InitTemp();
+  for (const auto& tx : txns) {
+    TransactionReceipt tr;
+    TxnStatus error_code;
+    tr.SetEpochNum(epoch);
+    if (AccountStore::GetInstance().UpdateAccountsTemp(
+            epoch, 1, false, tx, GetDefaultTxnExtras(), tr, error_code)) {
+      serialReceipts.emplace_back(tr.GetString());
+    } else {
+      serialReceipts.emplace_back();
+    }
+  }
+  BOOST_CHECK(AccountStore::GetInstance().SerializeDelta());
+  zbytes serialDelta;
+  AccountStore::GetInstance().GetSerializedDelta(serialDelta);
+
+  std::vector<SpeculativeTransfer> transfers(txns.begin(), txns.end());
+  AccountStore::GetInstance().InitTemp();
+  AccountStore::GetInstance().SpeculateTransfersTemp(epoch, transfers);
+  unsigned int clean = 0;
+  for (unsigned int i = 0; i < transfers.size(); i++) {
+    if (transfers[i].clean) {
+      clean++;
+      AccountStore::GetInstance().CommitSpeculativeTransferTemp(transfers[i]);
+      BOOST_CHECK_EQUAL(transfers[i].receipt.GetString(), serialReceipts[i]);
+      continue;
+    }
+    TransactionReceipt tr;
+    TxnStatus error_code;
+    AccountStore::GetInstance().UpdateAccountsTemp(
+        epoch, 1, false, txns[i], GetDefaultTxnExtras(), tr, error_code);
+  }
+  BOOST_CHECK_EQUAL(clean, 80);
+  BOOST_CHECK(AccountStore::GetInstance().SerializeDelta());
+  zbytes speculativeDelta;
+  AccountStore::GetInstance().GetSerializedDelta(speculativeDelta);
+
+  BOOST_CHECK(serialDelta == speculativeDelta);
+  AccountStore::GetInstance().InitTemp();
+}
+
+BOOST_AUTO_TEST_CASE(flush_writes_dirty_contract_code) {
+  ENABLE_SCILLA = false;
+  AccountStore::GetInstance().Init();
+
+  const Address contractAddr =
+      Account::GetAddressFromPublicKey(Schnorr::GenKeyPair().second);
+  const zbytes code = DataConversion::StringToCharArray("scilla_version 0");
+  const zbytes initData = DataConversion::StringToCharArray("[]");
+
+  Account contract(0, 0);
+  contract.SetAddress(contractAddr);
+  BOOST_REQUIRE(contract.SetImmutable(code, initData));
+  AccountStore::GetInstance().AddAccount(contractAddr, contract);
+
+  const Address userAddr =
+      Account::GetAddressFromPublicKey(Schnorr::GenKeyPair().second);
+  AccountStore::GetInstance().AddAccount(userAddr, {500, 0});
+  AccountStore::GetInstance().UpdateStateTrieAll();
+
+  BOOST_CHECK(Contract::ContractStorage::GetContractStorage()
+                  .GetContractCode(contractAddr)
+                  .empty());
+  BOOST_CHECK(AccountStore::GetInstance().MoveUpdatesToDisk(1));
+  BOOST_CHECK(Contract::ContractStorage::GetContractStorage().GetContractCode(
+                  contractAddr) == code);
+  BOOST_CHECK(Contract::ContractStorage::GetContractStorage().GetInitData(
+                  contractAddr) == initData);
+
+  // Accounts are read back from the trie and the contract from disk
+  Account* acc = AccountStore::GetInstance().GetAccount(contractAddr);
+  BOOST_REQUIRE(acc != nullptr);
+  BOOST_CHECK(!acc->HasImmutableCache());
+  BOOST_CHECK(acc->GetCode() == code);
+  acc = AccountStore::GetInstance().GetAccount(userAddr);
+  BOOST_REQUIRE(acc != nullptr);
+  BOOST_CHECK_EQUAL(acc->GetBalance(), 500);
+
+  // A second flush has nothing left to write
+  BOOST_CHECK(AccountStore::GetInstance().MoveUpdatesToDisk(2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
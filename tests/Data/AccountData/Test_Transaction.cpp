@@ -23,6 +23,7 @@
 #include "libData/AccountData/Address.h"
 #include "libData/AccountData/MBnForwardedTxnEntry.h"
 #include "libData/AccountData/Transaction.h"
+#include "libMessage/Messenger.h"
 #include "libMetrics/Api.h"
 #include "libTestUtils/TestUtils.h"
 #include "libUtils/DataConversion.h"
@@ -188,6 +189,46 @@ BOOST_AUTO_TEST_CASE(testOperators) {
   BOOST_CHECK_MESSAGE(tx1 < tx3, "Less-than operator failed");
 }
 
+BOOST_AUTO_TEST_CASE(testSignatureVerifiedOnDeserialize) {
+  LOG_MARKER();
+
+  PairOfKey sender = Schnorr::GenKeyPair();
+  const Address toAddr = Address().random();
+
+  // Large enough for the array to be decoded on several threads
+  std::vector<Transaction> txns;
+  for (uint64_t nonce = 1; nonce <= 300; nonce++) {
+    txns.emplace_back(DataConversion::Pack(CHAIN_ID, 1), nonce, toAddr, sender,
+                      55, PRECISION_MIN_VALUE, 22);
+  }
+
+  zbytes message;
+  BOOST_REQUIRE(Messenger::SetTransactionArray(message, 0, txns));
+
+  std::vector<Transaction> decoded;
+  BOOST_REQUIRE(Messenger::GetTransactionArray(message, 0, decoded));
+  BOOST_REQUIRE_EQUAL(decoded.size(), txns.size());
+
+  for (size_t i = 0; i < txns.size(); i++) {
+    BOOST_CHECK(decoded[i] == txns[i]);
+    BOOST_CHECK(decoded[i].IsSignatureVerified());
+    BOOST_CHECK(Transaction::Verify(decoded[i]));
+  }
+
+  // Replacing the signature drops the cached verification
+  Transaction tampered = decoded.front();
+  tampered.SetSignature(TestUtils::GenerateRandomSignature());
+  BOOST_CHECK(!tampered.IsSignatureVerified());
+  BOOST_CHECK(!Transaction::Verify(tampered));
+
+  // A single bad signature rejects the whole array
+  zbytes badMessage;
+  txns[150].SetSignature(TestUtils::GenerateRandomSignature());
+  BOOST_REQUIRE(Messenger::SetTransactionArray(badMessage, 0, txns));
+  decoded.clear();
+  BOOST_CHECK(!Messenger::GetTransactionArray(badMessage, 0, decoded));
+}
+
 // Coverage of MBnForwardedTxnEntry
 BOOST_AUTO_TEST_CASE(coveragembnforwardedtxnentry) {
   LOG_MARKER();
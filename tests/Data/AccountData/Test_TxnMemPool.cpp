@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <vector>
+
+#define BOOST_TEST_MODULE txnmempooltest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "libData/AccountData/TxnMemPool.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+using namespace boost::multiprecision;
+
+Transaction createTransaction(const uint128_t& gasPrice,
+                              const PubKey& senderPubKey,
+                              const uint64_t& nonce) {
+  return Transaction(
+      TestUtils::DistUint32(), nonce, Address().random(), senderPubKey,
+      TestUtils::DistUint128(), gasPrice, TestUtils::DistUint64(),
+      TestUtils::GenerateRandomCharVector(TestUtils::DistUint8()),
+      TestUtils::GenerateRandomCharVector(TestUtils::DistUint8()),
+      TestUtils::GenerateRandomSignature());
+}
+
+BOOST_AUTO_TEST_SUITE(txnmempooltest)
+
+BOOST_AUTO_TEST_CASE(txnmempool_arrival_order) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  TestUtils::Initialize();
+
+  TxnMemPool pool;
+
+  const PubKey sender = TestUtils::GenerateRandomPubKey();
+  std::vector<Transaction> txns;
+  for (uint64_t nonce = 1; nonce <= 100; nonce++) {
+    txns.push_back(createTransaction(100, sender, nonce));
+  }
+
+  MempoolInsertionStatus status;
+  for (const auto& txn : txns) {
+    BOOST_CHECK_EQUAL(true, pool.insert(txn, status));
+    BOOST_CHECK_EQUAL(status.first, TxnStatus::NOT_PRESENT);
+    BOOST_CHECK_EQUAL(true, pool.exist(txn.GetTranID()));
+  }
+  BOOST_CHECK_EQUAL(txns.size(), pool.size());
+
+  // Same hash again
+  BOOST_CHECK_EQUAL(false, pool.insert(txns[42], status));
+  BOOST_CHECK_EQUAL(status.first, TxnStatus::MEMPOOL_ALREADY_PRESENT);
+  BOOST_CHECK_EQUAL(txns.size(), pool.size());
+
+  const auto drained = pool.drain();
+  BOOST_CHECK_EQUAL(true, drained == txns);
+  BOOST_CHECK_EQUAL(true, pool.empty());
+  BOOST_CHECK_EQUAL(false, pool.exist(txns[0].GetTranID()));
+}
+
+BOOST_AUTO_TEST_CASE(txnmempool_same_nonce) {
+  TxnMemPool pool;
+
+  const PubKey sender = TestUtils::GenerateRandomPubKey();
+  const Transaction first = createTransaction(100, sender, 1);
+  const Transaction second = createTransaction(100, sender, 2);
+  const Transaction lowerGas = createTransaction(99, sender, 1);
+  const Transaction higherGas = createTransaction(101, sender, 1);
+
+  MempoolInsertionStatus status;
+  BOOST_CHECK_EQUAL(true, pool.insert(first, status));
+  BOOST_CHECK_EQUAL(true, pool.insert(second, status));
+
+  BOOST_CHECK_EQUAL(false, pool.insert(lowerGas, status));
+  BOOST_CHECK_EQUAL(status.first, TxnStatus::MEMPOOL_SAME_NONCE_LOWER_GAS);
+  BOOST_CHECK_EQUAL(status.second, lowerGas.GetTranID());
+
+  // Replaces the first txn in place
+  BOOST_CHECK_EQUAL(true, pool.insert(higherGas, status));
+  BOOST_CHECK_EQUAL(status.first, TxnStatus::MEMPOOL_SAME_NONCE_LOWER_GAS);
+  BOOST_CHECK_EQUAL(status.second, first.GetTranID());
+  BOOST_CHECK_EQUAL(false, pool.exist(first.GetTranID()));
+  BOOST_CHECK_EQUAL(true, pool.exist(higherGas.GetTranID()));
+  BOOST_CHECK_EQUAL(2, pool.size());
+
+  // A replaced txn may come back once its nonce is free again
+  const auto drained = pool.drain();
+  BOOST_REQUIRE_EQUAL(2, drained.size());
+  BOOST_CHECK_EQUAL(true, drained[0] == higherGas);
+  BOOST_CHECK_EQUAL(true, drained[1] == second);
+  BOOST_CHECK_EQUAL(true, pool.insert(first, status));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <map>
+
+#define BOOST_TEST_MODULE txnreadyqueuetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+#include "libData/AccountData/Account.h"
+#include "libData/AccountData/TxnReadyQueue.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+using namespace boost::multiprecision;
+
+namespace {
+
+Transaction createTransaction(const PubKey& senderPubKey,
+                              const uint64_t& nonce,
+                              const uint128_t& gasPrice) {
+  return Transaction(TestUtils::DistUint32(), nonce, Address().random(),
+                     senderPubKey, TestUtils::DistUint128(), gasPrice,
+                     TestUtils::DistUint64(), {}, {},
+                     TestUtils::GenerateRandomSignature());
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(txnreadyqueuetest)
+
+BOOST_AUTO_TEST_CASE(promote_on_nonce_advance) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const PubKey sender = TestUtils::GenerateRandomPubKey();
+  const Address senderAddr = Account::GetAddressFromPublicKey(sender);
+
+  std::map<Address, uint128_t> nonces{{senderAddr, 0}};
+  auto getExpectedNonce = [&nonces](const Address& addr) -> uint128_t {
+    return nonces[addr] + 1;
+  };
+
+  TxnReadyQueue queue;
+  BOOST_CHECK(queue.insert(createTransaction(sender, 3, 10), 1));
+  BOOST_CHECK(queue.insert(createTransaction(sender, 2, 10), 1));
+  BOOST_CHECK_EQUAL(queue.size(), 2);
+
+  Transaction t;
+  BOOST_CHECK(!queue.findOne(t, getExpectedNonce));
+
+  // Nonce 1 executed elsewhere
+  nonces[senderAddr] = 1;
+  queue.promote(senderAddr, getExpectedNonce(senderAddr));
+  BOOST_CHECK(queue.findOne(t, getExpectedNonce));
+  BOOST_CHECK_EQUAL(t.GetNonce(), 2);
+  BOOST_CHECK(!queue.findOne(t, getExpectedNonce));
+
+  nonces[senderAddr] = 2;
+  queue.promote(senderAddr, getExpectedNonce(senderAddr));
+  BOOST_CHECK(queue.findOne(t, getExpectedNonce));
+  BOOST_CHECK_EQUAL(t.GetNonce(), 3);
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(gas_price_order_and_replacement) {
+  INIT_STDOUT_LOGGER();
+
+  LOG_MARKER();
+
+  const PubKey cheap = TestUtils::GenerateRandomPubKey();
+  const PubKey expensive = TestUtils::GenerateRandomPubKey();
+
+  auto getExpectedNonce = [](const Address&) -> uint128_t { return 1; };
+
+  TxnReadyQueue queue;
+  BOOST_CHECK(queue.insert(createTransaction(cheap, 1, 10), 1));
+  BOOST_CHECK(queue.insert(createTransaction(expensive, 1, 20), 1));
+
+  // Same nonce with lower gas price is rejected, higher one replaces
+  BOOST_CHECK(!queue.insert(createTransaction(cheap, 1, 5), 1));
+  BOOST_CHECK(queue.insert(createTransaction(cheap, 1, 30), 1));
+  BOOST_CHECK_EQUAL(queue.size(), 2);
+  BOOST_CHECK_EQUAL(queue.ReadyIndex.size(), 2);
+
+  Transaction t;
+  BOOST_CHECK(queue.findOne(t, getExpectedNonce));
+  BOOST_CHECK(t.GetSenderPubKey() == cheap);
+  BOOST_CHECK_EQUAL(t.GetGasPriceQa(), 30);
+  BOOST_CHECK(queue.findOne(t, getExpectedNonce));
+  BOOST_CHECK(t.GetSenderPubKey() == expensive);
+  BOOST_CHECK(!queue.findOne(t, getExpectedNonce));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
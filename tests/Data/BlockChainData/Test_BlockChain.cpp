@@ -16,7 +16,9 @@
  */
 
 #include <array>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "libData/BlockChainData/BlockChain.h"
@@ -265,4 +267,56 @@ BOOST_AUTO_TEST_CASE(TxBlockChain_insertByHash) {
   BOOST_ASSERT(nonExistingBlock == EMPTY_BLOCK);
 }
 
+BOOST_AUTO_TEST_CASE(TxBlockChain_sharedBlocks) {
+  LOG_MARKER();
+
+  TxBlockChain txbc;
+  BOOST_CHECK(txbc.GetLastBlockPtr()->GetHeader().GetBlockNum() ==
+              INIT_BLOCK_NUMBER);
+
+  // Added blocks are handed out, not copied
+  const auto txb_0 = make_shared<const TxBlock>(
+      TestUtils::createTxBlockHeader(0), std::vector<MicroBlockInfo>(),
+      CoSignatures());
+  BOOST_CHECK_EQUAL(txbc.AddBlock(txb_0), 1);
+  BOOST_CHECK(txbc.GetBlockPtr(0) == txb_0);
+  BOOST_CHECK(txbc.GetLastBlockPtr() == txb_0);
+  BOOST_CHECK(txbc.GetBlockPtrByHash(txb_0->GetBlockHash()) == txb_0);
+  BOOST_CHECK(&txbc.GetLastBlock() == txb_0.get());
+  BOOST_CHECK(!txbc.MaybeGetBlock(1));
+
+  // Readers see each block whole while the chain grows
+  const uint64_t numBlocks = BLOCKCHAIN_SIZE / 2;
+  atomic<bool> done{false};
+  atomic<unsigned int> failures{0};
+  vector<thread> readers;
+  for (unsigned int t = 0; t < 4; t++) {
+    readers.emplace_back([&]() {
+      while (!done) {
+        const auto last = txbc.GetLastBlockPtr();
+        const auto lastNum = last->GetHeader().GetBlockNum();
+        if (txbc.GetBlockPtr(lastNum)->GetHeader().GetBlockNum() != lastNum) {
+          failures++;
+        }
+      }
+    });
+  }
+  for (uint64_t i = 1; i <= numBlocks; i++) {
+    txbc.AddBlock(make_shared<const TxBlock>(TestUtils::createTxBlockHeader(i),
+                                             std::vector<MicroBlockInfo>(),
+                                             CoSignatures()));
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  BOOST_CHECK_EQUAL(failures, 0);
+  BOOST_CHECK_EQUAL(txbc.GetLastBlock().GetHeader().GetBlockNum(), numBlocks);
+
+  txbc.Reset();
+  BOOST_CHECK(txbc.GetLastBlock().GetHeader().GetBlockNum() ==
+              INIT_BLOCK_NUMBER);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
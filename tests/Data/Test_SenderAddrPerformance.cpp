@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <Schnorr.h>
+#include <chrono>
+#include <vector>
+#include "libData/AccountData/Account.h"
+#include "libData/AccountData/Address.h"
+#include "libData/AccountData/Transaction.h"
+#include "libUtils/DataConversion.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE senderaddrperformance
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace boost::multiprecision;
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE(SenderAddrPerformance)
+
+// Number of times the sender address of a txn is looked up while a block is
+// composed (txn pool insertion, leader loop, validator, receipts)
+constexpr unsigned int LOOKUPS_PER_TXN = 5;
+
+decltype(auto) GenBlockOfTxns(size_t n) {
+  std::vector<Transaction> txns;
+  txns.reserve(n);
+
+  const uint32_t version = DataConversion::Pack(CHAIN_ID, 1);
+  const Address toAddr = Account::GetAddressFromPublicKey(
+      Schnorr::GenKeyPair().second);
+
+  for (unsigned i = 0; i < n; i++) {
+    // One sender per txn, as in a block of independent transfers
+    txns.emplace_back(version, i, toAddr, Schnorr::GenKeyPair(), 123,
+                      PRECISION_MIN_VALUE, 789);
+  }
+
+  return txns;
+}
+
+BOOST_AUTO_TEST_CASE(SenderAddrBlock1000) {
+  INIT_STDOUT_LOGGER();
+  const auto n = 1000u;
+
+  LOG_GENERAL(INFO, "Generating " << n << " txns");
+  const auto txns = GenBlockOfTxns(n);
+
+  // Derive the address from the public key on every lookup
+  Address derivedXor;
+  auto t_start = std::chrono::high_resolution_clock::now();
+  for (unsigned int k = 0; k < LOOKUPS_PER_TXN; k++) {
+    for (const auto& txn : txns) {
+      derivedXor ^= Account::GetAddressFromPublicKey(txn.GetSenderPubKey());
+    }
+  }
+  auto t_end = std::chrono::high_resolution_clock::now();
+  const double derivedMs =
+      std::chrono::duration<double, std::milli>(t_end - t_start).count();
+
+  // Use the address memoized at construction
+  Address cachedXor;
+  t_start = std::chrono::high_resolution_clock::now();
+  for (unsigned int k = 0; k < LOOKUPS_PER_TXN; k++) {
+    for (const auto& txn : txns) {
+      cachedXor ^= txn.GetSenderAddr();
+    }
+  }
+  t_end = std::chrono::high_resolution_clock::now();
+  const double cachedMs =
+      std::chrono::duration<double, std::milli>(t_end - t_start).count();
+
+  BOOST_CHECK_EQUAL(derivedXor, cachedXor);
+
+  LOG_GENERAL(INFO, "Hashes saved per block: " << n * LOOKUPS_PER_TXN);
+  LOG_GENERAL(INFO, "Derived: " << derivedMs << " ms, cached: " << cachedMs
+                                << " ms");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
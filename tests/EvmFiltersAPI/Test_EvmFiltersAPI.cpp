@@ -16,7 +16,10 @@
  */
 
 #include <array>
+#include <limits>
+#include <memory>
 
+#include "libEth/filters/FiltersImpl.h"
 #include "libEth/filters/FiltersUtils.h"
 #include "libUtils/Logger.h"
 
@@ -27,6 +30,74 @@
 using namespace evmproj::filters;
 using namespace std::string_literals;
 
+namespace {
+
+/// Cache holding the logs of epochs [earliest, ...], or nothing
+class TestTxCache : public TxCache {
+ public:
+  EpochNumber earliest = SEEN_NOTHING;
+  Json::Value logs{Json::arrayValue};
+
+  EpochNumber GetEventFilterChanges(EpochNumber after_epoch,
+                                    const EventFilterParams &,
+                                    PollResult &result) override {
+    result.result = logs;
+    result.success = true;
+    return after_epoch;
+  }
+
+  EpochNumber GetBlockFilterChanges(EpochNumber after_epoch,
+                                    PollResult &result) override {
+    result.success = true;
+    return after_epoch;
+  }
+
+  EpochNumber GetEarliestEpoch() override { return earliest; }
+
+  EpochNumber GetPendingTxnsFilterChanges(EpochNumber after_counter,
+                                          PollResult &result) override {
+    result.success = true;
+    return after_counter;
+  }
+};
+
+/// Records the ranges it is queried for
+class TestEventLogIndex : public EventLogIndex {
+ public:
+  std::vector<std::pair<uint64_t, uint64_t>> queries;
+  std::vector<Log> logs;
+  bool fail = false;
+
+  void PutEpochLogs(uint64_t, std::vector<Log>) override {}
+
+  bool GetLogs(uint64_t from, uint64_t to, const std::vector<std::string> &,
+               const std::vector<std::vector<std::string>> &,
+               std::vector<Log> &result, std::string &error) override {
+    queries.emplace_back(from, to);
+    if (fail) {
+      error = "Too many results";
+      return false;
+    }
+    result = logs;
+    return true;
+  }
+};
+
+Json::Value LogsParams(const std::string &from, const std::string &to) {
+  Json::Value params(Json::objectValue);
+  params[FROMBLOCK_STR] = from;
+  params[TOBLOCK_STR] = to;
+  return params;
+}
+
+Json::Value Response(const std::string &id) {
+  Json::Value response(Json::objectValue);
+  response["id"] = id;
+  return response;
+}
+
+}  // namespace
+
 struct Fixture {
   Fixture() { INIT_STDOUT_LOGGER() }
 };
@@ -412,4 +483,82 @@ BOOST_AUTO_TEST_CASE(install_filters_result) {
   inv.back()[ADDRESS_STR] = Json::Value(Json::arrayValue);
 }
 
+BOOST_AUTO_TEST_CASE(get_logs_merges_index_and_cache) {
+  TestTxCache cache;
+  cache.earliest = 100;
+  cache.logs.append(Response("cached"));
+
+  auto index = std::make_shared<TestEventLogIndex>();
+  index->logs.resize(1);
+  index->logs[0].response = Response("indexed");
+
+  FilterAPIBackendImpl api(cache);
+  api.SetEventLogIndex(index);
+  api.SetEpochRange(100, 120);
+
+  // The index only serves the epochs before the cached ones
+  auto res = api.GetLogs(LogsParams("0x10", "0x70"));
+  BOOST_REQUIRE(res.success);
+  BOOST_REQUIRE_EQUAL(index->queries.size(), 1);
+  BOOST_CHECK_EQUAL(index->queries[0].first, 0x10);
+  BOOST_CHECK_EQUAL(index->queries[0].second, 99);
+  BOOST_REQUIRE_EQUAL(res.result.size(), 2);
+  BOOST_CHECK_EQUAL(res.result[0]["id"].asString(), "indexed");
+  BOOST_CHECK_EQUAL(res.result[1]["id"].asString(), "cached");
+
+  res = api.GetLogs(LogsParams("earliest", "0x20"));
+  BOOST_REQUIRE(res.success);
+  BOOST_REQUIRE_EQUAL(index->queries.size(), 2);
+  BOOST_CHECK_EQUAL(index->queries[1].first, 0);
+  BOOST_CHECK_EQUAL(index->queries[1].second, 0x20);
+
+  // Ranges within the cache and "latest" do not touch the index
+  res = api.GetLogs(LogsParams("0x64", "latest"));
+  BOOST_REQUIRE(res.success);
+  res = api.GetLogs(LogsParams("latest", "latest"));
+  BOOST_REQUIRE(res.success);
+  BOOST_CHECK_EQUAL(index->queries.size(), 2);
+  BOOST_REQUIRE_EQUAL(res.result.size(), 1);
+  BOOST_CHECK_EQUAL(res.result[0]["id"].asString(), "cached");
+
+  index->fail = true;
+  res = api.GetLogs(LogsParams("0x10", "0x70"));
+  BOOST_CHECK(!res.success);
+  BOOST_CHECK_EQUAL(res.error, "Too many results");
+}
+
+BOOST_AUTO_TEST_CASE(get_logs_uses_index_with_empty_cache) {
+  TestTxCache cache;
+
+  auto index = std::make_shared<TestEventLogIndex>();
+  index->logs.resize(1);
+  index->logs[0].response = Response("indexed");
+
+  FilterAPIBackendImpl api(cache);
+
+  // Without an index nothing can be answered before the first epoch
+  auto res = api.GetLogs(LogsParams("0x10", "0x70"));
+  BOOST_CHECK(!res.success);
+
+  // After a restart the index serves everything until the cache fills up
+  api.SetEventLogIndex(index);
+  res = api.GetLogs(LogsParams("0x10", "latest"));
+  BOOST_REQUIRE(res.success);
+  BOOST_REQUIRE_EQUAL(index->queries.size(), 1);
+  BOOST_CHECK_EQUAL(index->queries[0].first, 0x10);
+  BOOST_CHECK_EQUAL(index->queries[0].second,
+                    std::numeric_limits<EpochNumber>::max());
+  BOOST_REQUIRE_EQUAL(res.result.size(), 1);
+  BOOST_CHECK_EQUAL(res.result[0]["id"].asString(), "indexed");
+
+  res = api.GetLogs(LogsParams("latest", "latest"));
+  BOOST_CHECK(!res.success);
+
+  api.SetEpochRange(200, 200);
+  res = api.GetLogs(LogsParams("0x10", "0x70"));
+  BOOST_REQUIRE(res.success);
+  BOOST_REQUIRE_EQUAL(index->queries.size(), 2);
+  BOOST_CHECK_EQUAL(index->queries[1].second, 0x70);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <string>
+#include <vector>
+
+#include "libPersistence/BlockStorage.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE eventlogindextest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const string ADDR_A = "0x1111111111111111111111111111111111111111";
+const string ADDR_B = "0x2222222222222222222222222222222222222222";
+const string TOPIC_X = "0xaa";
+const string TOPIC_Y = "0xbb";
+const string TOPIC_Z = "0xcc";
+
+EventLogRecord Record(const string& address, vector<string> topics,
+                      uint32_t txnIndex, uint32_t logIndex) {
+  EventLogRecord record;
+  record.address = address;
+  record.topics = std::move(topics);
+  record.txnIndex = txnIndex;
+  record.logIndex = logIndex;
+  record.response = "{\"logIndex\":" + to_string(logIndex) + "}";
+  return record;
+}
+
+/// Returns "<epoch>:<logIndex>" of each log matching the query, or "error"
+vector<string> Query(uint64_t from, uint64_t to,
+                     const vector<string>& addresses,
+                     const vector<vector<string>>& topics,
+                     size_t maxResults = 100) {
+  vector<EventLogRecord> records;
+  if (!BlockStorage::GetBlockStorage().GetEventLogs(
+          from, to, addresses, topics, maxResults, records)) {
+    return {"error"};
+  }
+  vector<string> result;
+  for (const auto& record : records) {
+    result.emplace_back(to_string(record.txnIndex) + ":" +
+                        to_string(record.logIndex));
+  }
+  return result;
+}
+
+/// Stores, with txnIndex as the epoch:
+///   epoch 5: A [X, Y], B [X]
+///   epoch 6: A [Y]
+///   epoch 9: B [X, Z], A []
+void PutLogs() {
+  auto& storage = BlockStorage::GetBlockStorage();
+  BOOST_REQUIRE(storage.ResetDB(BlockStorage::EVENT_LOG));
+  BOOST_REQUIRE(storage.PutEventLogs(
+      5, {Record(ADDR_A, {TOPIC_X, TOPIC_Y}, 5, 0),
+          Record(ADDR_B, {TOPIC_X}, 5, 1)}));
+  BOOST_REQUIRE(storage.PutEventLogs(6, {Record(ADDR_A, {TOPIC_Y}, 6, 0)}));
+  BOOST_REQUIRE(storage.PutEventLogs(7, {}));
+  BOOST_REQUIRE(storage.PutEventLogs(
+      9, {Record(ADDR_B, {TOPIC_X, TOPIC_Z}, 9, 0), Record(ADDR_A, {}, 9, 1)}));
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(eventlogindextest)
+
+BOOST_AUTO_TEST_CASE(encode_decode) {
+  PutLogs();
+
+  vector<EventLogRecord> records;
+  BOOST_REQUIRE(BlockStorage::GetBlockStorage().GetEventLogs(5, 5, {}, {}, 100,
+                                                             records));
+  BOOST_REQUIRE_EQUAL(records.size(), 2);
+
+  const auto expected = Record(ADDR_A, {TOPIC_X, TOPIC_Y}, 5, 0);
+  BOOST_CHECK_EQUAL(records[0].address, expected.address);
+  BOOST_CHECK(records[0].topics == expected.topics);
+  BOOST_CHECK_EQUAL(records[0].txnIndex, expected.txnIndex);
+  BOOST_CHECK_EQUAL(records[0].logIndex, expected.logIndex);
+  BOOST_CHECK_EQUAL(records[0].response, expected.response);
+  BOOST_CHECK_EQUAL(records[1].address, ADDR_B);
+  BOOST_CHECK_EQUAL(records[1].logIndex, 1);
+}
+
+BOOST_AUTO_TEST_CASE(range_query) {
+  PutLogs();
+
+  using V = vector<string>;
+  BOOST_CHECK(Query(0, 100, {}, {}) == (V{"5:0", "5:1", "6:0", "9:0", "9:1"}));
+  BOOST_CHECK(Query(6, 9, {}, {}) == (V{"6:0", "9:0", "9:1"}));
+  BOOST_CHECK(Query(7, 8, {}, {}).empty());
+  BOOST_CHECK(Query(9, 5, {}, {}).empty());
+
+  // Via the address index, which ignores the case
+  BOOST_CHECK(Query(0, 100, {ADDR_A}, {}) == (V{"5:0", "6:0", "9:1"}));
+  BOOST_CHECK(Query(6, 100, {"0X2222222222222222222222222222222222222222"},
+                    {}) == (V{"9:0"}));
+  BOOST_CHECK(Query(0, 5, {ADDR_A, ADDR_B}, {}) == (V{"5:0", "5:1"}));
+
+  // Via the index of the first constrained topic position, logs without a
+  // topic there match any value
+  BOOST_CHECK(Query(0, 100, {}, {{TOPIC_Y}}) == (V{"6:0", "9:1"}));
+  BOOST_CHECK(Query(0, 100, {}, {{}, {TOPIC_Y, TOPIC_Z}}) ==
+              (V{"5:0", "5:1", "6:0", "9:0", "9:1"}));
+  BOOST_CHECK(Query(0, 100, {}, {{TOPIC_X}, {TOPIC_Z}}) ==
+              (V{"5:1", "9:0", "9:1"}));
+}
+
+BOOST_AUTO_TEST_CASE(bloom_and_exact_match) {
+  PutLogs();
+
+  using V = vector<string>;
+  // Epochs found via the address index are narrowed down by the epoch bloom
+  // and then by the logs themselves
+  BOOST_CHECK(Query(0, 100, {ADDR_A}, {{TOPIC_X}}) == (V{"5:0", "9:1"}));
+  BOOST_CHECK(Query(0, 100, {ADDR_B}, {{TOPIC_Y}}).empty());
+  BOOST_CHECK(
+      Query(0, 100, {"0x3333333333333333333333333333333333333333"}, {})
+          .empty());
+}
+
+BOOST_AUTO_TEST_CASE(max_results) {
+  PutLogs();
+
+  BOOST_CHECK_EQUAL(Query(0, 100, {}, {}, 5).size(), 5);
+  BOOST_CHECK(Query(0, 100, {}, {}, 4) == vector<string>{"error"});
+  BOOST_CHECK_EQUAL(Query(0, 100, {ADDR_B}, {}, 2).size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
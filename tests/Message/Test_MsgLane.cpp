@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <map>
+
+#include "common/Messages.h"
+#include "libUtils/Logger.h"
+#include "libZilliqa/Zilliqa.h"
+
+#define BOOST_TEST_MODULE msglane
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+Zilliqa::MsgLane LaneOf(unsigned char type, unsigned char ins) {
+  return Zilliqa::GetMsgLane({type, ins, 0x00});
+}
+
+// Every instruction of the type up to lastIns lands on defaultLane, unless
+// listed in exceptions
+void CheckLanes(unsigned char type, unsigned char lastIns,
+                Zilliqa::MsgLane defaultLane,
+                const map<unsigned char, Zilliqa::MsgLane>& exceptions) {
+  for (unsigned int ins = 0; ins <= lastIns; ins++) {
+    const auto it = exceptions.find(ins);
+    const auto expected = it == exceptions.end() ? defaultLane : it->second;
+    BOOST_CHECK_MESSAGE(LaneOf(type, ins) == expected,
+                        "type " << int(type) << " ins " << ins << " on lane "
+                                << LaneOf(type, ins) << ", expected "
+                                << expected);
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(msglane)
+
+BOOST_AUTO_TEST_CASE(init) { INIT_STDOUT_LOGGER(); }
+
+BOOST_AUTO_TEST_CASE(test_directory_lanes) {
+  CheckLanes(MessageType::DIRECTORY, DSInstructionType::GETDSLEADERTXNPOOL,
+             Zilliqa::LANE_DEFAULT,
+             {{DSInstructionType::SETPRIMARY, Zilliqa::LANE_CONSENSUS},
+              {DSInstructionType::DSBLOCKCONSENSUS, Zilliqa::LANE_CONSENSUS},
+              {DSInstructionType::FINALBLOCKCONSENSUS, Zilliqa::LANE_CONSENSUS},
+              {DSInstructionType::VIEWCHANGECONSENSUS, Zilliqa::LANE_CONSENSUS},
+              {DSInstructionType::MICROBLOCKSUBMISSION, Zilliqa::LANE_BLOCK},
+              {DSInstructionType::VCPUSHLATESTDSTXBLOCK, Zilliqa::LANE_BLOCK},
+              {DSInstructionType::GETDSLEADERTXNPOOL, Zilliqa::LANE_SYNC}});
+}
+
+BOOST_AUTO_TEST_CASE(test_node_lanes) {
+  CheckLanes(
+      MessageType::NODE, NodeInstructionType::SETVERSION,
+      Zilliqa::LANE_DEFAULT,
+      {{NodeInstructionType::MICROBLOCKCONSENSUS, Zilliqa::LANE_CONSENSUS},
+       {NodeInstructionType::DSBLOCK, Zilliqa::LANE_BLOCK},
+       {NodeInstructionType::FINALBLOCK, Zilliqa::LANE_BLOCK},
+       {NodeInstructionType::MBNFORWARDTRANSACTION, Zilliqa::LANE_BLOCK},
+       {NodeInstructionType::VCBLOCK, Zilliqa::LANE_BLOCK},
+       {NodeInstructionType::VCFINALBLOCK, Zilliqa::LANE_BLOCK},
+       {NodeInstructionType::SUBMITTRANSACTION, Zilliqa::LANE_TRANSACTION},
+       {NodeInstructionType::FORWARDTXNPACKET, Zilliqa::LANE_TRANSACTION},
+       {NodeInstructionType::PENDINGTXN, Zilliqa::LANE_TRANSACTION}});
+}
+
+BOOST_AUTO_TEST_CASE(test_lookup_lanes) {
+  CheckLanes(
+      MessageType::LOOKUP, LookupInstructionType::SETDSLEADERTXNPOOL,
+      Zilliqa::LANE_SYNC,
+      {{LookupInstructionType::FORWARDTXN, Zilliqa::LANE_TRANSACTION},
+       {LookupInstructionType::SETTXNFROMLOOKUP, Zilliqa::LANE_TRANSACTION}});
+}
+
+BOOST_AUTO_TEST_CASE(test_other_lanes) {
+  CheckLanes(MessageType::CONSENSUSUSER, 0xFF, Zilliqa::LANE_CONSENSUS, {});
+  CheckLanes(MessageType::PEER, 0xFF, Zilliqa::LANE_DEFAULT, {});
+  CheckLanes(0xFF, 0xFF, Zilliqa::LANE_DEFAULT, {});
+
+  // Too short to carry an instruction byte
+  BOOST_CHECK_EQUAL(Zilliqa::GetMsgLane({}), Zilliqa::LANE_DEFAULT);
+  BOOST_CHECK_EQUAL(Zilliqa::GetMsgLane({MessageType::DIRECTORY}),
+                    Zilliqa::LANE_DEFAULT);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
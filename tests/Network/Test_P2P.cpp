@@ -209,13 +209,15 @@ int TestSerialize() {
   int num_errors = 0;
 
   auto Test = [&num_errors, &trace_info](const zbytes& msg, const zbytes& hash,
-                                         bool with_traces) {
+                                         bool with_traces,
+                                         bool compress = false) {
     bool ok = false;
     do {
       auto start_byte = hash.empty() ? zil::p2p::START_BYTE_NORMAL
                                      : zil::p2p::START_BYTE_BROADCAST;
 
-      auto raw = zil::p2p::CreateMessage(msg, hash, start_byte, with_traces);
+      auto raw = zil::p2p::CreateMessage(msg, hash, start_byte, with_traces,
+                                         compress);
       if (!raw.data) {
         break;
       }
@@ -234,9 +236,32 @@ int TestSerialize() {
         auto span = zil::trace::Tracing::CreateChildSpanOfRemoteTrace(
             zil::trace::FilterClass::QUEUE, "child", trace_info);
       }
+
+      // Read piecewise as P2PServerConnection does
+      const auto* buf = (const uint8_t*)raw.data.get();
+      zil::p2p::MessageFrame frame;
+      zil::p2p::ReadMessageResult frameResult{nullptr};
+      ok = ok &&
+           zil::p2p::ReadFrameHeader(buf, frame, frameResult) ==
+               zil::p2p::ReadState::SUCCESS &&
+           zil::p2p::ReadFramePrefix(buf + zil::p2p::HDR_LEN, frame,
+                                     frameResult) ==
+               zil::p2p::ReadState::SUCCESS;
+      if (ok) {
+        buf += zil::p2p::HDR_LEN + frame.prefixLength;
+        zbytes message(buf, buf + frame.messageLength);
+        ok = frame.compressed == compress &&
+             (!frame.compressed || zil::p2p::DecompressMessage(message) ==
+                                       zil::p2p::ReadState::SUCCESS) &&
+             frameResult.startByte == start_byte &&
+             frameResult.hash == hash && message == msg &&
+             std::string((const char*)buf + frame.messageLength,
+                         frame.traceLength) == result.traceInfo;
+      }
     } while (false);
     LOG_GENERAL(DEBUG, "size=" << msg.size() << " hash=" << !hash.empty()
-                               << " trace=" << with_traces << " :"
+                               << " trace=" << with_traces
+                               << " compress=" << compress << " :"
                                << (ok ? "OK" : "FAILED"));
     if (!ok) {
       ++num_errors;
@@ -256,6 +281,9 @@ int TestSerialize() {
   Test(long_msg, hash, false);
   Test(long_msg, no_hash, true);
   Test(long_msg, hash, true);
+  Test(short_msg, hash, true, true);
+  Test(long_msg, no_hash, false, true);
+  Test(long_msg, hash, true, true);
 
   if (num_errors > 0) {
     LOG_GENERAL(WARNING,
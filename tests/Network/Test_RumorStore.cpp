@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+
+#include "libNetwork/RumorStore.h"
+
+#define BOOST_TEST_MODULE rumorstore
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+RumorHash MakeHash(uint8_t b) { return RumorHash(zbytes(RumorHash::size, b)); }
+
+RumorStore::Payload MakePayload(size_t size) {
+  return make_shared<const zbytes>(size, 0xAB);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(rumorstore)
+
+BOOST_AUTO_TEST_CASE(test_hash_then_payload) {
+  RumorStore store;
+  store.Reset(2);
+
+  const auto hash = MakeHash(1);
+  BOOST_CHECK(store.Find(hash) == nullptr);
+  BOOST_CHECK(!store.SetPayload(hash, MakePayload(10)));
+
+  // Known by hash first, as from a LAZY_PUSH
+  auto added = store.Add(hash);
+  BOOST_CHECK(added.second);
+  BOOST_CHECK_EQUAL(added.first->id, 1);
+  BOOST_CHECK(!added.first->payload);
+  BOOST_CHECK_EQUAL(store.LastId(), 1);
+  BOOST_CHECK(*store.FindHash(1) == hash);
+
+  auto again = store.Add(hash);
+  BOOST_CHECK(!again.second);
+  BOOST_CHECK_EQUAL(again.first->id, 1);
+
+  // The payload is held, not copied
+  const auto payload = MakePayload(4 * 1024 * 1024);
+  BOOST_CHECK(store.SetPayload(hash, payload));
+  BOOST_CHECK(store.Find(hash)->payload == payload);
+  BOOST_CHECK(!store.SetPayload(hash, MakePayload(10)));
+
+  BOOST_CHECK_EQUAL(store.Add(MakeHash(2)).first->id, 2);
+  BOOST_CHECK_EQUAL(store.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_expiry) {
+  RumorStore store;
+  store.Reset(2);
+
+  const auto withPayload = MakeHash(1);
+  const auto hashOnly = MakeHash(2);
+  store.Add(withPayload);
+  store.Add(hashOnly);
+  store.SetPayload(withPayload, MakePayload(10));
+
+  BOOST_CHECK_EQUAL(store.Expire(), 0);
+  BOOST_CHECK(store.Find(withPayload) != nullptr);
+  BOOST_CHECK_EQUAL(store.Expire(), 1);
+  BOOST_CHECK(store.Find(withPayload) == nullptr);
+  BOOST_CHECK(store.FindHash(1) == nullptr);
+
+  // Only rumors with a payload expire
+  for (int i = 0; i < 5; i++) {
+    BOOST_CHECK_EQUAL(store.Expire(), 0);
+  }
+  BOOST_CHECK(store.Find(hashOnly) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(test_expired_rumor_comes_back) {
+  RumorStore store;
+  store.Reset(3);
+
+  const auto hash = MakeHash(1);
+  store.Add(hash);
+  store.SetPayload(hash, MakePayload(10));
+  store.Expire();
+  store.Expire();
+  BOOST_CHECK_EQUAL(store.Expire(), 1);
+
+  // Back under a new id, and not expired by the old entry's slot
+  BOOST_CHECK_EQUAL(store.Add(hash).first->id, 2);
+  store.SetPayload(hash, MakePayload(10));
+  store.Expire();
+  store.Expire();
+  BOOST_CHECK(store.Find(hash) != nullptr);
+  BOOST_CHECK_EQUAL(store.Expire(), 1);
+
+  store.Reset(3);
+  BOOST_CHECK_EQUAL(store.size(), 0);
+  BOOST_CHECK_EQUAL(store.LastId(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "libPersistence/BlockCache.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE blockcachetest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+using Cache = BlockCache<int>;
+
+namespace {
+
+// Returns count keys that all land in the given shard
+vector<dev::h256> KeysInShard(size_t shard, size_t count) {
+  vector<dev::h256> keys;
+  for (uint64_t i = 1; keys.size() < count; i++) {
+    const dev::h256 key(i);
+    if (Cache::ShardOf(key) == shard) {
+      keys.push_back(key);
+    }
+  }
+  return keys;
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(blockcachetest)
+
+BOOST_AUTO_TEST_CASE(put_get) {
+  Cache cache("test", 64);
+  BOOST_REQUIRE(cache.Enabled());
+
+  const auto keys = KeysInShard(0, 2);
+  cache.Put(keys[0], make_shared<int>(7));
+  // Null values aren't cached
+  cache.Put(keys[1], nullptr);
+
+  const auto value = cache.Get(keys[0]);
+  BOOST_REQUIRE(value);
+  BOOST_CHECK_EQUAL(*value, 7);
+  BOOST_CHECK(!cache.Get(keys[1]));
+
+  // Objects never change for a hash, so a later put keeps the cached one
+  cache.Put(keys[0], make_shared<int>(8));
+  BOOST_CHECK_EQUAL(*cache.Get(keys[0]), 7);
+
+  cache.Clear();
+  BOOST_CHECK(!cache.Get(keys[0]));
+}
+
+BOOST_AUTO_TEST_CASE(evicts_per_shard) {
+  // Two entries per shard
+  Cache cache("test", 2 * Cache::NUM_SHARDS);
+
+  const auto keys = KeysInShard(3, 3);
+  const auto others = KeysInShard(5, 2);
+  for (const auto& key : others) {
+    cache.Put(key, make_shared<int>(0));
+  }
+  cache.Put(keys[0], make_shared<int>(0));
+  cache.Put(keys[1], make_shared<int>(1));
+  // Makes keys[1] the least recently used
+  BOOST_CHECK(cache.Get(keys[0]));
+  cache.Put(keys[2], make_shared<int>(2));
+
+  BOOST_CHECK(cache.Get(keys[0]));
+  BOOST_CHECK(!cache.Get(keys[1]));
+  BOOST_CHECK(cache.Get(keys[2]));
+  // Other shards keep their entries
+  for (const auto& key : others) {
+    BOOST_CHECK(cache.Get(key));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(counts_hits_and_misses) {
+  Cache cache("test", 64);
+  const auto keys = KeysInShard(0, 2);
+  cache.Put(keys[0], make_shared<int>(0));
+
+  cache.Get(keys[0]);
+  cache.Get(keys[0]);
+  cache.Get(keys[1]);
+  BOOST_CHECK_EQUAL(cache.Hits(), 2);
+  BOOST_CHECK_EQUAL(cache.Misses(), 1);
+
+  // A disabled cache doesn't count lookups
+  Cache disabled("disabled", 0);
+  BOOST_CHECK(!disabled.Enabled());
+  disabled.Put(keys[0], make_shared<int>(0));
+  BOOST_CHECK(!disabled.Get(keys[0]));
+  BOOST_CHECK_EQUAL(disabled.Hits(), 0);
+  BOOST_CHECK_EQUAL(disabled.Misses(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "libBlockchain/MicroBlock.h"
+#include "libPersistence/BlockStorage.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE blockstorageconcurrencytest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const uint64_t NUM_BLOCKS = 2000;
+const uint64_t NUM_READS = 200000;
+
+BlockHash HashOf(uint64_t epochNum) { return BlockHash(epochNum + 1); }
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(blockstorageconcurrencytest)
+
+BOOST_AUTO_TEST_CASE(read_throughput_scales_with_threads) {
+  LOG_MARKER();
+
+  auto& storage = BlockStorage::GetBlockStorage();
+  BOOST_REQUIRE(storage.ResetDB(BlockStorage::MICROBLOCK));
+
+  const MicroBlock microBlock(TestUtils::GenerateRandomMicroBlockHeader(),
+                              vector<TxnHash>{}, CoSignatures{});
+  zbytes body;
+  BOOST_REQUIRE(microBlock.Serialize(body, 0));
+  for (uint64_t epochNum = 0; epochNum < NUM_BLOCKS; epochNum++) {
+    BOOST_REQUIRE(storage.PutMicroBlock(HashOf(epochNum), epochNum, 0, body));
+  }
+  storage.FlushBlockWrites();
+
+  // A writer appends up to NUM_BLOCKS more blocks while the readers run
+  atomic<bool> stop{false};
+  thread writer([&storage, &body, &stop]() {
+    for (uint64_t epochNum = NUM_BLOCKS; epochNum < 2 * NUM_BLOCKS && !stop;
+         epochNum++) {
+      storage.PutMicroBlock(HashOf(epochNum), epochNum, 0, body);
+    }
+  });
+
+  // Reads microblocks by (epoch, shard), which bypasses the object cache
+  atomic<uint64_t> failures{0};
+  TestUtils::BenchmarkThreads(
+      "microblock reads", NUM_READS,
+      [&storage, &failures](uint64_t first, uint64_t stride) {
+        for (uint64_t i = first; i < NUM_READS; i += stride) {
+          const uint64_t epochNum = (i * 7919) % NUM_BLOCKS;
+          MicroBlockSharedPtr block;
+          if (!storage.GetMicroBlock(epochNum, 0, block) ||
+              !storage.CheckMicroBlock(HashOf(epochNum))) {
+            failures++;
+          }
+        }
+      });
+
+  stop = true;
+  writer.join();
+  BOOST_CHECK_EQUAL(failures, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
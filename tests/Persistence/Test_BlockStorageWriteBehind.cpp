@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <csignal>
+
+#include <sys/resource.h>
+
+#include "common/Constants.h"
+#include "libBlockchain/MicroBlock.h"
+#include "libPersistence/BlockStorage.h"
+#include "libTestUtils/TestUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE blockstoragewritebehindtest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const uint64_t NUM_BLOCKS = 100;
+
+BlockHash HashOf(uint64_t epochNum) { return BlockHash(epochNum + 1); }
+
+zbytes DeltaOf(uint64_t blockNum, uint8_t version = 0) {
+  return zbytes(32, static_cast<uint8_t>(blockNum + version));
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+// Runs with the constants.xml of the test, which turns write-behind on
+BOOST_AUTO_TEST_SUITE(blockstoragewritebehindtest)
+
+BOOST_AUTO_TEST_CASE(staged_writes_are_visible) {
+  LOG_MARKER();
+
+  BOOST_REQUIRE(BLOCKSTORAGE_WRITE_BEHIND);
+  auto& storage = BlockStorage::GetBlockStorage();
+  BOOST_REQUIRE(storage.ResetDB(BlockStorage::STATE_DELTA));
+  BOOST_REQUIRE(storage.ResetDB(BlockStorage::MICROBLOCK));
+
+  const MicroBlock microBlock(TestUtils::GenerateRandomMicroBlockHeader(),
+                              vector<TxnHash>{}, CoSignatures{});
+  zbytes body;
+  BOOST_REQUIRE(microBlock.Serialize(body, 0));
+  for (uint64_t blockNum = 0; blockNum < NUM_BLOCKS; blockNum++) {
+    BOOST_REQUIRE(storage.PutStateDelta(blockNum, DeltaOf(blockNum)));
+    BOOST_REQUIRE(storage.PutMicroBlock(HashOf(blockNum), blockNum, 0, body));
+  }
+  // Staged again before the first write is committed
+  BOOST_REQUIRE(storage.PutStateDelta(0, DeltaOf(0, 1)));
+
+  // Staged, not yet committed
+  for (uint64_t blockNum = 0; blockNum < NUM_BLOCKS; blockNum++) {
+    zbytes delta;
+    BOOST_REQUIRE(storage.GetStateDelta(blockNum, delta));
+    BOOST_CHECK(delta == DeltaOf(blockNum, blockNum == 0 ? 1 : 0));
+    MicroBlockSharedPtr block;
+    BOOST_CHECK(storage.GetMicroBlock(blockNum, 0, block));
+    BOOST_CHECK(storage.CheckMicroBlock(HashOf(blockNum)));
+  }
+
+  // Committing, then on disk
+  storage.CommitBlockWrites();
+  for (uint64_t blockNum = 0; blockNum < NUM_BLOCKS; blockNum++) {
+    zbytes delta;
+    BOOST_CHECK(storage.GetStateDelta(blockNum, delta));
+  }
+  BOOST_REQUIRE(storage.FlushBlockWrites());
+  for (uint64_t blockNum = 0; blockNum < NUM_BLOCKS; blockNum++) {
+    zbytes delta;
+    BOOST_REQUIRE(storage.GetStateDelta(blockNum, delta));
+    BOOST_CHECK(delta == DeltaOf(blockNum, blockNum == 0 ? 1 : 0));
+    MicroBlockSharedPtr block;
+    BOOST_CHECK(storage.GetMicroBlock(blockNum, 0, block));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(reset_waits_for_staged_writes) {
+  LOG_MARKER();
+
+  auto& storage = BlockStorage::GetBlockStorage();
+  for (uint64_t blockNum = 0; blockNum < NUM_BLOCKS; blockNum++) {
+    BOOST_REQUIRE(storage.PutStateDelta(blockNum, DeltaOf(blockNum)));
+  }
+  storage.CommitBlockWrites();
+
+  // Without the barrier, a commit finishing after the reset would bring the
+  // deltas back
+  BOOST_REQUIRE(storage.ResetDB(BlockStorage::STATE_DELTA));
+  BOOST_REQUIRE(storage.FlushBlockWrites());
+  for (uint64_t blockNum = 0; blockNum < NUM_BLOCKS; blockNum++) {
+    zbytes delta;
+    BOOST_CHECK(!storage.GetStateDelta(blockNum, delta));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(write_failure_is_kept_until_reported) {
+  LOG_MARKER();
+
+  auto& storage = BlockStorage::GetBlockStorage();
+  BOOST_REQUIRE(storage.FlushBlockWrites());
+
+  // Writes to files fail with EFBIG instead of raising SIGXFSZ
+  signal(SIGXFSZ, SIG_IGN);
+  rlimit saved{};
+  BOOST_REQUIRE(getrlimit(RLIMIT_FSIZE, &saved) == 0);
+  rlimit limit = saved;
+  limit.rlim_cur = 0;
+  BOOST_REQUIRE(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+
+  BOOST_REQUIRE(storage.PutStateDelta(0, DeltaOf(0)));
+  const bool flushed = storage.FlushBlockWrites();
+  BOOST_REQUIRE(setrlimit(RLIMIT_FSIZE, &saved) == 0);
+  BOOST_REQUIRE(!flushed);
+
+  // Callers that ignore the barrier's result don't clear the failure
+  BOOST_CHECK(!storage.FlushBlockWrites());
+  storage.DeleteStateDelta(0);
+  BOOST_CHECK(!storage.FlushBlockWrites());
+
+  // Reported once to the write that depends on the blocks
+  BOOST_CHECK(!storage.PutLatestEpochStatesUpdated(1));
+  BOOST_CHECK(storage.FlushBlockWrites());
+  BOOST_CHECK(storage.PutLatestEpochStatesUpdated(1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <string>
+
+#include "common/Constants.h"
+#include "libPersistence/SegmentStore.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE segmentstoretest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+const string SEGMENTS_NAME = "testSegments";
+
+string SegmentDir() {
+  return STORAGE_PATH + PERSISTENCE_PATH + "/" + SEGMENTS_NAME;
+}
+
+zbytes Key(unsigned int i) {
+  const string key = "key" + to_string(i);
+  return zbytes(key.begin(), key.end());
+}
+
+zbytes Value(unsigned int i) {
+  return zbytes(100 + (i % 7) * 1000, static_cast<zbyte>(i));
+}
+
+bool Put(SegmentStore& store, unsigned int i) {
+  const auto value = Value(i);
+  return store.Put(i % 3, Key(i), dev::zbytesConstRef(&value));
+}
+
+bool Matches(SegmentStore& store, unsigned int i) {
+  SegmentStore::View value;
+  return store.Get(i % 3, Key(i), value) && value.value.toBytes() == Value(i);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(segmentstoretest)
+
+BOOST_AUTO_TEST_CASE(init) {
+  INIT_STDOUT_LOGGER();
+  filesystem::remove_all(SegmentDir());
+}
+
+BOOST_AUTO_TEST_CASE(put_get_reopen) {
+  LOG_MARKER();
+
+  const unsigned int count = 10000;
+  {
+    SegmentStore store(SEGMENTS_NAME);
+    for (unsigned int i = 0; i < count; i++) {
+      BOOST_REQUIRE(Put(store, i));
+    }
+    // Values are immutable, a second put keeps the first
+    const zbytes other{1, 2, 3};
+    BOOST_CHECK(store.Put(0, Key(0), dev::zbytesConstRef(&other)));
+    BOOST_CHECK(Matches(store, 0));
+
+    SegmentStore::View value;
+    BOOST_CHECK(!store.Get(0, Key(count), value));
+    BOOST_CHECK(!store.Exists(7, Key(0)));
+    BOOST_CHECK(!filesystem::exists(SegmentDir() + "/7.dat"));
+    BOOST_CHECK(store.Flush());
+  }
+
+  SegmentStore store(SEGMENTS_NAME);
+  for (unsigned int i = 0; i < count; i++) {
+    BOOST_REQUIRE_MESSAGE(Matches(store, i), "Mismatch for key " << i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(recover) {
+  LOG_MARKER();
+
+  const unsigned int count = 1000;
+  {
+    SegmentStore store(SEGMENTS_NAME);
+    BOOST_REQUIRE(store.Reset());
+    for (unsigned int i = 0; i < count; i++) {
+      BOOST_REQUIRE(Put(store, i));
+    }
+  }
+
+  // A lost index is rebuilt from the data file
+  filesystem::remove(SegmentDir() + "/1.idx");
+
+  // A record torn by a crash is dropped
+  const int fd = open((SegmentDir() + "/0.dat").c_str(), O_WRONLY | O_APPEND);
+  BOOST_REQUIRE(fd >= 0);
+  const unsigned char torn[] = {4, 0, 0, 0, 100, 0, 0, 0, 'k', 'e'};
+  BOOST_REQUIRE(write(fd, torn, sizeof(torn)) == sizeof(torn));
+  close(fd);
+
+  {
+    SegmentStore store(SEGMENTS_NAME);
+    for (unsigned int i = 0; i < count; i++) {
+      BOOST_REQUIRE_MESSAGE(Matches(store, i), "Mismatch for key " << i);
+    }
+    BOOST_CHECK(Put(store, count));
+  }
+
+  filesystem::remove(SegmentDir() + "/0.idx");
+  SegmentStore store(SEGMENTS_NAME);
+  BOOST_CHECK(Matches(store, count));
+
+  BOOST_CHECK(store.Reset());
+  BOOST_CHECK(!store.Exists(0, Key(0)));
+}
+
+BOOST_AUTO_TEST_CASE(index_written_back_on_flush) {
+  LOG_MARKER();
+
+  const unsigned int count = 10000;
+  {
+    SegmentStore store(SEGMENTS_NAME);
+    BOOST_REQUIRE(store.Reset());
+    for (unsigned int i = 0; i < count / 2; i++) {
+      BOOST_REQUIRE(Put(store, i));
+    }
+    BOOST_REQUIRE(store.Flush());
+    const auto flushedSize = filesystem::file_size(SegmentDir() + "/0.idx");
+
+    // Grows the index, which only replaces the file on the next flush
+    for (unsigned int i = count / 2; i < count; i++) {
+      BOOST_REQUIRE(Put(store, i));
+    }
+    BOOST_CHECK_EQUAL(filesystem::file_size(SegmentDir() + "/0.idx"),
+                      flushedSize);
+  }
+
+  // Records past the flushed index are indexed again on open
+  {
+    SegmentStore store(SEGMENTS_NAME);
+    for (unsigned int i = 0; i < count; i++) {
+      BOOST_REQUIRE_MESSAGE(Matches(store, i), "Mismatch for key " << i);
+    }
+    BOOST_REQUIRE(store.Flush());
+  }
+
+  // An index pointing past its data is rebuilt
+  const int fd = open((SegmentDir() + "/0.idx").c_str(), O_WRONLY);
+  BOOST_REQUIRE(fd >= 0);
+  const uint64_t bogus[] = {1, uint64_t{1} << 40};
+  BOOST_REQUIRE(pwrite(fd, bogus, sizeof(bogus), 32) == sizeof(bogus));
+  close(fd);
+
+  SegmentStore store(SEGMENTS_NAME);
+  for (unsigned int i = 0; i < count; i++) {
+    BOOST_REQUIRE_MESSAGE(Matches(store, i), "Mismatch for key " << i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(view_outlives_segment) {
+  LOG_MARKER();
+
+  SegmentStore store(SEGMENTS_NAME);
+  BOOST_REQUIRE(store.Reset());
+  BOOST_REQUIRE(Put(store, 0));
+
+  SegmentStore::View value;
+  BOOST_REQUIRE(store.Get(0, Key(0), value));
+  // Drops the segment the value was read from, but not its mapped chunk
+  store.Close();
+  BOOST_CHECK(value.value.toBytes() == Value(0));
+  BOOST_REQUIRE(store.Reset());
+  BOOST_CHECK(value.value.toBytes() == Value(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/Constants.h"
+#include "depends/libTrie/TrieDB.h"
+#include "libData/DataStructures/TraceableDB.h"
+#include "libUtils/DataConversion.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE traceabledbtest
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+/// Exposes the purge internals so that pending purges can be queued without
+/// the lookup-only commit path
+class TestTraceableDB : public TraceableDB {
+ public:
+  using TraceableDB::TraceableDB;
+
+  void Reset() {
+    ResetDB();
+    m_purgeDB.ResetDB();
+  }
+
+  /// Writes count trie nodes and queues them for purge in dsBlockNum
+  vector<dev::h256> AddNodes(uint64_t dsBlockNum, unsigned int first,
+                             unsigned int count) {
+    vector<dev::h256> keys;
+    for (unsigned int i = first; i < first + count; i++) {
+      keys.emplace_back(i);
+      m_levelDB.Insert(leveldb::Slice(keys.back().hex()),
+                       leveldb::Slice("node"));
+    }
+    lock_guard<mutex> g(m_mutexPurge);
+    BOOST_REQUIRE(AddPendingPurge(dsBlockNum, keys));
+    return keys;
+  }
+
+  void Schedule(uint64_t purgeBelow) { SchedulePurge(purgeBelow, false); }
+
+  /// Waits until the purge worker has nothing left to do
+  void WaitIdle() {
+    const auto deadline = chrono::steady_clock::now() + chrono::seconds(60);
+    while (chrono::steady_clock::now() < deadline) {
+      {
+        lock_guard<mutex> g(m_mutexWorker);
+        if (!m_workPending && !m_purgeRunning) {
+          return;
+        }
+      }
+      this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    BOOST_FAIL("Purge did not finish");
+  }
+
+  size_t PendingEntries() {
+    size_t entries = 0;
+    unique_ptr<leveldb::Iterator> iter(
+        m_purgeDB.GetDB()->NewIterator(leveldb::ReadOptions()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      entries++;
+    }
+    return entries;
+  }
+
+  size_t Remaining(const vector<dev::h256>& keys) {
+    size_t remaining = 0;
+    for (const auto& key : keys) {
+      remaining += m_levelDB.Exists(key) ? 1 : 0;
+    }
+    return remaining;
+  }
+};
+
+TraceableDB::PurgeLimits Limits(unsigned int batchSize,
+                                unsigned int maxOpsPerSec) {
+  TraceableDB::PurgeLimits limits;
+  limits.batchSize = batchSize;
+  limits.maxOpsPerSec = maxOpsPerSec;
+  limits.maxBytesPerSec = 0;
+  return limits;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(traceabledbtest)
+
+BOOST_AUTO_TEST_CASE(init) { INIT_STDOUT_LOGGER(); }
+
+BOOST_AUTO_TEST_CASE(chunked_purge) {
+  LOG_MARKER();
+
+  TestTraceableDB db("traceabledb_chunks", Limits(10, 0));
+  db.Reset();
+
+  const auto old = db.AddNodes(1, 0, 25);
+  // A second commit in the same DS epoch appends to its chunks
+  const auto more = db.AddNodes(1, 100, 5);
+  const auto recent = db.AddNodes(5, 200, 10);
+  BOOST_CHECK_EQUAL(db.PendingEntries(), 5);
+
+  // Only the DS epochs below the limit are due
+  db.Schedule(3);
+  db.WaitIdle();
+  BOOST_CHECK_EQUAL(db.Remaining(old), 0);
+  BOOST_CHECK_EQUAL(db.Remaining(more), 0);
+  BOOST_CHECK_EQUAL(db.Remaining(recent), recent.size());
+  BOOST_CHECK_EQUAL(db.PendingEntries(), 1);
+
+  db.Schedule(6);
+  db.WaitIdle();
+  BOOST_CHECK_EQUAL(db.Remaining(recent), 0);
+  BOOST_CHECK_EQUAL(db.PendingEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(oversized_entry_is_split) {
+  LOG_MARKER();
+
+  vector<dev::h256> keys;
+  {
+    TestTraceableDB db("traceabledb_split", Limits(100, 0));
+    db.Reset();
+    keys = db.AddNodes(1, 0, 95);
+    BOOST_CHECK_EQUAL(db.PendingEntries(), 1);
+  }
+
+  // A smaller batch size splits the entry instead of deleting it at once
+  TestTraceableDB db("traceabledb_split", Limits(10, 0));
+  db.Schedule(2);
+  db.WaitIdle();
+  BOOST_CHECK_EQUAL(db.Remaining(keys), 0);
+  BOOST_CHECK_EQUAL(db.PendingEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(resume_after_restart) {
+  LOG_MARKER();
+
+  vector<dev::h256> keys;
+  {
+    // 10 keys every 500ms
+    TestTraceableDB db("traceabledb_resume", Limits(10, 20));
+    db.Reset();
+    keys = db.AddNodes(1, 0, 100);
+    db.Schedule(2);
+    this_thread::sleep_for(chrono::milliseconds(700));
+  }
+
+  // Shutting down mid-purge keeps the chunks still pending
+  TestTraceableDB db("traceabledb_resume", Limits(10, 0));
+  const size_t remaining = db.Remaining(keys);
+  BOOST_CHECK_GT(remaining, 0);
+  BOOST_CHECK_LT(remaining, keys.size());
+  BOOST_CHECK_EQUAL(db.PendingEntries() * 10, remaining);
+
+  db.Schedule(2);
+  db.WaitIdle();
+  BOOST_CHECK_EQUAL(db.Remaining(keys), 0);
+  BOOST_CHECK_EQUAL(db.PendingEntries(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(rate_limit) {
+  LOG_MARKER();
+
+  TestTraceableDB db("traceabledb_rate", Limits(10, 100));
+  db.Reset();
+  const auto keys = db.AddNodes(1, 0, 50);
+
+  // 5 batches of 10 keys at 100 keys/s take at least 500ms
+  const auto start = chrono::steady_clock::now();
+  db.Schedule(2);
+  db.WaitIdle();
+  const auto elapsed = chrono::steady_clock::now() - start;
+
+  BOOST_CHECK_EQUAL(db.Remaining(keys), 0);
+  BOOST_CHECK_GE(
+      chrono::duration_cast<chrono::milliseconds>(elapsed).count(), 450);
+}
+
+BOOST_AUTO_TEST_CASE(stop_signal) {
+  LOG_MARKER();
+
+  TestTraceableDB db("traceabledb_stop", Limits(10, 0));
+  db.Reset();
+  const auto keys = db.AddNodes(1, 0, 30);
+
+  // Later commits must not undo a stop request
+  db.SetStopSignal();
+  db.Schedule(2);
+  db.WaitIdle();
+  BOOST_CHECK_EQUAL(db.Remaining(keys), keys.size());
+
+  // The aborted pass cleared it
+  db.Schedule(2);
+  db.WaitIdle();
+  BOOST_CHECK_EQUAL(db.Remaining(keys), 0);
+}
+
+/*
+  Historical states are only kept with KEEP_HISTORICAL_STATE on a lookup
+*/
+BOOST_AUTO_TEST_CASE(traceabledb) {
+  if (!(KEEP_HISTORICAL_STATE && LOOKUP_NODE_MODE)) {
+    LOG_GENERAL(INFO, "Historical state is not kept, skipping");
+    return;
+  }
+
+  TestTraceableDB db("traceabledb");
+  db.Reset();
+  dev::GenericTrieDB<TraceableDB> m_state(&db);
+  m_state.init();
+  // data writing
+  m_state.insert(DataConversion::StringToCharArray("aaa"),
+                 DataConversion::StringToCharArray("111"));
+  m_state.insert(DataConversion::StringToCharArray("aaa1"),
+                 DataConversion::StringToCharArray("111a"));
+  // commit
+  uint64_t dsBlock = 100;
+  m_state.db()->commit(dsBlock);
+  // data accessing
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa")) == "111",
+      "Unable to fetch state for aaa");
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa1")) == "111a",
+      "Unable to fetch state for aaa1");
+  dev::h256 root1 = m_state.root();
+  // update key
+  m_state.insert(DataConversion::StringToCharArray("aaa"),
+                 DataConversion::StringToCharArray("222"));
+  m_state.insert(DataConversion::StringToCharArray("aaa1"),
+                 DataConversion::StringToCharArray("222a"));
+  m_state.db()->commit(dsBlock++);
+  // data accessing
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa")) == "222",
+      "Unable to fetch state for aaa");
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa1")) == "222a",
+      "Unable to fetch state for aaa1");
+  dev::h256 root2 = m_state.root();
+
+  // check historical state
+  m_state.setRoot(root1);
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa")) == "111",
+      "Unable to fetch state for aaa");
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa1")) == "111a",
+      "Unable to fetch state for aaa1");
+  m_state.setRoot(root2);
+  // commit until expire
+  for (unsigned int i = 0; i <= NUM_DS_EPOCHS_STATE_HISTORY; i++) {
+    m_state.db()->commit(dsBlock++);
+  }
+  db.WaitIdle();
+  // check latest state
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa")) == "222",
+      "Unable to fetch state for aaa");
+  BOOST_CHECK_MESSAGE(
+      m_state.at(DataConversion::StringToCharArray("aaa1")) == "222a",
+      "Unable to fetch state for aaa1");
+  try {
+    m_state.setRoot(root1);
+    BOOST_CHECK(false);
+  } catch (...) {
+    LOG_GENERAL(INFO, "It's normal to fail here")
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
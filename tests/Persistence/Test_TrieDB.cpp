@@ -21,7 +21,6 @@
 #include "depends/common/FixedHash.h"
 #include "depends/common/RLP.h"
 #include "libData/AccountData/Account.h"
-#include "libData/DataStructures/TraceableDB.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/JsonUtils.h"
 
@@ -269,77 +268,4 @@ BOOST_AUTO_TEST_CASE(proof) {
 //       m_trie3.at(DataConversion::StringToCharArray("aaa")));
 // }
 
-/*
-  Only success with following constants.xml settings:
-  1. KEEP_HISTORICAL_STATE -> true
-  2. NUM_DS_EPOCHS_STATE_HISTORY < 100
-*/
-/*
-BOOST_AUTO_TEST_CASE(traceabledb) {
-  TraceableDB db("traceabledb");
-  dev::GenericTrieDB<TraceableDB> m_state(&db);
-  m_state.init();
-  // data writing
-  m_state.insert(DataConversion::StringToCharArray("aaa"),
-                 DataConversion::StringToCharArray("111"));
-  m_state.insert(DataConversion::StringToCharArray("aaa1"),
-                 DataConversion::StringToCharArray("111a"));
-  // commit
-  uint64_t dsBlock = 100;
-  m_state.db()->commit(dsBlock);
-  // data accessing
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa")) == "111",
-      "Unable to fetch state for aaa");
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa1")) == "111a",
-      "Unable to fetch state for aaa1");
-  dev::h256 root1 = m_state.root();
-  // update key
-  m_state.insert(DataConversion::StringToCharArray("aaa"),
-                 DataConversion::StringToCharArray("222"));
-  m_state.insert(DataConversion::StringToCharArray("aaa1"),
-                 DataConversion::StringToCharArray("222a"));
-  m_state.db()->commit(dsBlock++);
-  // data accessing
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa")) == "222",
-      "Unable to fetch state for aaa");
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa1")) == "222a",
-      "Unable to fetch state for aaa1");
-  dev::h256 root2 = m_state.root();
-
-  // check historical state
-  LOG_GENERAL(INFO, "wwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwww");
-  m_state.setRoot(root1);
-  LOG_GENERAL(INFO, "wwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwww");
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa")) == "111",
-      "Unable to fetch state for aaa");
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa1")) == "111a",
-      "Unable to fetch state for aaa1");
-  m_state.setRoot(root2);
-  // commit until expire
-  for (unsigned int i = 0; i < 100; i++) {
-    LOG_GENERAL(INFO, "dsBlock: " << dsBlock);
-    m_state.db()->commit(dsBlock++);
-  }
-  // check latest state
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa")) == "222",
-      "Unable to fetch state for aaa");
-  BOOST_CHECK_MESSAGE(
-      m_state.at(DataConversion::StringToCharArray("aaa1")) == "222a",
-      "Unable to fetch state for aaa1");
-  try {
-    m_state.setRoot(root1);
-    BOOST_CHECK(false);
-  } catch (...) {
-    LOG_GENERAL(INFO, "It's normal to fail here")
-  }
-}
-*/
-
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <jsonrpccpp/server.h>
+
+#include "common/Constants.h"
+#include "libScilla/ScillaClient.h"
+#include "libScilla/UnixDomainSocketServer.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE scillaclient
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+/// Stands in for a scilla-server whose "run" answers are not strings
+class FakeScillaServer : public jsonrpc::AbstractServer<FakeScillaServer> {
+ public:
+  explicit FakeScillaServer(jsonrpc::AbstractServerConnector& conn)
+      : jsonrpc::AbstractServer<FakeScillaServer>(conn,
+                                                  jsonrpc::JSONRPC_SERVER_V2) {
+    bindAndAddMethod(jsonrpc::Procedure("run", jsonrpc::PARAMS_BY_NAME,
+                                        jsonrpc::JSON_OBJECT, NULL),
+                     &FakeScillaServer::Run);
+    bindAndAddMethod(jsonrpc::Procedure("check", jsonrpc::PARAMS_BY_NAME,
+                                        jsonrpc::JSON_STRING, NULL),
+                     &FakeScillaServer::Check);
+  }
+
+  void Run(const Json::Value& /*request*/, Json::Value& response) {
+    response = Json::Value(Json::objectValue);
+    response["message"] = "not a string";
+  }
+
+  void Check(const Json::Value& /*request*/, Json::Value& response) {
+    response = "checked";
+  }
+};
+
+/// Worker pool talking to the fake servers instead of spawned processes
+class TestScillaClient : public ScillaClient {
+ public:
+  using ScillaClient::GetSocketPath;
+
+ protected:
+  bool OpenServer(Worker& /*worker*/) override { return true; }
+  bool IsServerRunning(Worker& /*worker*/) override { return true; }
+};
+
+Json::Value Params() {
+  Json::Value params(Json::objectValue);
+  params["argv"] = Json::Value(Json::arrayValue);
+  return params;
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(scillaclient)
+
+BOOST_AUTO_TEST_CASE(worker_is_released_when_call_throws) {
+  const uint32_t version = 0;
+  const size_t poolSize = std::max(SCILLA_SERVER_POOL_SIZE, 1u);
+
+  std::vector<std::unique_ptr<rpc::UnixDomainSocketServer>> connectors;
+  std::vector<std::unique_ptr<FakeScillaServer>> servers;
+  for (size_t i = 0; i < poolSize; ++i) {
+    const auto path = TestScillaClient::GetSocketPath(version, i);
+    std::filesystem::remove(path);
+    auto connector = std::make_unique<rpc::UnixDomainSocketServer>(path);
+    auto server = std::make_unique<FakeScillaServer>(*connector);
+    BOOST_REQUIRE(server->StartListening());
+    connectors.emplace_back(std::move(connector));
+    servers.emplace_back(std::move(server));
+  }
+
+  auto client = std::make_shared<TestScillaClient>();
+
+  // Every worker of the pool is lent to a call that throws
+  for (size_t i = 0; i <= poolSize; ++i) {
+    std::string result;
+    BOOST_CHECK_THROW(client->CallRunner(version, Params(), result),
+                      Json::Exception);
+  }
+
+  // The pool must still serve calls, without waiting for a free worker
+  auto done = std::make_shared<std::promise<bool>>();
+  auto called = done->get_future();
+  std::thread([client, done, version] {
+    std::string result;
+    done->set_value(client->CallChecker(version, Params(), result) &&
+                    result == "checked");
+  }).detach();
+  BOOST_REQUIRE_MESSAGE(called.wait_for(std::chrono::seconds(30)) ==
+                            std::future_status::ready,
+                        "No worker was handed back to the pool");
+  BOOST_CHECK(called.get());
+
+  for (auto& server : servers) {
+    server->StopListening();
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
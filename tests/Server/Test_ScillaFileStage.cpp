@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "common/Constants.h"
+#include "libScilla/ScillaFileStage.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE scillafilestage
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream is(path, std::ios::binary);
+  std::stringstream ss;
+  ss << is.rdbuf();
+  return ss.str();
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(scillafilestage)
+
+BOOST_AUTO_TEST_CASE(same_content_is_staged_once) {
+  auto& stage = ScillaFileStage::GetInstance();
+
+  std::string first, second, other;
+  BOOST_REQUIRE(stage.StageContent("scilla_version 0", ".scilla", first));
+  BOOST_REQUIRE(stage.StageContent("scilla_version 0", ".scilla", second));
+  BOOST_REQUIRE(stage.StageContent("scilla_version 1", ".scilla", other));
+
+  BOOST_CHECK_EQUAL(first, second);
+  BOOST_CHECK_NE(first, other);
+  BOOST_CHECK(std::filesystem::path(first).is_absolute());
+  BOOST_CHECK_EQUAL(ReadFile(first), "scilla_version 0");
+  BOOST_CHECK_EQUAL(ReadFile(other), "scilla_version 1");
+
+  // A staged file removed behind the stage's back is written again
+  std::filesystem::remove(first);
+  BOOST_REQUIRE(stage.StageContent("scilla_version 0", ".scilla", second));
+  BOOST_CHECK_EQUAL(ReadFile(second), "scilla_version 0");
+}
+
+BOOST_AUTO_TEST_CASE(least_recently_used_files_are_evicted) {
+  auto& stage = ScillaFileStage::GetInstance();
+
+  std::string hot;
+  BOOST_REQUIRE(stage.StageContent("hot", ".json", hot));
+
+  std::string path;
+  for (unsigned int i = 0; i <= SCILLA_STAGING_MAX_FILES; ++i) {
+    BOOST_REQUIRE(stage.StageContent(std::to_string(i), ".json", path));
+    if (i % 16 == 0) {
+      BOOST_REQUIRE(stage.StageContent("hot", ".json", hot));
+    }
+  }
+
+  BOOST_CHECK(std::filesystem::exists(hot));
+  BOOST_CHECK(std::filesystem::exists(path));
+
+  size_t staged = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(
+           std::filesystem::path(path).parent_path())) {
+    std::ignore = entry;
+    ++staged;
+  }
+  BOOST_CHECK_LE(staged, SCILLA_STAGING_MAX_FILES);
+}
+
+BOOST_AUTO_TEST_CASE(stage_at_rewrites_only_changed_content) {
+  auto& stage = ScillaFileStage::GetInstance();
+  const std::string path = stage.GetScratchPath("extlib.scillib");
+
+  BOOST_REQUIRE(stage.StageAt(path, "library A"));
+  const auto written = std::filesystem::last_write_time(path);
+
+  BOOST_REQUIRE(stage.StageAt(path, "library A"));
+  BOOST_CHECK(std::filesystem::last_write_time(path) == written);
+
+  BOOST_REQUIRE(stage.StageAt(path, "library B"));
+  BOOST_CHECK_EQUAL(ReadFile(path), "library B");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
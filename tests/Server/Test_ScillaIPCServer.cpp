@@ -16,8 +16,10 @@
  */
 
 #include <jsonrpccpp/client.h>
+#include <boost/beast/core/detail/base64.hpp>
 #include <thread>
 #include "common/Constants.h"
+#include "depends/common/RLP.h"
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 #include "libPersistence/ScillaMessage.pb.h"
@@ -39,6 +41,28 @@ struct Fixture {
   Fixture() { INIT_STDOUT_LOGGER() }
 };
 
+namespace {
+
+std::string Base64Encode(const zbytes& in) {
+  namespace b = boost::beast::detail::base64;
+
+  std::string out;
+  out.resize(b::encoded_size(in.size()));
+  out.resize(b::encode(out.data(), in.data(), in.size()));
+  return out;
+}
+
+zbytes Base64Decode(const std::string& in) {
+  namespace b = boost::beast::detail::base64;
+
+  zbytes out;
+  out.resize(b::decoded_size(in.size()));
+  out.resize(b::decode(out.data(), in.data(), in.size()).first);
+  return out;
+}
+
+}  // namespace
+
 BOOST_GLOBAL_FIXTURE(Fixture);
 
 BOOST_AUTO_TEST_SUITE(scillaipc)
@@ -892,6 +916,72 @@ BOOST_AUTO_TEST_CASE(test_query_update_fetch_nested) {
   LOG_GENERAL(INFO, "Test ScillaIPCServer test query done!");
 }
 
+// Several keys of a map fetched in one round trip.
+BOOST_AUTO_TEST_CASE(test_query_batch) {
+  rpc::UnixDomainSocketServer s(SCILLA_IPC_SOCKET_PATH);
+  ScillaIPCServer server(nullptr, s);
+  rpc::UnixDomainSocketClient c(SCILLA_IPC_SOCKET_PATH);
+  Client client(c);
+
+  server.StartListening();
+
+  // foo[key1] = "420", foo[key2] = "421"
+  ProtoScillaQuery query;
+  query.set_name("foo_test_query_batch");
+  query.set_mapdepth(1);
+  ProtoScillaVal value;
+  Json::Value params;
+  const std::vector<std::pair<std::string, std::string>> entries{
+      {"key1", "420"}, {"key2", "421"}};
+  for (const auto& [key, val] : entries) {
+    query.clear_indices();
+    query.add_indices(key);
+    value.set_bval(val);
+    params["query"] = query.SerializeAsString();
+    params["value"] = value.SerializeAsString();
+    client.CallMethod("updateStateValue", params);
+  }
+
+  // Prefetching is only a hint and must not change what is fetched.
+  query.clear_indices();
+  params.clear();
+  params["addr"] = "";
+  params["query"] = Base64Encode(toZbytes(query.SerializeAsString()));
+  Json::Value result = client.CallMethod("prefetchStateValues", params);
+  BOOST_CHECK_EQUAL(result[0].asBool(), true);
+
+  // Fetch key1, key3 (absent) and key2 at once.
+  dev::RLPStream rlp(3);
+  for (const auto& key : {"key1", "key3", "key2"}) {
+    query.clear_indices();
+    query.add_indices(key);
+    rlp << toZbytes(query.SerializeAsString());
+  }
+  params.clear();
+  params["queries"] = Base64Encode(rlp.out());
+  result = client.CallMethod("fetchStateValueBatch", params);
+  LOG_GENERAL(INFO, "Test_ScillaIPCServer: Server returned JSON" +
+                        result.toStyledString());
+  BOOST_CHECK_EQUAL(result[0].asBool(), true);
+
+  const zbytes encoded = Base64Decode(result[1].asString());
+  const dev::RLP values(encoded);
+  BOOST_REQUIRE_EQUAL(values.itemCount(), 3);
+
+  BOOST_CHECK_EQUAL(values[0][0].toInt<unsigned>(), 1);
+  value.ParseFromString(values[0][1].toString());
+  BOOST_CHECK_EQUAL(value.bval(), "420");
+
+  BOOST_CHECK_EQUAL(values[1][0].toInt<unsigned>(), 0);
+
+  BOOST_CHECK_EQUAL(values[2][0].toInt<unsigned>(), 1);
+  value.ParseFromString(values[2][1].toString());
+  BOOST_CHECK_EQUAL(value.bval(), "421");
+
+  server.StopListening();
+  LOG_GENERAL(INFO, "Test ScillaIPCServer test query batch done!");
+}
+
 // This test launches a server, invokes `make test_extipcserver`
 // in the Scilla testsuite and checks if it finished successfully.
 BOOST_AUTO_TEST_CASE(test_scillatestsuite) {
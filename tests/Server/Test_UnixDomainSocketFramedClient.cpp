@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2023 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <boost/asio.hpp>
+#include <boost/endian.hpp>
+#include <boost/process.hpp>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include "common/Constants.h"
+#include "libScilla/UnixDomainSocketFramedClient.h"
+#include "libUtils/Evm.pb.h"
+#include "libUtils/EvmUtils.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE framedclient
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using boost::asio::local::stream_protocol;
+
+namespace {
+
+const std::string SOCKET_PATH = "/tmp/zilliqa-test-framed.sock";
+
+/// Serves `connections` connections, answering every frame with the payload
+/// reversed, then exits
+void ServeReversed(stream_protocol::acceptor& acceptor, size_t connections) {
+  for (size_t i = 0; i < connections; ++i) {
+    stream_protocol::socket socket(acceptor.get_executor());
+    acceptor.accept(socket);
+    try {
+      while (true) {
+        uint32_t size = 0;
+        boost::asio::read(socket, boost::asio::buffer(&size, sizeof(size)));
+        std::string payload(boost::endian::big_to_native(size), '\0');
+        boost::asio::read(socket,
+                          boost::asio::buffer(payload.data(), payload.size()));
+        std::reverse(payload.begin(), payload.end());
+        boost::asio::write(socket, boost::asio::buffer(&size, sizeof(size)));
+        boost::asio::write(socket, boost::asio::buffer(payload));
+      }
+    } catch (const std::exception&) {
+      // client closed the connection
+    }
+  }
+}
+
+/// The round trip through evm-ds needs it installed at EVM_SERVER_BINARY
+boost::test_tools::assertion_result EvmDsInstalled(
+    boost::unit_test::test_unit_id) {
+  boost::test_tools::assertion_result ret(
+      std::filesystem::exists(EVM_SERVER_BINARY));
+  ret.message() << EVM_SERVER_BINARY << " is not installed";
+  return ret;
+}
+
+}  // namespace
+
+struct Fixture {
+  Fixture() { INIT_STDOUT_LOGGER() }
+};
+
+BOOST_GLOBAL_FIXTURE(Fixture);
+
+BOOST_AUTO_TEST_SUITE(framedclient)
+
+BOOST_AUTO_TEST_CASE(frames_round_trip_on_one_connection) {
+  std::filesystem::remove(SOCKET_PATH);
+  boost::asio::io_context ioContext;
+  stream_protocol::acceptor acceptor(ioContext,
+                                     stream_protocol::endpoint(SOCKET_PATH));
+  std::thread server([&acceptor] { ServeReversed(acceptor, 1); });
+
+  {
+    rpc::UnixDomainSocketFramedClient client(SOCKET_PATH);
+    std::string response;
+
+    BOOST_REQUIRE(client.Call("abc", response));
+    BOOST_CHECK_EQUAL(response, "cba");
+
+    // Binary payloads are sent untouched
+    const std::string binary("\0\n\xff\x01", 4);
+    BOOST_REQUIRE(client.Call(binary, response));
+    BOOST_CHECK_EQUAL(response, std::string("\x01\xff\n\0", 4));
+
+    BOOST_REQUIRE(client.Call("", response));
+    BOOST_CHECK(response.empty());
+
+    const std::string large(1024 * 1024, 'x');
+    BOOST_REQUIRE(client.Call(large, response));
+    BOOST_CHECK(response == large);
+  }
+
+  server.join();
+  std::filesystem::remove(SOCKET_PATH);
+}
+
+BOOST_AUTO_TEST_CASE(reconnects_after_broken_connection) {
+  std::filesystem::remove(SOCKET_PATH);
+  boost::asio::io_context ioContext;
+  stream_protocol::acceptor acceptor(ioContext,
+                                     stream_protocol::endpoint(SOCKET_PATH));
+  std::thread server([&acceptor] { ServeReversed(acceptor, 2); });
+
+  {
+    rpc::UnixDomainSocketFramedClient client(SOCKET_PATH);
+    std::string response;
+
+    BOOST_REQUIRE(client.Call("first", response));
+    BOOST_CHECK_EQUAL(response, "tsrif");
+
+    client.Close();
+
+    BOOST_REQUIRE(client.Call("second", response));
+    BOOST_CHECK_EQUAL(response, "dnoces");
+  }
+
+  server.join();
+  std::filesystem::remove(SOCKET_PATH);
+}
+
+BOOST_AUTO_TEST_CASE(fails_without_server) {
+  std::filesystem::remove(SOCKET_PATH);
+  rpc::UnixDomainSocketFramedClient client(SOCKET_PATH);
+  std::string response;
+  BOOST_CHECK(!client.Call("abc", response));
+}
+
+BOOST_AUTO_TEST_CASE(round_trip_through_evm_ds,
+                     *boost::unit_test::precondition(EvmDsInstalled)) {
+  const std::string jsonSocketPath = "/tmp/zilliqa-test-evm-ds.sock";
+  std::filesystem::remove(SOCKET_PATH);
+  boost::process::child evmDs(
+      EVM_SERVER_BINARY,
+      boost::process::args({"--socket", jsonSocketPath, "--framed-socket",
+                            SOCKET_PATH, "--http-port", "0"}));
+  for (int i = 0; i < 100 && !std::filesystem::exists(SOCKET_PATH); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  BOOST_REQUIRE(std::filesystem::exists(SOCKET_PATH));
+
+  {
+    rpc::UnixDomainSocketFramedClient client(SOCKET_PATH);
+
+    // evm-ds answers an unknown continuation without calling back into the
+    // node, so no node socket is needed
+    evm::EvmArgs args;
+    args.set_gas_limit(21000);
+    args.mutable_continuation()->set_id(1);
+    std::string request;
+    BOOST_REQUIRE(EvmUtils::GetEvmCallFrame(args, request));
+
+    // Both calls go over the one kept connection
+    for (int i = 0; i < 2; ++i) {
+      std::string response;
+      BOOST_REQUIRE(client.Call(request, response));
+      evm::EvmResult result;
+      BOOST_REQUIRE(result.ParseFromString(response));
+      BOOST_CHECK_EQUAL(result.exit_reason().fatal().error_string(),
+                        "Continuation not found!");
+      BOOST_CHECK_EQUAL(result.remaining_gas(), 21000);
+    }
+
+    // Args that don't parse close the connection, so the call fails
+    std::string response;
+    BOOST_CHECK(!client.Call(std::string(8, '\xff'), response));
+  }
+
+  evmDs.terminate();
+  std::filesystem::remove(SOCKET_PATH);
+  std::filesystem::remove(jsonSocketPath);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2019 Zilliqa
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
+
+#define BOOST_TEST_MODULE threadpool
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace {
+
+void WaitForJobs(ThreadPool& pool) {
+  while (pool.GetJobsLeft() > 0) {
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(threadpool)
+
+BOOST_AUTO_TEST_CASE(runs_all_jobs) {
+  INIT_STDOUT_LOGGER();
+
+  ThreadPool pool(4, "TestPool");
+  atomic<int> count{0};
+
+  for (int i = 0; i < 10000; i++) {
+    pool.AddJob([&count]() { ++count; });
+  }
+
+  WaitForJobs(pool);
+  BOOST_CHECK_EQUAL(count.load(), 10000);
+}
+
+BOOST_AUTO_TEST_CASE(move_only_and_large_jobs) {
+  INIT_STDOUT_LOGGER();
+
+  ThreadPool pool(2, "TestPool");
+  atomic<int> sum{0};
+
+  // Stored inline
+  auto value = make_unique<int>(3);
+  pool.AddJob([&sum, v = std::move(value)]() { sum += *v; });
+
+  // Too large to be stored inline
+  array<int, 64> values{};
+  values.fill(1);
+  pool.AddJob([&sum, values]() {
+    for (int v : values) {
+      sum += v;
+    }
+  });
+
+  WaitForJobs(pool);
+  BOOST_CHECK_EQUAL(sum.load(), 3 + 64);
+}
+
+BOOST_AUTO_TEST_CASE(jobs_added_from_workers_are_stolen) {
+  INIT_STDOUT_LOGGER();
+
+  ThreadPool pool(4, "TestPool");
+  atomic<int> count{0};
+
+  // One worker queues everything on its own deque; the others have to steal
+  pool.AddJob([&pool, &count]() {
+    for (int i = 0; i < 1000; i++) {
+      pool.AddJob([&count]() {
+        this_thread::sleep_for(chrono::microseconds(100));
+        ++count;
+      });
+    }
+  });
+
+  WaitForJobs(pool);
+  BOOST_CHECK_EQUAL(count.load(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(join_all_is_idempotent) {
+  INIT_STDOUT_LOGGER();
+
+  ThreadPool pool(2, "TestPool");
+  atomic<int> count{0};
+  pool.AddJob([&count]() { ++count; });
+  WaitForJobs(pool);
+
+  pool.JoinAll();
+  pool.JoinAll();
+  BOOST_CHECK_EQUAL(count.load(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -124,4 +124,25 @@ BOOST_AUTO_TEST_CASE(iterator_order) {
   delete iter;
 }
 
+BOOST_AUTO_TEST_CASE(profiled_db) {
+  LOG_MARKER();
+
+  // Picks up the txBodies profile, with a bloom filter and the shared cache
+  LevelDB m_testDB("txBodies_test");
+
+  for (unsigned int i = 0; i < 1000; i++) {
+    m_testDB.Insert((uint256_t)i, to_string(i));
+  }
+  m_testDB.compact();
+
+  BOOST_CHECK_MESSAGE(m_testDB.Lookup((uint256_t)7) == "7",
+                      "ERROR: (boost_int, string)");
+  BOOST_CHECK_MESSAGE(m_testDB.Lookup((uint256_t)1000).empty(),
+                      "ERROR: missing key found");
+
+  BOOST_CHECK(m_testDB.RefreshDB());
+  BOOST_CHECK_MESSAGE(m_testDB.Lookup((uint256_t)999) == "999",
+                      "ERROR: lost after refresh");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
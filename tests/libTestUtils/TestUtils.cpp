@@ -16,7 +16,12 @@
  */
 
 #include "TestUtils.h"
+
+#include <chrono>
+#include <thread>
+
 #include "libData/AccountData/Account.h"
+#include "libUtils/Logger.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -271,4 +276,25 @@ Signature GenerateRandomSignature() {
   return GetSignature(GenerateRandomCharVector(Dist1to99()), kp);
 }
 
+void BenchmarkThreads(
+    const std::string& name, uint64_t numItems,
+    const std::function<void(uint64_t first, uint64_t stride)>& work) {
+  const unsigned int maxThreads = max(4u, thread::hardware_concurrency());
+  for (unsigned int numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    vector<thread> workers;
+    const auto start = chrono::steady_clock::now();
+    for (unsigned int t = 0; t < numThreads; t++) {
+      workers.emplace_back([&work, t, numThreads]() { work(t, numThreads); });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    const chrono::duration<double> elapsed =
+        chrono::steady_clock::now() - start;
+    LOG_GENERAL(INFO, "Benchmark: " << name << " with " << numThreads
+                                    << " threads: "
+                                    << numItems / elapsed.count() << "/s");
+  }
+}
+
 }  // namespace TestUtils
@@ -19,6 +19,7 @@
 #define __TESTUTILS_H__
 
 #include <Schnorr.h>
+#include <functional>
 #include <limits>
 #include <random>
 #include <tuple>
@@ -82,6 +83,16 @@ std::vector<bool> GenerateRandomBooleanVector(size_t);
 DequeOfShardMembers GenerateDequeueOfShard(size_t);
 std::string GenerateRandomString(size_t);
 zbytes GenerateRandomCharVector(size_t);
+
+// Benchmarks
+
+/// Splits numItems between 1, 2, 4, ... threads, up to the number of cores
+/// and at least 4, calling work(first, stride) on each thread to process the
+/// items first, first + stride, ... Logs the items per second for each
+/// thread count as a "Benchmark:" line.
+void BenchmarkThreads(
+    const std::string& name, uint64_t numItems,
+    const std::function<void(uint64_t first, uint64_t stride)>& work);
 }  // namespace TestUtils
 
 #endif  // __TESTUTILS_H__